@@ -3,6 +3,7 @@
 
 #include <pbbam/Config.h>
 
+#include <pbcopper/data/GenomicInterval.h>
 #include <pbcopper/data/Position.h>
 
 #include <htslib/hts.h>
@@ -17,6 +18,7 @@ namespace PacBio {
 namespace BAM {
 
 class BamFile;
+class BamHeader;
 class DataSet;
 
 ///
@@ -41,6 +43,14 @@ public:
     hts_itr_t* IteratorForInterval(std::int32_t refId, Data::Position start,
                                    Data::Position stop) const;
 
+    /// \note Same caveats as IteratorForInterval. Returns a multi-region
+    ///       iterator over the non-empty \p intervals, merging overlaps.
+    ///       References are resolved by ID (not parsed from region strings),
+    ///       so names may contain ':'. All names must be in \p header.
+    ///
+    hts_itr_t* IteratorForRegions(const BamHeader& header,
+                                  const std::vector<Data::GenomicInterval>& intervals) const;
+
 private:
     struct BaiIndexCacheDataPrivate;
     std::unique_ptr<BaiIndexCacheDataPrivate> d_;
@@ -12,6 +12,7 @@
 #include <htslib/sam.h>
 
 #include <memory>
+#include <vector>
 
 namespace PacBio {
 namespace BAM {
@@ -94,6 +95,16 @@ public:
     ///
     BaiIndexedBamReader& Interval(const Data::GenomicInterval& interval);
 
+    /// \brief Sets multiple genomic intervals on the reader.
+    ///
+    /// Records overlapping any interval are returned once each, in file order.
+    /// Overlapping index chunks are merged, to reduce seeks.
+    ///
+    /// \param[in] intervals
+    /// \returns reference to this reader
+    ///
+    BaiIndexedBamReader& Intervals(const std::vector<Data::GenomicInterval>& intervals);
+
     /// \}
 
 protected:
@@ -10,11 +10,41 @@
 #include <string>
 #include <vector>
 
+#include <cstddef>
+
 namespace PacBio {
 namespace BAM {
 
 struct BamFileMerger
 {
+    ///
+    /// \brief The Config struct provides a "parameter object" for merging to
+    ///        file. This allows for merger configuration without having to
+    ///        refer to ordering of parameters, default values, etc.
+    ///
+    struct Config
+    {
+        // If true, creates a PBI alongside output BAM
+        bool createPbi = true;
+
+        // Allows client applications to add its @PG entry to merged header
+        ProgramInfo pgInfo;
+
+        // Number of threads used for merging. If greater than 1, and the inputs
+        // are coordinate-sorted with PBI files, the genome is split into
+        // reference-interval shards that are merged concurrently and then
+        // concatenated. Otherwise, this falls back to the single-threaded merge.
+        // If set to 0, the merger will attempt to determine a reasonable estimate.
+        std::size_t numThreads = 1;
+
+        // If true, and the dataset is unfiltered & not coordinate-sorted, input
+        // files are concatenated in the order given (rather than merged by
+        // read name). Compressed BGZF blocks are copied verbatim, and the PBI
+        // is built from the inputs' PBI files. The merged header's sort order
+        // is set to 'unknown'.
+        bool concatenate = false;
+    };
+
     /// \brief Runs merger on BAM files.
     ///
     /// When this function exits, a merged BAM (and optional PBI) will have been
@@ -46,6 +76,21 @@ struct BamFileMerger
     static void Merge(const DataSet& dataset, const std::string& outputFilename,
                       bool createPbi = true, const ProgramInfo& pgInfo = ProgramInfo{});
 
+    /// \brief Runs merger on a dataset (applying any filters), using the
+    ///        provided settings.
+    ///
+    /// When this function exits, a merged BAM (and optional PBI) will have been
+    /// written and closed.
+    ///
+    /// \param[in] dataset          provides input filenames & filters
+    /// \param[in] outputFilename   resulting BAM output
+    /// \param[in] config           merge settings (PBI, @PG entry, threads)
+    ///
+    /// \throws std::runtime_error if any any errors encountered while reading or writing
+    ///
+    static void Merge(const DataSet& dataset, const std::string& outputFilename,
+                      const Config& config);
+
     /// \brief Runs merger on BAM files, writing to provided writer.
     ///
     /// \param[in] bamFilenames     input filenames
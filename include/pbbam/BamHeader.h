@@ -400,6 +400,8 @@ public:
 private:
     class BamHeaderPrivate;
     std::shared_ptr<BamHeaderPrivate> d_;
+
+    friend class BamHeaderMemory;
 };
 
 }  // namespace BAM
@@ -87,6 +87,22 @@ public:
     ///
     bool GetNext(BamRecord& record) override;
 
+    /// \brief Fetches the "next" %BAM record, for unmodified passthrough.
+    ///
+    /// Same as GetNext(), but skips per-record setup that copy-style workflows
+    /// (merging, filtering) do not need. The record's tag offsets are computed
+    /// lazily, on first tag access, and autovalidation (if enabled) is skipped.
+    ///
+    /// \param[out] record  next BamRecord object. Should not be used if method
+    ///                     returns false.
+    ///
+    /// \returns true if record was read successfully, false if end of data
+    ///
+    /// \throws std::runtime_error if failed to read from file (e.g. possible
+    ///         truncated or corrupted file).
+    ///
+    bool GetNextRaw(BamRecord& record);
+
     /// \brief Seeks to virtual offset in %BAM.
     ///
     /// \note This is \b NOT a normal file offset, but the virtual offset used
@@ -138,6 +154,8 @@ protected:
     /// \}
 
 private:
+    bool ReadNext(BamRecord& record);
+
     class BamReaderPrivate;
     std::unique_ptr<BamReaderPrivate> d_;
 };
@@ -185,6 +185,26 @@ public:
     /// \name Mapping Data
     /// \{
 
+    ///
+    /// \brief Alignment summary, computed in a single pass over the CIGAR.
+    ///
+    struct CigarStats
+    {
+        std::size_t numMatches = 0;              ///< sum of '=' op lengths
+        std::size_t numMismatches = 0;           ///< sum of 'X' op lengths
+        std::size_t numInsertedBases = 0;        ///< sum of 'I' op lengths
+        std::size_t numDeletedBases = 0;         ///< sum of 'D' op lengths
+        std::size_t numInsertionOperations = 0;  ///< number of 'I' ops
+        std::size_t numDeletionOperations = 0;   ///< number of 'D' ops
+        std::size_t referenceSpan = 0;           ///< sum of 'M', 'D', 'N', '=', 'X' op lengths
+
+        /// query offsets of the first aligned base & one past the last
+        /// aligned base (in SEQ), after soft clips. -1 if unsupported hard
+        /// clipping is found
+        std::int32_t alignedStartOffset = 0;
+        std::int32_t alignedEndOffset = 0;
+    };
+
     /// \returns the record's aligned end position
     ///
     /// \note AlignedEnd is in polymerase read coordinates, NOT genomic
@@ -202,6 +222,15 @@ public:
     /// \returns the record's strand as a Strand enum value
     Data::Strand AlignedStrand() const;
 
+    /// \returns the record's alignment summary
+    ///
+    /// Computed on first access and cached, until the record is edited (e.g.
+    /// Map(), Clip(), or CIGAR, flag, or tag edits through Impl()).
+    /// NumMatches(), NumInsertedBases(), AlignedStart(), ReferenceEnd(), etc.
+    /// are all read from this summary.
+    ///
+    const CigarStats& CigarStatistics() const;
+
     /// \returns the record's CIGAR data as a Cigar object
     ///
     /// \param[in] exciseAllClips   if true, remove all clipping operations
@@ -911,6 +940,9 @@ public:
     ///
     /// \returns reference to underlying BamRecordImpl object
     ///
+    /// \note Cached alignment data (see CigarStatistics) is recomputed after
+    ///       edits made through the returned reference.
+    ///
     BamRecordImpl& Impl();
 
     /// \}
@@ -1395,7 +1427,8 @@ public:
     /// \name Low-Level Access & Operations
     /// \{
 
-    /// \brief Resets cached aligned start/end.
+    /// \brief Resets cached aligned start/end, CIGAR statistics & pulse-to-base
+    ///        mapping.
     ///
     /// \note This method should not be needed in most client code. It exists
     ///       primarily as a hook for internal reading loops (queries, index
@@ -1404,7 +1437,8 @@ public:
     ///
     void ResetCachedPositions() const;
 
-    /// \brief Resets cached aligned start/end.
+    /// \brief Resets cached aligned start/end, CIGAR statistics & pulse-to-base
+    ///        mapping.
     ///
     /// \note This method should not be needed in most client code. It exists
     ///       primarily as a hook for internal reading loops (queries, index
@@ -1549,6 +1583,12 @@ private:
     /// cached positions (mutable to allow lazy-calc in const methods)
     mutable Data::Position alignedStart_ = Data::UNMAPPED_POSITION;
     mutable Data::Position alignedEnd_ = Data::UNMAPPED_POSITION;
+    mutable CigarStats cigarStats_;
+    mutable bool cigarStatsCached_ = false;
+
+    /// BamRecordImpl edit stamp that the cached data above (& p2bCache_) was
+    /// computed from
+    mutable std::uint64_t cachedEditStamp_ = 0;
 
 private:
     /// \internal
@@ -1626,8 +1666,12 @@ private:
     /// marked const to allow calling from const methods
     /// but updates our mutable cached values
     void CalculateAlignedPositions() const;
+    void CalculateCigarStats() const;
     void CalculatePulse2BaseCache() const;
 
+    /// resets cached data if record was edited since it was computed
+    void ResetStaleCachedData() const;
+
     friend class BamRecordMemory;
 };
 
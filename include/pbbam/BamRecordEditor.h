@@ -0,0 +1,161 @@
+#ifndef PBBAM_BAMRECORDEDITOR_H
+#define PBBAM_BAMRECORDEDITOR_H
+
+#include <pbbam/Config.h>
+
+#include <pbbam/BamRecordTag.h>
+#include <pbbam/Tag.h>
+
+#include <pbcopper/data/Cigar.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace PacBio {
+namespace BAM {
+
+class BamRecord;
+class BamRecordImpl;
+
+///
+/// \brief The BamRecordEditor class batches changes to a record's
+///        variable-length data: name, CIGAR, sequence & qualities, and tags.
+///
+/// Each BamRecordImpl setter resizes the record's data block, moving all data
+/// that follows the edited field. An editor instead collects changes, and then
+/// writes the final data block in a single pass, with a single allocation, on
+/// Commit(). This is helpful when making many changes per record, e.g. when
+/// copying tags from another record or building new records from scratch.
+///
+/// \code{.cpp}
+///
+/// BamRecordEditor{record}
+///     .Name("movie/42/ccs")
+///     .SequenceAndQualities("ACGT", "IIII")
+///     .SetTag("np", std::int32_t{10})
+///     .SetTag(BamRecordTag::HOLE_NUMBER, std::int32_t{42})
+///     .RemoveTag("XX")
+///     .Commit();
+///
+/// \endcode
+///
+/// Changes are not visible on the record until Commit(), and are discarded if
+/// the editor is destroyed first. Core fields (flag, position, etc.) are not
+/// buffered, and should be set directly on the record.
+///
+class PBBAM_EXPORT BamRecordEditor
+{
+public:
+    /// \name Constructors & Related Methods
+    /// \{
+
+    explicit BamRecordEditor(BamRecordImpl& record);
+
+    /// \note The record's cached data (aligned positions, etc.) is reset on
+    ///       Commit().
+    explicit BamRecordEditor(BamRecord& record);
+
+    BamRecordEditor(const BamRecordEditor&) = delete;
+    BamRecordEditor(BamRecordEditor&&) noexcept = default;
+    BamRecordEditor& operator=(const BamRecordEditor&) = delete;
+    BamRecordEditor& operator=(BamRecordEditor&&) noexcept = default;
+    ~BamRecordEditor();
+
+    /// \}
+
+public:
+    /// \name Record Data
+    /// \{
+
+    /// \brief Sets the record's name.
+    BamRecordEditor& Name(std::string name);
+
+    /// \brief Sets the record's CIGAR data.
+    ///
+    /// As with BamRecordImpl::CigarData, this also removes any 'CG' tag.
+    ///
+    BamRecordEditor& CigarData(Data::Cigar cigar);
+
+    /// \brief Sets the record's DNA sequence and quality values.
+    ///
+    /// \param[in] sequence     DNA sequence
+    /// \param[in] qualities    ASCII quality values, may be empty
+    ///
+    /// \throws std::runtime_error if \p qualities is not empty and its length
+    ///         does not match \p sequence
+    ///
+    BamRecordEditor& SequenceAndQualities(std::string sequence, std::string qualities = {});
+
+    /// \}
+
+public:
+    /// \name Tags
+    /// \{
+
+    /// \brief Adds a tag, or replaces its value if already present.
+    ///
+    /// Existing tags keep their position, new tags are appended in the order
+    /// they are first set.
+    ///
+    /// \throws std::runtime_error if \p tagName is not 2 characters, or if
+    ///         \p value could not be encoded
+    ///
+    BamRecordEditor& SetTag(const std::string& tagName, const Tag& value,
+                            TagModifier additionalModifier = TagModifier::NONE);
+
+    /// \brief Adds a tag, or replaces its value if already present.
+    BamRecordEditor& SetTag(BamRecordTag tag, const Tag& value,
+                            TagModifier additionalModifier = TagModifier::NONE);
+
+    /// \brief Removes a tag, if present.
+    ///
+    /// \throws std::runtime_error if \p tagName is not 2 characters
+    ///
+    BamRecordEditor& RemoveTag(const std::string& tagName);
+
+    /// \brief Removes a tag, if present.
+    BamRecordEditor& RemoveTag(BamRecordTag tag);
+
+    /// \brief Removes all of the record's tags, including any set so far by
+    ///        this editor.
+    BamRecordEditor& ClearTags();
+
+    /// \}
+
+public:
+    /// \brief Writes all pending changes to the record.
+    ///
+    /// The editor may then be reused for further changes to the same record.
+    ///
+    void Commit();
+
+private:
+    struct TagEdit
+    {
+        std::uint16_t Code = 0;
+        std::uint8_t Type = 0;  // 0 for removal
+        std::vector<std::uint8_t> RawData;
+        int Offset = -1;  // of tag in record's current data, if present
+    };
+
+    TagEdit& FindOrAddTagEdit(const std::string& tagName);
+    TagEdit* FindTagEdit(std::uint16_t code);
+
+    BamRecord* record_ = nullptr;
+    BamRecordImpl* impl_ = nullptr;
+
+    std::optional<std::string> name_;
+    std::optional<Data::Cigar> cigar_;
+    std::optional<std::string> sequence_;
+    std::string qualities_;
+    bool clearTags_ = false;
+    std::vector<TagEdit> tagEdits_;
+};
+
+}  // namespace BAM
+}  // namespace PacBio
+
+#endif  // PBBAM_BAMRECORDEDITOR_H
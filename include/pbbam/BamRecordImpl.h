@@ -276,9 +276,25 @@ public:
     ///
     Data::QualityValues Qualities() const;
 
+    /// \brief Copies the record's quality values into \p qualities, reusing
+    ///        its storage.
+    ///
+    /// \p qualities is left empty if quality values are not provided.
+    ///
+    void QualitiesInto(Data::QualityValues& qualities) const;
+
     /// \returns the record's DNA sequence.
     std::string Sequence() const;
 
+    /// \brief Decodes the record's DNA sequence into \p sequence, reusing its
+    ///        storage.
+    ///
+    /// \param[out] sequence            decoded bases
+    /// \param[in]  reverseComplement   if true, \p sequence is
+    ///                                 reverse-complemented while decoding
+    ///
+    void SequenceInto(std::string& sequence, bool reverseComplement = false) const;
+
     std::size_t SequenceLength() const;
 
     /// \brief Sets the record's DNA sequence and quality values
@@ -580,10 +596,15 @@ private:
 
     // internal tag helper methods
     bool AddTagImpl(const std::string& tagName, const Tag& value, TagModifier additionalModifier);
-    bool RemoveTagImpl(const std::string& tagName);
 
     int TagOffset(const std::string& tagName) const;
 
+    // tag offset table maintenance, for single-tag edits
+    void InsertTagOffset(std::uint16_t code, int offset) const;
+    void EraseTagOffset(std::uint16_t code);
+    void ShiftTagOffsets(int from, int diff);
+    void ResizeTagOffsets(std::size_t numSlots) const;
+
     // internal CIGAR handling
     void SetCigarData(const Data::Cigar& cigar);
 
@@ -591,17 +612,31 @@ private:
     BamRecordImpl& SetSequenceAndQualitiesInternal(const char* sequence, std::size_t sequenceLength,
                                                    const char* qualities, bool isPreencoded);
 
+    // marks record data as edited, see editStamp_
+    void UpdateEditStamp();
+
 private:
     // data members
     std::unique_ptr<bam1_t, HtslibRecordDeleter> d_;
     struct TagOffsetEntry
     {
-        std::uint16_t Code = 0;
+        std::uint16_t Code = 0;  // 0 marks an empty slot
         int Offset = -1;
     };
+
+    // Open-addressed (linear probing) table of tag name code -> offset of tag
+    // type into the aux data. Size is a power of 2, at most half full. Empty
+    // until first use after each read.
     mutable std::vector<TagOffsetEntry> tagOffsets_;
+    mutable int numTags_ = 0;
+
+    // Unique per edit of flags, position, CIGAR, sequence, or tags (copies
+    // share it). BamRecord compares it to detect stale cached data.
+    std::uint64_t editStamp_ = 0;
 
     // friends
+    friend class BamRecord;
+    friend class BamRecordEditor;
     friend class BamRecordMemory;
 
     // remove this when we drop support for htslib pre-v1.7
@@ -0,0 +1,80 @@
+#ifndef PBBAM_BAMRECORDPOOL_H
+#define PBBAM_BAMRECORDPOOL_H
+
+#include <pbbam/Config.h>
+
+#include <htslib/sam.h>
+
+#include <cstddef>
+
+namespace PacBio {
+namespace BAM {
+
+///
+/// \brief The BamRecordPool class recycles htslib record buffers (bam1_t, with
+///        their data blocks), to reduce allocator traffic when many short-lived
+///        records are created, e.g. ZmwGroupQuery results.
+///
+/// Pooling is disabled by default. Once enabled with Configure(), released
+/// records are kept in per-thread free lists, grouped by data capacity. Records
+/// are kept on the thread that releases them; a thread that fills its own list
+/// moves records to a shared list (if enabled), where threads that mostly
+/// allocate (e.g. reader threads) pick them up.
+///
+/// Recycled data blocks remain malloc-allocated, so htslib may grow or free
+/// them as usual.
+///
+/// BamRecordImpl acquires & releases its record data through this pool.
+///
+class PBBAM_EXPORT BamRecordPool
+{
+public:
+    struct Config
+    {
+        /// Maximum number of released records kept by each thread, 0 to
+        /// disable pooling.
+        std::size_t maxRecordsPerThread = 0;
+
+        /// Maximum number of released records shared between threads, 0 to
+        /// keep records only on the releasing thread.
+        std::size_t maxSharedRecords = 0;
+
+        /// Records with larger data blocks are freed, rather than pooled.
+        std::size_t maxRecordBytes = 64 * 1024;
+    };
+
+    /// \brief Sets the process-wide pool configuration.
+    ///
+    /// Also frees any records in the shared list. Records already held by
+    /// threads are kept until reused, or until ClearThreadCache() or thread
+    /// exit.
+    ///
+    static void Configure(const Config& config);
+
+    /// \returns current pool configuration
+    static Config CurrentConfig();
+
+    /// \brief Returns an empty record, from the current thread's pool if
+    ///        available, otherwise newly allocated (bam_init1).
+    ///
+    /// \param[in] minBytes     preferred minimum data capacity
+    ///
+    /// \returns record, to be returned with Release() (or bam_destroy1)
+    ///
+    static bam1_t* Acquire(std::size_t minBytes = 0);
+
+    /// \brief Returns \p record to the current thread's pool, or frees it if
+    ///        pooling is disabled or the pool is full.
+    static void Release(bam1_t* record) noexcept;
+
+    /// \brief Frees all records held by the current thread.
+    static void ClearThreadCache() noexcept;
+
+    /// \returns number of records held by the current thread
+    static std::size_t NumThreadCachedRecords();
+};
+
+}  // namespace BAM
+}  // namespace PacBio
+
+#endif  // PBBAM_BAMRECORDPOOL_H
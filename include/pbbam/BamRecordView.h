@@ -5,6 +5,10 @@
 
 #include <pbbam/BamRecord.h>
 
+#include <string>
+#include <vector>
+
+#include <cstddef>
 #include <cstdint>
 
 namespace PacBio {
@@ -26,6 +30,26 @@ namespace BAM {
 class PBBAM_EXPORT BamRecordView
 {
 public:
+    ///
+    /// \brief Caller-owned output buffers for Fetch().
+    ///
+    /// Only fields with a non-null buffer are fetched. Buffers are overwritten,
+    /// so that their capacity may be reused across records.
+    ///
+    struct Fields
+    {
+        std::string* sequence = nullptr;
+        Data::QualityValues* qualities = nullptr;
+        Data::QualityValues* deletionQVs = nullptr;
+        std::string* deletionTags = nullptr;
+        Data::QualityValues* insertionQVs = nullptr;
+        Data::QualityValues* mergeQVs = nullptr;
+        Data::QualityValues* substitutionQVs = nullptr;
+        std::string* substitutionTags = nullptr;
+        Data::Frames* ipd = nullptr;
+        Data::Frames* pulseWidths = nullptr;
+    };
+
     /// \brief Constructs a view onto \p record using the supplied parameters.
     ///
     /// For frame or QV data, if \p aligned is true, a value of 0 (Accuracy or
@@ -111,12 +135,35 @@ public:
     /// \returns BamRecord::SubstitutionTag with this view's parameters applied
     std::string SubstitutionTags() const;
 
+public:
+    ///
+    /// \brief Fetches all requested per-base fields, with this view's
+    ///        parameters applied.
+    ///
+    /// Results match the individual accessors (e.g. Sequence(), IPD()), but the
+    /// CIGAR is walked only once, into a map of output positions. Each field is
+    /// then decoded, oriented, clipped, and gapped in a single pass over its raw
+    /// tag data, directly into its output buffer.
+    ///
+    /// \param[in,out] fields  output buffers, see Fields
+    ///
+    /// \throws std::runtime_error if a requested tag is missing, or if its
+    ///         length does not match the record's CIGAR
+    ///
+    void Fetch(const Fields& fields) const;
+
 private:
+    void UpdatePositionMap() const;
+
     const BamRecord& record_;
     Data::Orientation orientation_;
     bool aligned_;
     bool exciseSoftClips_;
     PulseBehavior pulseBehavior_;
+
+    // aligned position -> genomic query position (or gap), see UpdatePositionMap
+    mutable std::vector<std::int32_t> positions_;
+    mutable std::size_t mappedQueryLength_ = 0;
 };
 
 }  // namespace BAM
@@ -78,6 +78,15 @@ public:
     ///
     static Tag FromRawData(std::uint8_t* rawData);
 
+    /// \brief Determines the size of a single tag's binary BAM data.
+    ///
+    /// \param[in] rawData      raw BAM bytes, starting at the tag type (as for
+    ///                         FromRawData())
+    ///
+    /// \returns number of bytes used by tag type & value
+    ///
+    static int RawDataLength(const std::uint8_t* rawData);
+
     /// \}
 };
 
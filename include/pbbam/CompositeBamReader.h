@@ -17,10 +17,12 @@
 #include <deque>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace PacBio {
@@ -28,6 +30,8 @@ namespace BAM {
 
 namespace internal {
 
+using ReaderReopener = std::function<std::unique_ptr<BamReader>()>;
+
 /// \internal
 /// \brief The CompositeMergeItem class provides a helper struct for composite
 ///        readers, containing a single-file reader and its "next" record.
@@ -38,11 +42,31 @@ public:
     std::unique_ptr<BamReader> reader;
     BamRecord record;
 
+    // If the reader has been closed ("parked") to limit the number of open
+    // files, re-opens it at its saved position. Empty otherwise.
+    ReaderReopener reopen;
+
+    // Position of the reader's input in the composite reader's file list. Only
+    // readers with a file index can be parked.
+    std::optional<std::size_t> fileIndex;
+
 public:
     CompositeMergeItem(std::unique_ptr<BamReader> rdr);
     CompositeMergeItem(std::unique_ptr<BamReader> rdr, BamRecord rec);
 };
 
+/// \internal
+/// \brief Saves a reader's current position, so that it can be closed and
+///        later re-opened at the same point.
+///
+/// Supports BamReader & PbiIndexedBamReader. Returns an empty function for
+/// other reader types, which cannot be re-opened.
+///
+/// \param[in] reader  reader to save
+/// \param[in] file    reader's input file
+///
+PBBAM_EXPORT ReaderReopener MakeReaderReopener(const BamReader& reader, const BamFile& file);
+
 /// \internal
 /// \brief The CompositeMergeItemSorter class provides a helper function object
 ///        for ordering composite reader results.
@@ -94,15 +118,54 @@ public:
     SortedCompositeBamReader(const DataSet& dataset);
     SortedCompositeBamReader(std::vector<BamFile> bamFiles);
 
+    /// \brief Constructs a composite reader that keeps at most \p maxOpenFiles
+    ///        files open at any one time.
+    ///
+    /// Readers beyond the limit are closed after saving their position, and
+    /// re-opened when their next record reaches the front of the merge. This
+    /// trades re-open cost for file handles & memory, for inputs with many
+    /// thousands of files.
+    ///
+    /// \param[in] bamFiles       input files
+    /// \param[in] maxOpenFiles   max number of open files, 0 for no limit
+    ///
+    SortedCompositeBamReader(const DataSet& dataset, std::size_t maxOpenFiles);
+    SortedCompositeBamReader(std::vector<BamFile> bamFiles, std::size_t maxOpenFiles);
+
     SortedCompositeBamReader(SortedCompositeBamReader&&) noexcept;
     SortedCompositeBamReader& operator=(SortedCompositeBamReader&&) noexcept;
     ~SortedCompositeBamReader() override;
 
     bool GetNext(BamRecord& record) override;
 
+    /// \brief Fetches the next record, for unmodified passthrough.
+    ///
+    /// \sa BamReader::GetNextRaw
+    ///
+    bool GetNextRaw(BamRecord& record);
+
 protected:
+    /// \brief Stores input files without opening any readers. Derived classes
+    ///        are then responsible for populating mergeItems_.
+    struct DeferOpen
+    {};
+    SortedCompositeBamReader(std::vector<BamFile> bamFiles, DeferOpen);
+
+    bool GetNextImpl(BamRecord& record, bool raw);
+
+    /// \brief Called when a file reader has no more records. Default behavior
+    ///        simply releases it.
+    virtual void ReleaseReader(std::unique_ptr<BamReader> reader);
+
+    // open-file limit support
+    void InsertMergeItem(internal::CompositeMergeItem item);
+    void ParkReader(internal::CompositeMergeItem& item);
+    void EnforceOpenFileLimit();
+
     std::vector<BamFile> bamFiles_;
     container_type mergeItems_;  //mergeItems_;
+    std::size_t maxOpenFiles_ = 0;
+    std::size_t numOpenFiles_ = 0;  // only tracked if maxOpenFiles_ > 0
 };
 
 /// \brief The GenomicIntervalCompositeBamReader class provides read access to
@@ -192,11 +255,36 @@ public:
     ///
     const Data::GenomicInterval& Interval() const;
 
+    /// \brief Sets multiple genomic intervals of interest.
+    ///
+    /// Records overlapping any of the intervals are returned once each, in
+    /// genomic coordinate order. Overlapping or adjacent index chunks are merged,
+    /// so a batch of nearby intervals costs fewer seeks than querying each
+    /// in turn.
+    ///
+    /// \note Interval() returns an empty interval after this call.
+    ///
+    /// \param[in] intervals   genomic intervals of interest
+    /// \returns reference to this reader
+    ///
+    GenomicIntervalCompositeBamReader& Intervals(
+        const std::vector<Data::GenomicInterval>& intervals);
+
     /// \}
 
+protected:
+    void ReleaseReader(std::unique_ptr<BamReader> reader) override;
+
 private:
+    void RetargetReaders(const std::function<void(BaiIndexedBamReader&)>& retarget);
+
     BaiIndexCache indexCache_;
     Data::GenomicInterval interval_;
+
+    // One reader per file, kept open across intervals. A reader is either
+    // active in mergeItems_, or idle here.
+    std::vector<std::unique_ptr<BaiIndexedBamReader>> idleReaders_;
+    std::vector<const BamReader*> fileReaders_;
 };
 
 /// \brief Provides read access to multipe %BAM files, limiting results to those
@@ -244,6 +332,16 @@ public:
     PbiFilterCompositeBamReader(const PbiFilter& filter, const DataSet& dataset,
                                 const PbiIndexCache& cache);
 
+    /// \brief Constructs a composite reader that keeps at most \p maxOpenFiles
+    ///        files open at any one time.
+    ///
+    /// \sa SortedCompositeBamReader(std::vector<BamFile>, std::size_t)
+    ///
+    PbiFilterCompositeBamReader(const PbiFilter& filter, const std::vector<BamFile>& bamFiles,
+                                const PbiIndexCache& cache, std::size_t maxOpenFiles);
+    PbiFilterCompositeBamReader(const PbiFilter& filter, const DataSet& dataset,
+                                std::size_t maxOpenFiles);
+
     /// \}
 
 public:
@@ -296,9 +394,17 @@ public:
     ///
     bool GetNext(BamRecord& record);
 
+    /// \brief Fetches the next record, for unmodified passthrough.
+    ///
+    /// \sa BamReader::GetNextRaw
+    ///
+    bool GetNextRaw(BamRecord& record);
+
     /// \}
 
 private:
+    bool GetNextImpl(BamRecord& record, bool raw);
+
     std::deque<std::unique_ptr<BamReader>> readers_;
 };
 
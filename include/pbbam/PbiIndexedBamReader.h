@@ -8,6 +8,7 @@
 #include <pbbam/PbiBasicTypes.h>
 #include <pbbam/PbiFilter.h>
 
+#include <memory>
 #include <string>
 
 #include <cstdint>
@@ -54,6 +55,23 @@ public:
     PbiIndexedBamReader(PbiFilter filter, BamFile bamFile,
                         const std::shared_ptr<PbiRawData>& index);
 
+    /// \brief Constructs %BAM reader, using index blocks already computed for
+    ///        a filter (see MatchingIndexBlocks).
+    ///
+    /// This allows callers (e.g. composite readers) to evaluate a filter
+    /// without opening the %BAM file, and open only those files that have
+    /// matching records.
+    ///
+    /// \param[in] filter       PbiFilter or compatible object
+    /// \param[in] bamFile      input BamFile object
+    /// \param[in] index        PBI data for \p bamFile
+    /// \param[in] blocks       result of MatchingIndexBlocks(filter, *index)
+    ///
+    /// \throws std::runtime_error if %BAM file cannot be read
+    ///
+    PbiIndexedBamReader(PbiFilter filter, BamFile bamFile,
+                        const std::shared_ptr<PbiRawData>& index, IndexResultBlocks blocks);
+
     /// \brief Constructs %BAM reader, with no initial filter.
     ///
     /// Useful for delaying either specifying the filtering criteria or
@@ -96,6 +114,12 @@ public:
 
     std::uint32_t NumReads() const;
 
+    /// \returns blocks of consecutive index rows that pass \p filter, with
+    ///          virtual file offsets applied
+    ///
+    static IndexResultBlocks MatchingIndexBlocks(const PbiFilter& filter,
+                                                 const PbiRawData& index);
+
     /// \brief Sets a new filter on the reader.
     ///
     /// \param[in] filter
@@ -106,6 +130,16 @@ public:
     /// \return list of index blocks (chunks of passing reads) currently in use
     const IndexResultBlocks& IndexBlocks() const;
 
+    /// \returns index blocks for the reads not yet returned by this reader.
+    ///
+    /// A reader constructed from these blocks will resume at the current
+    /// position.
+    ///
+    IndexResultBlocks RemainingIndexBlocks() const;
+
+    /// \returns PBI data used by this reader
+    const std::shared_ptr<PbiRawData>& Index() const;
+
     /// \}
 
 protected:
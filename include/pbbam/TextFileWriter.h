@@ -5,6 +5,9 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+
+#include <cstddef>
 
 namespace PacBio {
 namespace BAM {
@@ -15,6 +18,14 @@ namespace BAM {
 /// Supports plain text or gzipped. For explicitly-bgzipped text, use
 /// BgzipWriter instead.
 ///
+/// Lines are collected in a large output buffer, which is written (or handed
+/// to the compressor) only when full, or when the writer is closed.
+///
+/// Output is written to a temp file, which is renamed to \p filename once the
+/// writer is closed. Call Close() to detect write errors; the destructor
+/// closes the writer too, but cannot report failures (the temp file is then
+/// removed, & \p filename not created).
+///
 /// \note This is a general-purpose file writer. For FASTA/FASTQ, use the
 ///       dedicated FastaReader/FastqReader or BgzipFastaWriter/BgzipFastaWriter
 ///       for better performance.
@@ -25,9 +36,13 @@ public:
     ///
     /// \brief TextLineReader
     ///
-    /// \param filename  suffix ".gz" indicates gzipped output
+    /// \param filename    suffix ".gz" indicates gzipped output
+    /// \param numThreads  number of compression threads for gzipped output.
+    ///                    If greater than 1, output is written as BGZF (which
+    ///                    is gzip-compatible), so blocks can be compressed in
+    ///                    parallel.
     ///
-    explicit TextFileWriter(const std::string& filename);
+    explicit TextFileWriter(const std::string& filename, std::size_t numThreads = 1);
 
     TextFileWriter(TextFileWriter&&) noexcept;
     TextFileWriter& operator=(TextFileWriter&&) noexcept;
@@ -35,12 +50,19 @@ public:
 
 public:
     ///
-    /// \brief Write
-    ///
+    /// \brief Writes \p line, followed by a newline.
     ///
     /// \param line
     ///
-    void Write(const std::string& line);
+    void Write(std::string_view line);
+
+    ///
+    /// \brief Flushes remaining output & closes the file.
+    ///
+    /// \throws std::runtime_error if output could not be written. The target
+    ///         file is then not created.
+    ///
+    void Close();
 
 private:
     class TextFileWriterPrivate;
@@ -129,6 +129,23 @@ public:
     static void ValidateEntireFile(const BamFile& file,
                                    std::size_t maxErrors = std::numeric_limits<std::size_t>::max());
 
+    /// \brief Checks that a %BAM file's (entire) contents conform to the
+    ///        %PacBio specification, validating records on multiple threads.
+    ///
+    /// Records are split into contiguous ranges of PBI rows, one per thread.
+    /// Errors are reported in file order. If \p file has no PBI, or
+    /// \p numThreads is less than 2, this is equivalent to
+    /// ValidateEntireFile(file, maxErrors).
+    ///
+    /// \param[in] file         %BAM file to validate
+    /// \param[in] maxErrors    maximum number of errors to allow before throwing
+    /// \param[in] numThreads   number of threads used to validate records
+    ///
+    /// \throws ValidationException if \p file fails validation checks
+    ///
+    static void ValidateEntireFile(const BamFile& file, std::size_t maxErrors,
+                                   std::size_t numThreads);
+
     /// \brief Checks that a %BAM file's metadata conforms to the
     ///        %PacBio specification.
     ///
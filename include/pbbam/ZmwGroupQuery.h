@@ -9,6 +9,7 @@
 
 #include <vector>
 
+#include <cstddef>
 #include <cstdint>
 
 namespace PacBio {
@@ -39,6 +40,33 @@ enum class ZmwFileIterationMode
 class PBBAM_EXPORT ZmwGroupQuery : public internal::IGroupQuery
 {
 public:
+    ///
+    /// \brief Settings for sharded, multithreaded iteration.
+    ///
+    struct Config
+    {
+        /// Number of disjoint ZMW ranges, each read (& prefetched) on its own
+        /// thread. A value of 1 reads on the caller's thread.
+        std::size_t numShards = 1;
+
+        /// Maximum number of ZMW groups buffered per shard.
+        std::size_t prefetchSize = 16;
+
+        /// If true, groups are returned shard by shard, in ascending ZMW
+        /// range. Otherwise, groups are returned as soon as any shard has one
+        /// available.
+        bool deterministicOrder = true;
+
+        /// File iteration mode. Only used when not sharded; each shard
+        /// iterates its files sequentially.
+        ZmwFileIterationMode iterationMode = ZmwFileIterationMode::SEQUENTIAL;
+
+        /// Maximum number of %BAM files held open at once (per shard), 0 for
+        /// no limit. Files beyond this limit are closed after saving their
+        /// position, and re-opened when next needed.
+        std::size_t maxOpenFiles = 0;
+    };
+
     ///
     /// \brief Creates a new ZmwGroupQuery that returns BamRecords grouped by ZMW.
     ///
@@ -66,6 +94,34 @@ public:
     ///
     ZmwGroupQuery(const DataSet& dataset, const PbiFilter& filter);
 
+    ///
+    /// \brief Creates a new ZmwGroupQuery that splits the input into ZMW hole
+    ///        number ranges, reading each range on a separate thread.
+    ///
+    /// With a single shard, this reads on the caller's thread, using
+    /// Config::iterationMode. Config::maxOpenFiles may be used in either case
+    /// to limit the number of open files, for datasets with many inputs.
+    ///
+    /// Shard boundaries are computed from the PBI hole number column, so that
+    /// each shard holds roughly the same number of records. Each shard has its
+    /// own readers and its own queue of prefetched groups. Within a shard,
+    /// files are iterated sequentially.
+    ///
+    /// In this mode, GetNext() may be called concurrently, from multiple worker
+    /// threads.
+    ///
+    /// \note All %BAM files must have a corresponding ".pbi" index file.
+    ///
+    /// \param dataset          input data source(s)
+    /// \param config           sharding settings
+    /// \param filterMode       apply/ignore any filters in XML, if present
+    ///
+    /// \throws std::runtime_error on failure to open/read underlying %BAM or
+    ///         PBI files.
+    ///
+    ZmwGroupQuery(const DataSet& dataset, const Config& config,
+                  DataSetFilterMode filterMode = DataSetFilterMode::APPLY);
+
     /// \brief Creates a new ZmwGroupQuery, limiting record results to only
     ///        those matching a ZMW hole number criterion.
     ///
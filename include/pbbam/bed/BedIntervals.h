@@ -0,0 +1,138 @@
+#ifndef PBBAM_BED_BEDINTERVALS_H
+#define PBBAM_BED_BEDINTERVALS_H
+
+#include <pbbam/Config.h>
+
+#include <pbcopper/data/GenomicInterval.h>
+#include <pbcopper/data/Position.h>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace PacBio {
+namespace BED {
+
+///
+/// \brief The BedIntervals class holds BED intervals in compact, per-contig
+///        arrays, sorted by start position, for fast overlap queries.
+///
+/// FromFile() parses directly from large read buffers, without per-line
+/// allocations, and is preferred over BedReader::ReadAll for large BED files.
+///
+/// \code{cpp}
+///
+/// const auto targets = BedIntervals::FromFile(fn);
+/// if (targets.Overlaps("chr1", 1000, 2000)) {
+///     // ...
+/// }
+/// \endcode
+///
+class BedIntervals
+{
+public:
+    /// 0-based, half-open interval on a single contig
+    struct Range
+    {
+        Data::Position start;
+        Data::Position stop;
+    };
+
+    ///
+    /// \brief Loads all intervals from a BED file (plain text or gzipped).
+    ///
+    /// Header lines ("#", "track", or "browser") & empty lines are skipped.
+    /// Only the first 3 columns are read.
+    ///
+    /// \throws std::runtime_error if file cannot be read or contains
+    ///         malformed records
+    ///
+    static BedIntervals FromFile(const std::string& fn);
+
+public:
+    /// \name Constructors & Related Methods
+    /// \{
+
+    BedIntervals();
+
+    /// \}
+
+public:
+    /// \name Building
+    /// \{
+
+    ///
+    /// \brief Adds an interval. Queries require a sorted container, so call
+    ///        Sort() after adding intervals out of order.
+    ///
+    void Add(std::string_view contig, Data::Position start, Data::Position stop);
+
+    /// \brief Sorts each contig's intervals by start position
+    void Sort();
+
+    /// \}
+
+public:
+    /// \name Access & Queries
+    ///
+    /// Overlap queries throw std::runtime_error if the container is unsorted.
+    ///
+    /// \{
+
+    /// \returns contig names, in order first seen
+    const std::vector<std::string>& Contigs() const;
+
+    /// \returns sorted intervals for \p contig (empty if contig is unknown)
+    const std::vector<Range>& Intervals(std::string_view contig) const;
+
+    /// \returns total number of intervals, across all contigs
+    std::size_t NumIntervals() const;
+
+    /// \returns true if any interval overlaps [start, stop) on \p contig
+    bool Overlaps(std::string_view contig, Data::Position start, Data::Position stop) const;
+
+    /// \returns all intervals overlapping [start, stop) on \p contig, in
+    ///          sorted order
+    std::vector<Range> Overlapping(std::string_view contig, Data::Position start,
+                                   Data::Position stop) const;
+
+    ///
+    /// \returns all intervals as GenomicIntervals, in contig & sorted order,
+    ///          e.g. for batch GenomicIntervalQuery use
+    ///
+    std::vector<Data::GenomicInterval> ToGenomicIntervals() const;
+
+    /// \}
+
+private:
+    struct ContigIntervals
+    {
+        std::vector<Range> ranges;
+
+        // running max of ranges[0..i].stop, bounds overlap searches
+        std::vector<Data::Position> maxStops;
+    };
+
+    std::size_t ContigIndex(std::string_view contig);
+    const ContigIntervals* Find(std::string_view contig) const;
+
+    // [first, last) candidate range indices for [start, stop)
+    std::pair<std::size_t, std::size_t> OverlapCandidates(const ContigIntervals& intervals,
+                                                          Data::Position start,
+                                                          Data::Position stop) const;
+
+    std::vector<std::string> contigNames_;
+    std::unordered_map<std::string, std::size_t> contigLookup_;
+    std::vector<ContigIntervals> contigs_;
+    std::size_t lastContigIndex_ = 0;
+    bool isSorted_ = true;
+};
+
+}  // namespace BED
+}  // namespace PacBio
+
+#endif  // PBBAM_BED_BEDINTERVALS_H
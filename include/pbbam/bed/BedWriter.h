@@ -6,6 +6,9 @@
 #include <pbcopper/data/GenomicInterval.h>
 
 #include <memory>
+#include <string>
+
+#include <cstddef>
 
 namespace PacBio {
 namespace BED {
@@ -13,7 +16,12 @@ namespace BED {
 class BedWriter
 {
 public:
-    explicit BedWriter(const std::string& fn);
+    ///
+    /// \param fn          suffix ".gz" indicates gzipped output
+    /// \param numThreads  number of compression threads for gzipped output
+    ///                    (see TextFileWriter)
+    ///
+    explicit BedWriter(const std::string& fn, std::size_t numThreads = 1);
 
     BedWriter(BedWriter&&) noexcept;
     BedWriter& operator=(BedWriter&&) noexcept;
@@ -22,6 +30,12 @@ public:
 public:
     void Write(const Data::GenomicInterval& interval);
 
+    /// \brief Flushes remaining output & closes the file.
+    ///
+    /// \throws std::runtime_error if output could not be written
+    ///
+    void Close();
+
 private:
     class BedWriterPrivate;
     std::unique_ptr<BedWriterPrivate> d_;
@@ -9,8 +9,11 @@
 
 #include <filesystem>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include <cstddef>
+
 namespace PacBio {
 namespace CSV {
 
@@ -42,6 +45,20 @@ namespace CSV {
 ///
 /// Both plain-text and gzipped input are supported.
 ///
+/// For large tables, rows may instead be read as CsvRowView (fields as views
+/// into a reused line buffer), with column indices resolved once, up front:
+///
+/// \code
+///    CsvReader reader{filename};
+///    const std::size_t nameIdx = reader.ColumnIndex("name");
+///    CsvRowView row;
+///    while (reader.GetNext(row)) {
+///        const std::string_view name = row[nameIdx];
+///    }
+/// \endcode
+///
+/// Or whole columns may be loaded into typed vectors with ReadColumns().
+///
 class CsvReader : public BAM::internal::QueryBase<CsvRecord>
 {
 public:
@@ -57,10 +74,27 @@ public:
     // Returns list of column names, as seen in file
     const CsvHeader& Header() const;
 
+    // Returns index of column 'name' in the header (i.e. into CsvRowView).
+    // Throws if no such column exists.
+    std::size_t ColumnIndex(std::string_view name) const;
+
     // Likely not necessary in client code, range-for is supported.
     bool GetNext(CsvRecord& record) final;
 
+    // Reads next row's fields, without copying. Views are valid until the
+    // next read.
+    bool GetNext(CsvRowView& row);
+
+    // Loads the requested columns from all remaining rows, in the order
+    // requested. Rows are read in batches, and each batch is split & parsed
+    // across 'numThreads' threads. Throws if a value cannot be parsed as the
+    // requested type.
+    std::vector<CsvColumn> ReadColumns(const std::vector<CsvColumnSpec>& columns,
+                                       std::size_t numThreads = 1);
+
 private:
+    void CheckFieldCount(std::size_t numFields, int recordNumber) const;
+    bool FetchRecordLine();
     void SkipAndStoreLeadingComments();
 
     BAM::TextFileReader reader_;
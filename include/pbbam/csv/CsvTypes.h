@@ -5,8 +5,12 @@
 
 #include <map>
 #include <string>
+#include <string_view>
+#include <variant>
 #include <vector>
 
+#include <cstdint>
+
 namespace PacBio {
 namespace CSV {
 
@@ -14,6 +18,32 @@ using CsvHeader = std::vector<std::string>;
 
 using CsvRecord = std::map<std::string, std::string>;
 
+///
+/// Row fields, in header column order. Fields view the reader's line buffer,
+/// and are only valid until the next row is read.
+///
+using CsvRowView = std::vector<std::string_view>;
+
+enum class CsvColumnType
+{
+    STRING,
+    INT64,
+    DOUBLE
+};
+
+struct CsvColumnSpec
+{
+    std::string name;
+    CsvColumnType type = CsvColumnType::STRING;
+};
+
+///
+/// Fully-loaded column values, holding the vector type matching the
+/// requested CsvColumnType.
+///
+using CsvColumn =
+    std::variant<std::vector<std::string>, std::vector<std::int64_t>, std::vector<double>>;
+
 }  // namespace CSV
 }  // namespace PacBio
 
@@ -10,6 +10,8 @@
 #include <string>
 #include <vector>
 
+#include <cstddef>
+
 namespace PacBio {
 namespace CSV {
 
@@ -35,20 +37,27 @@ namespace CSV {
 /// so the caller must be sure to provide the desired prefix (typically '#').
 ///
 /// Both plain-text and gzipped output are supported. Use the ".gz" filename suffix
-/// to enable compression.
+/// to enable compression, and 'numThreads' > 1 for multithreaded compression
+/// (see TextFileWriter).
 ///
 class CsvWriter
 {
 public:
     CsvWriter(const std::filesystem::path& filename, CsvHeader header, char delimiter,
-              const std::vector<std::string>& comments = {});
+              const std::vector<std::string>& comments = {}, std::size_t numThreads = 1);
     void Write(const CsvRecord& record);
 
+    /// \brief Flushes remaining output & closes the file.
+    ///
+    /// \throws std::runtime_error if output could not be written
+    ///
+    void Close();
+
 private:
     BAM::TextFileWriter writer_;
     CsvHeader header_;
-    std::string delimiter_;
-    std::vector<std::string> fields_;
+    char delimiter_;
+    std::string line_;
 };
 
 }  // namespace CSV
@@ -52,17 +52,39 @@ SortedCompositeBamReader<OrderByType>::SortedCompositeBamReader(const DataSet& d
 
 template <typename OrderByType>
 SortedCompositeBamReader<OrderByType>::SortedCompositeBamReader(std::vector<BamFile> bamFiles)
-    : internal::IQuery{}, bamFiles_{std::move(bamFiles)}
+    : SortedCompositeBamReader{std::move(bamFiles), std::size_t{0}}
+{
+}
+
+template <typename OrderByType>
+SortedCompositeBamReader<OrderByType>::SortedCompositeBamReader(const DataSet& dataset,
+                                                                const std::size_t maxOpenFiles)
+    : SortedCompositeBamReader{dataset.BamFiles(), maxOpenFiles}
+{
+}
+
+template <typename OrderByType>
+SortedCompositeBamReader<OrderByType>::SortedCompositeBamReader(std::vector<BamFile> bamFiles,
+                                                                const std::size_t maxOpenFiles)
+    : internal::IQuery{}, bamFiles_{std::move(bamFiles)}, maxOpenFiles_{maxOpenFiles}
 {
     // create readers for files
-    for (const auto& bamFile : bamFiles_) {
-        internal::CompositeMergeItem item{std::make_unique<BamReader>(bamFile)};
+    for (std::size_t i = 0; i < bamFiles_.size(); ++i) {
+        internal::CompositeMergeItem item{std::make_unique<BamReader>(bamFiles_[i])};
+        item.fileIndex = i;
         if (item.reader->GetNext(item.record)) {
-            mergeItems_.insert(std::move(item));
+            InsertMergeItem(std::move(item));
         }
     }
 }
 
+template <typename OrderByType>
+SortedCompositeBamReader<OrderByType>::SortedCompositeBamReader(std::vector<BamFile> bamFiles,
+                                                                DeferOpen)
+    : internal::IQuery{}, bamFiles_{std::move(bamFiles)}
+{
+}
+
 template <typename OrderByType>
 SortedCompositeBamReader<OrderByType>::SortedCompositeBamReader(
     SortedCompositeBamReader&&) noexcept = default;
@@ -76,6 +98,18 @@ SortedCompositeBamReader<OrderByType>::~SortedCompositeBamReader() = default;
 
 template <typename OrderByType>
 bool SortedCompositeBamReader<OrderByType>::GetNext(BamRecord& record)
+{
+    return GetNextImpl(record, false);
+}
+
+template <typename OrderByType>
+bool SortedCompositeBamReader<OrderByType>::GetNextRaw(BamRecord& record)
+{
+    return GetNextImpl(record, true);
+}
+
+template <typename OrderByType>
+bool SortedCompositeBamReader<OrderByType>::GetNextImpl(BamRecord& record, const bool raw)
 {
     if (mergeItems_.empty()) {
         return false;
@@ -86,16 +120,84 @@ bool SortedCompositeBamReader<OrderByType>::GetNext(BamRecord& record)
     auto& firstRecord = firstItem.record;
     std::swap(record, firstRecord);
 
-    // Try to read next record from current reader. If available, re-insert
-    // into the set. Otherwise, just drop it (dtor will release resource).
+    // Re-open reader, if it was parked to limit the number of open files.
+    // (Readers are only parked if there is a limit, so the count is tracked.)
     internal::CompositeMergeItem tmp(std::move(firstItem));
     mergeItems_.erase(mergeItems_.begin());
-    if (tmp.reader->GetNext(tmp.record)) {
+    const bool reopened = !tmp.reader;
+    if (reopened) {
+        tmp.reader = tmp.reopen();
+        tmp.reopen = nullptr;
+        ++numOpenFiles_;
+    }
+
+    // Try to read next record from current reader. If available, re-insert
+    // into the set. Otherwise, just drop it (dtor will release resource).
+    const bool hasNext =
+        raw ? tmp.reader->GetNextRaw(tmp.record) : tmp.reader->GetNext(tmp.record);
+    if (hasNext) {
         mergeItems_.insert(std::move(tmp));
+        if (reopened) {
+            EnforceOpenFileLimit();
+        }
+    } else {
+        if (maxOpenFiles_ > 0) {
+            --numOpenFiles_;
+        }
+        ReleaseReader(std::move(tmp.reader));
     }
     return true;
 }
 
+template <typename OrderByType>
+void SortedCompositeBamReader<OrderByType>::InsertMergeItem(internal::CompositeMergeItem item)
+{
+    if (maxOpenFiles_ > 0 && item.reader) {
+        ++numOpenFiles_;
+        if (numOpenFiles_ > maxOpenFiles_) {
+            ParkReader(item);
+        }
+    }
+    mergeItems_.insert(std::move(item));
+}
+
+template <typename OrderByType>
+void SortedCompositeBamReader<OrderByType>::ParkReader(internal::CompositeMergeItem& item)
+{
+    if (item.fileIndex) {
+        item.reopen = internal::MakeReaderReopener(*item.reader, bamFiles_.at(*item.fileIndex));
+    }
+
+    // leave open if reader cannot be restored
+    if (item.reopen) {
+        item.reader.reset();
+        --numOpenFiles_;
+    }
+}
+
+template <typename OrderByType>
+void SortedCompositeBamReader<OrderByType>::EnforceOpenFileLimit()
+{
+    if (maxOpenFiles_ == 0) {
+        return;
+    }
+
+    // park readers whose next records are furthest from the merge frontier
+    for (auto iter = mergeItems_.rbegin();
+         numOpenFiles_ > maxOpenFiles_ && iter != mergeItems_.rend(); ++iter) {
+        auto& item = const_cast<internal::CompositeMergeItem&>(*iter);
+        if (item.reader) {
+            ParkReader(item);
+        }
+    }
+}
+
+template <typename OrderByType>
+void SortedCompositeBamReader<OrderByType>::ReleaseReader(std::unique_ptr<BamReader>)
+{
+    // nothing to do, reader is closed on return
+}
+
 // ------------------------------
 // PbiFilterCompositeReader
 // ------------------------------
@@ -110,8 +212,24 @@ PbiFilterCompositeBamReader<OrderByType>::PbiFilterCompositeBamReader(
 template <typename OrderByType>
 PbiFilterCompositeBamReader<OrderByType>::PbiFilterCompositeBamReader(
     const PbiFilter& filter, const std::vector<BamFile>& bamFiles, const PbiIndexCache& cache)
-    : SortedCompositeBamReader<OrderByType>{bamFiles}, indexCache_{cache}, numReads_{0}
+    : SortedCompositeBamReader<OrderByType>{
+          bamFiles, typename SortedCompositeBamReader<OrderByType>::DeferOpen{}}
+    , indexCache_{cache}
+    , numReads_{0}
+{
+    Filter(filter);
+}
+
+template <typename OrderByType>
+PbiFilterCompositeBamReader<OrderByType>::PbiFilterCompositeBamReader(
+    const PbiFilter& filter, const std::vector<BamFile>& bamFiles, const PbiIndexCache& cache,
+    const std::size_t maxOpenFiles)
+    : SortedCompositeBamReader<OrderByType>{
+          bamFiles, typename SortedCompositeBamReader<OrderByType>::DeferOpen{}}
+    , indexCache_{cache}
+    , numReads_{0}
 {
+    this->maxOpenFiles_ = maxOpenFiles;
     Filter(filter);
 }
 
@@ -122,6 +240,14 @@ PbiFilterCompositeBamReader<OrderByType>::PbiFilterCompositeBamReader(const PbiF
 {
 }
 
+template <typename OrderByType>
+PbiFilterCompositeBamReader<OrderByType>::PbiFilterCompositeBamReader(
+    const PbiFilter& filter, const DataSet& dataset, const std::size_t maxOpenFiles)
+    : PbiFilterCompositeBamReader<OrderByType>{filter, dataset.BamFiles(),
+                                               MakePbiIndexCache(dataset), maxOpenFiles}
+{
+}
+
 template <typename OrderByType>
 PbiFilterCompositeBamReader<OrderByType>::PbiFilterCompositeBamReader(const PbiFilter& filter,
                                                                       const DataSet& dataset,
@@ -136,25 +262,15 @@ PbiFilterCompositeBamReader<OrderByType>& PbiFilterCompositeBamReader<OrderByTyp
 {
     // reset reader queue
     this->mergeItems_.clear();
+    this->numOpenFiles_ = 0;
 
-    // create readers for files
-    container_type updatedMergeItems;
+    // throw if any files missing PBI
     std::vector<std::string> missingPbi;
-    for (std::size_t i = 0; i < this->bamFiles_.size(); ++i) {
-        const auto& bamFile = this->bamFiles_.at(i);
-        if (bamFile.PacBioIndexExists()) {
-            auto item = internal::CompositeMergeItem{std::unique_ptr<BamReader>{
-                new PbiIndexedBamReader{filter, std::move(bamFile), indexCache_->at(i)}}};
-            if (item.reader->GetNext(item.record)) {
-                updatedMergeItems.insert(std::move(item));
-            }
-            // else not an error, simply no data matching filter
-        } else {
+    for (const auto& bamFile : this->bamFiles_) {
+        if (!bamFile.PacBioIndexExists()) {
             missingPbi.push_back(bamFile.Filename());
         }
     }
-
-    // throw if any files missing PBI
     if (!missingPbi.empty()) {
         std::ostringstream e;
         e << "[pbbam] composite BAM reader ERROR: failed to open because the following files are "
@@ -165,13 +281,26 @@ PbiFilterCompositeBamReader<OrderByType>& PbiFilterCompositeBamReader<OrderByTyp
         throw std::runtime_error{e.str()};
     }
 
-    // update our actual container, store num matching reads, sort & and return
-    this->mergeItems_ = std::move(updatedMergeItems);
-    numReads_ = 0;
-    for (const auto& item : this->mergeItems_) {
-        auto* pbiReader = dynamic_cast<PbiIndexedBamReader*>(item.reader.get());
-        numReads_ += pbiReader->NumReads();
+    // Apply filter to each index, only opening files that have matching reads.
+    std::uint32_t numReads = 0;
+    for (std::size_t i = 0; i < this->bamFiles_.size(); ++i) {
+        const auto& index = indexCache_->at(i);
+        auto blocks = PbiIndexedBamReader::MatchingIndexBlocks(filter, *index);
+        if (blocks.empty()) {
+            continue;  // not an error, simply no data matching filter
+        }
+
+        auto item = internal::CompositeMergeItem{std::make_unique<PbiIndexedBamReader>(
+            filter, this->bamFiles_.at(i), index, std::move(blocks))};
+        item.fileIndex = i;
+        numReads += static_cast<PbiIndexedBamReader*>(item.reader.get())->NumReads();
+        if (item.reader->GetNext(item.record)) {
+            this->InsertMergeItem(std::move(item));
+        }
     }
+
+    // store num matching reads & return
+    numReads_ = numReads;
     return *this;
 }
 
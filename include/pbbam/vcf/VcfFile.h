@@ -10,6 +10,16 @@
 namespace PacBio {
 namespace VCF {
 
+enum class VcfIndexType
+{
+    TABIX,  ///< ".tbi" index
+    CSI     ///< ".csi" index, needed for contigs longer than 2^29 bp
+};
+
+///
+/// \brief The VcfFile class represents a plain-text or BGZF-compressed
+///        (".vcf.gz") VCF file.
+///
 class VcfFile
 {
 public:
@@ -19,6 +29,27 @@ public:
     const std::string& Filename() const;
     const VcfHeader& Header() const;
 
+public:
+    /// \name Compression & indexing
+    /// \{
+
+    /// \returns true if file is BGZF-compressed (required for indexing)
+    bool IsCompressed() const;
+
+    /// \returns true if a tabix (".tbi") or CSI (".csi") index exists for this file
+    bool IndexExists() const;
+
+    ///
+    /// \brief Creates an index file of the requested \p type, if no index
+    ///        already exists.
+    ///
+    /// \throws std::runtime_error if file is not BGZF-compressed, or the index
+    ///         could not be created
+    ///
+    void EnsureIndexExists(VcfIndexType type = VcfIndexType::TABIX) const;
+
+    /// \}
+
 private:
     std::string filename_;
     VcfHeader header_;
@@ -8,7 +8,10 @@
 #include <pbbam/vcf/VcfReader.h>
 #include <pbbam/vcf/VcfVariant.h>
 
+#include <pbcopper/data/GenomicInterval.h>
+
 #include <string>
+#include <vector>
 
 namespace PacBio {
 namespace VCF {
@@ -19,6 +22,24 @@ public:
     explicit VcfQuery(std::string fn);
     explicit VcfQuery(const VcfFile& file);
 
+    ///
+    /// \brief Creates a query over variants overlapping \p interval.
+    ///
+    /// Requires a BGZF-compressed file with a tabix/CSI index. Use
+    /// VcfFile::EnsureIndexExists before creating the query if one may not be
+    /// present.
+    ///
+    VcfQuery(const VcfFile& file, const Data::GenomicInterval& interval);
+
+    ///
+    /// \brief Creates a query over variants overlapping any of \p intervals.
+    ///
+    /// Each variant is returned at most once, in file order.
+    ///
+    /// \sa VcfReader
+    ///
+    VcfQuery(const VcfFile& file, const std::vector<Data::GenomicInterval>& intervals);
+
 public:
     /// \brief Main iteration point for record access.
     ///
@@ -6,16 +6,20 @@
 #include <pbbam/vcf/VcfFile.h>
 #include <pbbam/vcf/VcfHeader.h>
 #include <pbbam/vcf/VcfVariant.h>
+#include <pbbam/vcf/VcfVariantView.h>
+
+#include <pbcopper/data/GenomicInterval.h>
 
-#include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace PacBio {
 namespace VCF {
 
 ///
-/// \brief The VcfReader class
+/// \brief The VcfReader class reads variants from plain-text or
+///        BGZF-compressed VCF files.
 ///
 class VcfReader
 {
@@ -23,18 +27,48 @@ public:
     explicit VcfReader(std::string fn);
     explicit VcfReader(const VcfFile& file);
 
+    ///
+    /// \brief Creates a reader that only returns variants overlapping
+    ///        \p interval, using the file's tabix/CSI index.
+    ///
+    /// \throws std::runtime_error if file is not BGZF-compressed, or its
+    ///         index could not be loaded
+    ///
+    VcfReader(const VcfFile& file, const Data::GenomicInterval& interval);
+
+    ///
+    /// \brief Creates a reader that only returns variants overlapping any of
+    ///        \p intervals, using the file's tabix/CSI index.
+    ///
+    /// Intervals are visited in file order, and overlapping intervals are
+    /// merged, so each variant is returned at most once. Intervals on contigs
+    /// with no variants are ignored.
+    ///
+    /// \throws std::runtime_error if file is not BGZF-compressed, or its
+    ///         index could not be loaded
+    ///
+    VcfReader(const VcfFile& file, const std::vector<Data::GenomicInterval>& intervals);
+
+    VcfReader(VcfReader&&) noexcept;
+    VcfReader& operator=(VcfReader&&) noexcept;
+    ~VcfReader();
+
 public:
     const VcfHeader& Header() const;
 
     bool GetNext(VcfVariant& var);
 
-private:
-    void FetchNext();
+    ///
+    /// \brief Fetches the next variant line, without fully parsing it.
+    ///
+    /// Line buffers are swapped between the reader & \p var, so no allocation
+    /// is needed once buffers have grown to the typical line length.
+    ///
+    bool GetNext(VcfVariantView& var);
 
 private:
-    std::ifstream in_;
-    VcfHeader header_;
-    std::string line_;
+    struct VcfReaderPrivate;
+    std::unique_ptr<VcfReaderPrivate> d_;
 };
 
 }  // namespace VCF
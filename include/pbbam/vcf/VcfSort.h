@@ -7,9 +7,34 @@
 
 #include <string>
 
+#include <cstddef>
+
 namespace PacBio {
 namespace VCF {
 
+///
+/// \brief Settings for bounded-memory sorting.
+///
+struct SortConfig
+{
+    /// Approximate memory budget (in bytes) for buffered variant lines. Input
+    /// exceeding this budget is sorted in chunks, written to temporary files,
+    /// and merged.
+    std::size_t maxMemory = 512 * 1024 * 1024;
+
+    /// Number of threads used to sort chunks. The memory budget is shared
+    /// among them.
+    std::size_t numThreads = 1;
+
+    /// Maximum number of temporary files merged (and open) at once. If more
+    /// chunks are written, they are merged in multiple passes.
+    std::size_t maxMergeFiles = 64;
+
+    /// Directory for temporary files. If empty, the output file's directory
+    /// is used.
+    std::string tempDirectory;
+};
+
 ///
 /// \brief SortFile
 /// \param file
@@ -24,6 +49,31 @@ void SortFile(const VcfFile& file, const std::string& outputFilename);
 ///
 void SortFile(const std::string& inputFilename, const std::string& outputFilename);
 
+///
+/// \brief Sorts variants by (contig, position), using bounded memory.
+///
+/// Variant lines are not fully parsed. Only CHROM & POS are read, to compute
+/// the sort key. Lines are written unchanged, and variants with equal keys keep
+/// their input order. Contig order follows the header's ##contig lines.
+/// Input may be plain-text or BGZF-compressed; blank lines are skipped.
+///
+/// \param file            input VCF
+/// \param outputFilename  sorted VCF output
+/// \param config          memory budget & threads
+///
+/// \throws std::runtime_error if a variant's contig is not in the header, or
+///         if input, temporary, or output files cannot be read or written
+///
+void SortFile(const VcfFile& file, const std::string& outputFilename, const SortConfig& config);
+
+///
+/// \brief Sorts variants by (contig, position), using bounded memory.
+///
+/// \sa SortFile(const VcfFile&, const std::string&, const SortConfig&)
+///
+void SortFile(const std::string& inputFilename, const std::string& outputFilename,
+              const SortConfig& config);
+
 }  // namespace VCF
 }  // namespace PacBio
 
@@ -0,0 +1,122 @@
+#ifndef PBBAM_VCF_VARIANTVIEW_H
+#define PBBAM_VCF_VARIANTVIEW_H
+
+#include <pbbam/Config.h>
+
+#include <pbbam/vcf/VcfVariant.h>
+
+#include <pbcopper/data/Position.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+
+namespace PacBio {
+namespace VCF {
+
+///
+/// \brief The VcfVariantView class provides read-only, low-overhead access to a
+///        single VCF data line.
+///
+/// The line text is stored as-is, and fixed columns are returned as views into
+/// it. INFO and sample genotype columns are only split on first access, and
+/// their values are also returned as (unsplit) views. Use ToVariant() for a
+/// fully-parsed, editable VcfVariant.
+///
+/// Views are invalidated when the line is replaced (e.g. VcfReader::GetNext).
+///
+class VcfVariantView
+{
+public:
+    VcfVariantView();
+
+    explicit VcfVariantView(std::string text);
+
+public:
+    // core fields
+
+    std::string_view Chrom() const;
+    Data::Position Position() const;
+    std::string_view Id() const;
+    std::string_view RefAllele() const;
+    std::string_view AltAllele() const;
+    float Quality() const;
+    std::string_view Filter() const;
+
+    // convenience methods
+    bool IsDeletion() const;
+    bool IsInsertion() const;
+    bool IsQualityMissing() const;
+    bool IsSnp() const;
+
+public:
+    // info fields
+
+    /// \returns raw INFO column text
+    std::string_view InfoText() const;
+
+    bool HasInfoField(std::string_view id) const;
+
+    /// \returns raw value text for INFO field \p id (multiple values remain
+    ///          comma-separated), or empty optional if field is missing or
+    ///          has no value (flag)
+    std::optional<std::string_view> InfoValue(std::string_view id) const;
+
+public:
+    // sample genotypes
+
+    std::size_t NumSamples() const;
+
+    /// \returns genotype IDs, from the FORMAT column
+    std::vector<std::string_view> GenotypeIds() const;
+
+    /// \returns raw value text for genotype field \p id, for sample at
+    ///          \p sampleIndex (multiple values remain comma-separated), or
+    ///          empty optional if field is missing
+    std::optional<std::string_view> GenotypeValue(std::size_t sampleIndex,
+                                                  std::string_view id) const;
+
+public:
+    /// \returns full line text
+    const std::string& Text() const;
+
+    /// \brief Replaces this view's line, swapping in \p text.
+    ///
+    /// On return, \p text holds the previous line, so that its buffer may be
+    /// reused for reading the next one.
+    ///
+    void SwapText(std::string& text);
+
+    /// \returns fully-parsed variant
+    VcfVariant ToVariant() const;
+
+private:
+    // (offset, length) into text_, stable across moves
+    using Span = std::pair<std::size_t, std::size_t>;
+
+    std::string_view View(const Span& span) const;
+    void ParseFixedColumns();
+    void ParseInfo() const;
+    void ParseGenotypes() const;
+
+    std::string text_;
+    std::vector<Span> columns_;  // CHROM - INFO
+    std::size_t genotypesOffset_;
+    Data::Position pos_;
+
+    // lazily-populated INFO & genotype data
+    mutable bool infoParsed_ = false;
+    mutable std::vector<std::pair<Span, std::optional<Span>>> info_;
+    mutable bool genotypesParsed_ = false;
+    mutable std::vector<Span> format_;
+    mutable std::vector<Span> samples_;
+};
+
+}  // namespace VCF
+}  // namespace PacBio
+
+#endif  // PBBAM_VCF_VARIANTVIEW_H
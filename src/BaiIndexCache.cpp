@@ -3,14 +3,25 @@
 #include <pbbam/BaiIndexCache.h>
 
 #include <pbbam/BamFile.h>
+#include <pbbam/BamHeader.h>
 #include <pbbam/DataSet.h>
 #include <pbbam/Deleters.h>
 #include "ErrnoReason.h"
+#include "MemoryUtils.h"
 
 #include <htslib/sam.h>
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cstdlib>
+#include <cstring>
 
 namespace PacBio {
 namespace BAM {
@@ -51,6 +62,94 @@ hts_itr_t* BaiIndexCacheData::IteratorForInterval(const std::int32_t refId,
     return bam_itr_queryi(d_->htsIndex_.get(), refId, start, stop);
 }
 
+hts_itr_t* BaiIndexCacheData::IteratorForRegions(
+    const BamHeader& header, const std::vector<Data::GenomicInterval>& intervals) const
+{
+    // interval type differs across htslib versions
+    using RegionInterval = std::remove_pointer_t<decltype(hts_reglist_t::intervals)>;
+    using RegionPosition = decltype(RegionInterval::beg);
+
+    struct Reference
+    {
+        std::string name;
+        std::vector<std::pair<Data::Position, Data::Position>> intervals;
+    };
+
+    // group intervals by reference ID, in file order
+    std::map<std::int32_t, Reference> references;
+    for (const auto& interval : intervals) {
+        if (interval.Stop() <= interval.Start()) {
+            continue;
+        }
+        auto& ref = references[header.SequenceId(interval.Name())];
+        ref.name = interval.Name();
+        ref.intervals.emplace_back(interval.Start(), interval.Stop());
+    }
+    if (references.empty()) {
+        return nullptr;
+    }
+
+    // The iterator takes ownership of the (malloc-ed) region list & interval
+    // arrays. Reference names are stored in the list's own block, so they are
+    // freed with it.
+    std::size_t nameBytes = 0;
+    for (const auto& ref : references) {
+        nameBytes += ref.second.name.size() + 1;
+    }
+    const std::size_t numRegions = references.size();
+    void* block = std::malloc((numRegions * sizeof(hts_reglist_t)) + nameBytes);
+    if (block == nullptr) {
+        return nullptr;
+    }
+    auto* regions = static_cast<hts_reglist_t*>(block);
+    char* names = static_cast<char*>(block) + (numRegions * sizeof(hts_reglist_t));
+
+    int numFilled = 0;
+    for (auto& [refId, ref] : references) {
+        // sort & merge overlapping (or adjacent) intervals
+        auto& refIntervals = ref.intervals;
+        std::sort(refIntervals.begin(), refIntervals.end());
+        std::vector<std::pair<Data::Position, Data::Position>> merged;
+        for (const auto& interval : refIntervals) {
+            if (!merged.empty() && interval.first <= merged.back().second) {
+                merged.back().second = std::max(merged.back().second, interval.second);
+            } else {
+                merged.push_back(interval);
+            }
+        }
+
+        auto* regionIntervals =
+            static_cast<RegionInterval*>(std::malloc(merged.size() * sizeof(RegionInterval)));
+        if (regionIntervals == nullptr) {
+            hts_reglist_free(regions, numFilled);
+            return nullptr;
+        }
+        for (std::size_t i = 0; i < merged.size(); ++i) {
+            regionIntervals[i].beg = static_cast<RegionPosition>(merged[i].first);
+            regionIntervals[i].end = static_cast<RegionPosition>(merged[i].second);
+        }
+
+        std::memcpy(names, ref.name.c_str(), ref.name.size() + 1);
+
+        hts_reglist_t& region = regions[numFilled];
+        region = hts_reglist_t{};
+        region.reg = names;
+        region.intervals = regionIntervals;
+        region.tid = refId;
+        region.count = static_cast<std::uint32_t>(merged.size());
+        region.min_beg = regionIntervals[0].beg;
+        region.max_end = regionIntervals[merged.size() - 1].end;
+
+        names += ref.name.size() + 1;
+        ++numFilled;
+    }
+
+    // htslib merges overlapping chunks across regions
+    const auto rawHeader = BamHeaderMemory::MakeRawHeader(header);
+    return sam_itr_regions(d_->htsIndex_.get(), rawHeader.get(), regions,
+                           static_cast<unsigned int>(numRegions));
+}
+
 using BaiIndexCache = std::shared_ptr<std::vector<std::shared_ptr<BaiIndexCacheData>>>;
 
 BaiIndexCache MakeBaiIndexCache(const DataSet& dataset)
@@ -8,6 +8,8 @@
 
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <cassert>
 #include <cstddef>
@@ -37,6 +39,7 @@ public:
     void Interval(const BamHeader& header, const Data::GenomicInterval& interval)
     {
         htsIterator_.reset();
+        interval_ = interval;
 
         if (header.HasSequence(interval.Name())) {
             auto id = header.SequenceId(interval.Name());
@@ -59,10 +62,55 @@ public:
         }
     }
 
+    void Intervals(const BamHeader& header, const std::vector<Data::GenomicInterval>& intervals)
+    {
+        htsIterator_.reset();
+        interval_ = Data::GenomicInterval{};
+
+        bool hasRegions = false;
+        for (const auto& interval : intervals) {
+            if (!header.HasSequence(interval.Name())) {
+                std::ostringstream s;
+                s << "[pbbam] indexed BAM reader ERROR: could not create iterator for requested "
+                     "region: "
+                  << interval.Interval() << '\n'
+                  << "  BAM file: " << file_.Filename() << '\n'
+                  << "  reason: unknown reference name";
+                throw std::runtime_error{s.str()};
+            }
+            if (interval.Stop() > interval.Start()) {
+                hasRegions = true;
+            }
+        }
+
+        // no (non-empty) regions, so no data
+        if (!hasRegions) {
+            return;
+        }
+
+        htsIterator_.reset(index_->IteratorForRegions(header, intervals));
+        if (!htsIterator_) {
+            std::ostringstream s;
+            s << "[pbbam] indexed BAM reader ERROR: could not create iterator for requested "
+                 "regions\n"
+              << "  BAM file: " << file_.Filename() << '\n'
+              << "  BAI file: " << file_.StandardIndexFilename();
+            MaybePrintErrnoReason(s);
+            throw std::runtime_error{s.str()};
+        }
+    }
+
     // clang-format off
     int ReadRawData(samFile* sam, bam1_t* b)
     {
-        assert(htsIterator_.get());
+        // empty region list
+        if (!htsIterator_) {
+            return -1;
+        }
+
+        if (htsIterator_->multi) {
+            return hts_itr_multi_next(sam, htsIterator_.get(), b);
+        }
 
 // HTS_VERSION only added >= v1.10
 #if defined(HTS_VERSION) && HTS_VERSION >= 101000
@@ -89,13 +137,13 @@ BaiIndexedBamReader::BaiIndexedBamReader(std::string filename,
 {}
 
 BaiIndexedBamReader::BaiIndexedBamReader(BamFile bamFile)
-    : BamReader{bamFile.Filename()}
+    : BamReader{bamFile}
     , d_{std::make_unique<BaiIndexedBamReaderPrivate>(std::move(bamFile), nullptr)}
 {}
 
 BaiIndexedBamReader::BaiIndexedBamReader(BamFile bamFile,
                                          const std::shared_ptr<BaiIndexCacheData>& index)
-    : BamReader{bamFile.Filename()}
+    : BamReader{bamFile}
     , d_{std::make_unique<BaiIndexedBamReaderPrivate>(std::move(bamFile), index)}
 {}
 
@@ -111,13 +159,13 @@ BaiIndexedBamReader::BaiIndexedBamReader(const Data::GenomicInterval& interval,
 {}
 
 BaiIndexedBamReader::BaiIndexedBamReader(const Data::GenomicInterval& interval, BamFile bamFile)
-    : BamReader{bamFile.Filename()}
+    : BamReader{bamFile}
     , d_{std::make_unique<BaiIndexedBamReaderPrivate>(std::move(bamFile), interval, nullptr)}
 {}
 
 BaiIndexedBamReader::BaiIndexedBamReader(const Data::GenomicInterval& interval, BamFile bamFile,
                                          const std::shared_ptr<BaiIndexCacheData>& index)
-    : BamReader{bamFile.Filename()}
+    : BamReader{bamFile}
     , d_{std::make_unique<BaiIndexedBamReaderPrivate>(std::move(bamFile), interval, index)}
 {}
 
@@ -142,5 +190,13 @@ BaiIndexedBamReader& BaiIndexedBamReader::Interval(const Data::GenomicInterval&
     return *this;
 }
 
+BaiIndexedBamReader& BaiIndexedBamReader::Intervals(
+    const std::vector<Data::GenomicInterval>& intervals)
+{
+    assert(d_);
+    d_->Intervals(Header(), intervals);
+    return *this;
+}
+
 }  // namespace BAM
 }  // namespace PacBio
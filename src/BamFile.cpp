@@ -58,9 +58,17 @@ public:
         header_ = BamHeaderMemory::FromRawData(hdr.get());
     }
 
+    BamFilePrivate(std::string fn, BamHeader header, const std::int64_t firstAlignmentOffset)
+        : filename_{std::move(fn)}
+        , header_{std::move(header)}
+        , firstAlignmentOffset_{firstAlignmentOffset}
+    {}
+
     std::unique_ptr<BamFilePrivate> DeepCopy()
     {
-        return std::make_unique<BamFilePrivate>(filename_);
+        // copy already-loaded data, no need to re-open & re-parse file
+        return std::make_unique<BamFilePrivate>(filename_, header_.DeepCopy(),
+                                                firstAlignmentOffset_);
     }
 
     bool HasEOF() const
@@ -104,7 +112,7 @@ public:
 
     std::string filename_;
     BamHeader header_;
-    std::int64_t firstAlignmentOffset_;
+    std::int64_t firstAlignmentOffset_ = -1;
 };
 
 BamFile::BamFile(std::string filename) : d_{std::make_unique<BamFilePrivate>(std::move(filename))}
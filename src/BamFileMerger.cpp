@@ -8,13 +8,40 @@
 #include <pbbam/BamRecord.h>
 #include <pbbam/CompositeBamReader.h>
 #include <pbbam/DataSet.h>
+#include <pbbam/Deleters.h>
 #include <pbbam/IRecordWriter.h>
 #include <pbbam/IndexedBamWriter.h>
 #include <pbbam/PbiFilter.h>
+#include <pbbam/PbiFilterTypes.h>
 #include <pbbam/PbiIndexedBamReader.h>
+#include <pbbam/PbiRawData.h>
+#include "ErrnoReason.h"
+#include "FileProducer.h"
+#include "MemoryUtils.h"
+#include "PbiIndexIO.h"
 
+#include <pbcopper/utility/Deleters.h>
+#include <pbcopper/utility/MoveAppend.h>
+
+#include <htslib/bgzf.h>
+#include <htslib/hfile.h>
+#include <htslib/hts.h>
+#include <htslib/sam.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <exception>
+#include <filesystem>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 
 namespace PacBio {
 namespace BAM {
@@ -42,8 +69,9 @@ std::unique_ptr<IRecordWriter> MakeBamWriter(BamHeader header, const std::string
 template <typename Reader>
 void MergeImpl(IRecordWriter& writer, Reader& reader)
 {
+    // records are not modified, so skip the reader's per-record setup
     BamRecord record;
-    while (reader.GetNext(record)) {
+    while (reader.GetNextRaw(record)) {
         writer.Write(record);
     }
 }
@@ -77,12 +105,780 @@ void MergeToWriter(const DataSet& dataset, IRecordWriter& writer)
     MergeToWriter(dataset, BamHeader{dataset}, writer);
 }
 
+// -----------------------------
+// region-parallel merge
+// -----------------------------
+
+// Number of shards to create per thread, so that uneven coverage still keeps
+// all threads busy.
+constexpr std::size_t ShardsPerThread = 4;
+
+// Written by bgzf_close() at the end of every BGZF file.
+constexpr std::array<std::uint8_t, 28> BgzfEofMarker{
+    0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x06, 0x00, 0x42, 0x43,
+    0x02, 0x00, 0x1b, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+struct BamFileMergerException : public std::exception
+{
+    BamFileMergerException(std::string filename, std::string reason)
+    {
+        std::ostringstream s;
+        s << "[pbbam] BAM file merging ERROR: " << reason << ":\n"
+          << "  file: " << filename;
+        MaybePrintErrnoReason(s);
+        msg_ = s.str();
+    }
+
+    const char* what() const noexcept override { return msg_.c_str(); }
+
+    std::string msg_;
+};
+
+// Removes intermediate files on scope exit, whether or not the merge succeeded.
+struct TempFileCleanup
+{
+    ~TempFileCleanup()
+    {
+        std::error_code ec;
+        for (const auto& fn : filenames) {
+            std::filesystem::remove(fn, ec);
+        }
+    }
+
+    std::vector<std::string> filenames;
+};
+
+// A reference interval [start, end) of the merged output, covering records
+// whose alignment starts within it. Merged independently into a headerless
+// BGZF segment, along with its index rows (segment-relative offsets).
+struct MergeShard
+{
+    PbiFilter filter;
+    std::string filename;
+    PbiRawData index;
+    std::uint32_t numRecords = 0;
+};
+
+std::size_t ResolveNumThreads(const std::size_t numThreads)
+{
+    if (numThreads != 0) {
+        return numThreads;
+    }
+
+    // if still unknown, default to single-threaded
+    const std::size_t actualNumThreads = std::thread::hardware_concurrency();
+    return (actualNumThreads == 0 ? 1 : actualNumThreads);
+}
+
+bool CanMergeByRegion(const BamHeader& header, const std::vector<BamFile>& bamFiles,
+                      const std::size_t numThreads)
+{
+    if (numThreads < 2 || header.SortOrder() != "coordinate") {
+        return false;
+    }
+    return std::all_of(bamFiles.cbegin(), bamFiles.cend(),
+                       [](const BamFile& f) { return f.PacBioIndexExists(); });
+}
+
+bool HasMappedIndexData(const PbiIndexCache& indexCache)
+{
+    return std::all_of(indexCache->cbegin(), indexCache->cend(),
+                       [](const std::shared_ptr<PbiRawData>& index) {
+                           return (index->NumReads() == 0) || index->HasMappedData();
+                       });
+}
+
+// Per-reference record counts, taken from each index's ReferenceData section
+// or from its tId column. The last entry holds unmapped records.
+std::vector<std::uint64_t> RecordsPerReference(const PbiIndexCache& indexCache,
+                                               const std::size_t numReferences)
+{
+    std::vector<std::uint64_t> result(numReferences + 1, 0);
+    const auto slot = [numReferences](const std::int64_t tId) -> std::size_t {
+        if (tId < 0 || static_cast<std::size_t>(tId) >= numReferences) {
+            return numReferences;
+        }
+        return static_cast<std::size_t>(tId);
+    };
+
+    for (const auto& index : *indexCache) {
+        if (index->NumReads() == 0) {
+            continue;
+        }
+        if (index->HasReferenceData()) {
+            for (const auto& entry : index->ReferenceData().entries_) {
+                if (entry.beginRow_ == PbiReferenceEntry::UNSET_ROW) {
+                    continue;
+                }
+                const std::int64_t tId = (entry.tId_ == PbiReferenceEntry::UNMAPPED_ID)
+                                             ? -1
+                                             : static_cast<std::int64_t>(entry.tId_);
+                result[slot(tId)] += (entry.endRow_ - entry.beginRow_);
+            }
+        } else {
+            for (const auto tId : index->MappedData().tId_) {
+                ++result[slot(tId)];
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<MergeShard> MakeMergeShards(const BamHeader& header, const PbiFilter& datasetFilter,
+                                        const PbiIndexCache& indexCache,
+                                        const std::size_t numThreads,
+                                        const std::string& outputFilename)
+{
+    const std::size_t numReferences = header.NumSequences();
+    const auto recordCounts = RecordsPerReference(indexCache, numReferences);
+
+    std::uint64_t totalRecords = 0;
+    for (const auto count : recordCounts) {
+        totalRecords += count;
+    }
+    const std::uint64_t recordsPerShard =
+        std::max<std::uint64_t>(1, totalRecords / (numThreads * ShardsPerThread));
+
+    std::vector<MergeShard> shards;
+    const auto addShard = [&](std::vector<PbiFilter> filters) {
+        if (!datasetFilter.IsEmpty()) {
+            filters.push_back(datasetFilter);
+        }
+        MergeShard shard;
+        shard.filter = PbiFilter::Intersection(std::move(filters));
+        shard.filename = outputFilename + ".shard." + std::to_string(shards.size());
+        shards.push_back(std::move(shard));
+    };
+
+    // Split each reference into equal-length pieces, proportional to its share
+    // of the records. Records are assigned to the piece containing their start.
+    for (std::size_t i = 0; i < numReferences; ++i) {
+        const auto count = recordCounts[i];
+        if (count == 0) {
+            continue;
+        }
+
+        const auto tId = static_cast<std::int32_t>(i);
+        const std::uint64_t refLength = std::stoull(header.SequenceLength(tId));
+        const std::uint64_t numPieces = std::max<std::uint64_t>(
+            1, std::min((count + recordsPerShard - 1) / recordsPerShard, refLength));
+        const std::uint64_t pieceLength = (refLength + numPieces - 1) / numPieces;
+
+        for (std::uint64_t piece = 0; piece < numPieces; ++piece) {
+            std::vector<PbiFilter> filters{PbiReferenceIdFilter{tId}};
+            if (piece > 0) {
+                filters.emplace_back(PbiReferenceStartFilter{
+                    static_cast<std::uint32_t>(piece * pieceLength), Compare::GREATER_THAN_EQUAL});
+            }
+            if (piece + 1 < numPieces) {
+                filters.emplace_back(PbiReferenceStartFilter{
+                    static_cast<std::uint32_t>((piece + 1) * pieceLength), Compare::LESS_THAN});
+            }
+            addShard(std::move(filters));
+        }
+    }
+
+    // unmapped records stay at the end
+    if (recordCounts[numReferences] > 0) {
+        addShard({PbiReferenceIdFilter{-1}});
+    }
+    return shards;
+}
+
+void MergeShardToSegment(MergeShard& shard, const std::vector<BamFile>& bamFiles,
+                         const PbiIndexCache& indexCache, const bool createPbi)
+{
+    PbiFilterCompositeBamReader<Compare::AlignmentPosition> reader{shard.filter, bamFiles,
+                                                                   indexCache};
+    if (reader.NumReads() == 0) {
+        return;
+    }
+
+    std::unique_ptr<BGZF, HtslibBgzfDeleter> bgzf{bgzf_open(shard.filename.c_str(), "wb")};
+    if (!bgzf) {
+        throw BamFileMergerException{shard.filename, "could not open temp file for writing"};
+    }
+    BGZF* fp = bgzf.get();
+
+    BamRecord record;
+    while (reader.GetNextRaw(record)) {
+        const auto& rawRecord = BamRecordMemory::GetRawData(record);
+
+        // min_shift=14 & n_lvls=5 are BAM "magic numbers"
+        rawRecord->core.bin = hts_reg2bin(rawRecord->core.pos, bam_endpos(rawRecord.get()), 14, 5);
+
+        // bam_write1() starts a new block if the record does not fit in the
+        // current one. Do that here, so that the virtual offset is known.
+        if (fp->block_offset + BamRecordMemory::EncodedLength(rawRecord.get()) >
+            BGZF_BLOCK_SIZE) {
+            if (bgzf_flush(fp) != 0) {
+                throw BamFileMergerException{shard.filename, "could not flush temp file"};
+            }
+        }
+
+        if (createPbi) {
+            shard.index.BasicData().AddRecord(record, bgzf_tell(fp));
+            shard.index.MappedData().AddRecord(record);
+            shard.index.BarcodeData().AddRecord(record);
+        }
+
+        if (bam_write1(fp, rawRecord.get()) < 0) {
+            throw BamFileMergerException{shard.filename, "could not write record"};
+        }
+        ++shard.numRecords;
+    }
+
+    if (bgzf_close(bgzf.release()) != 0) {
+        throw BamFileMergerException{shard.filename, "could not close temp file"};
+    }
+}
+
+void MergeShards(std::vector<MergeShard>& shards, const std::vector<BamFile>& bamFiles,
+                 const PbiIndexCache& indexCache, const bool createPbi,
+                 const std::size_t numThreads)
+{
+    std::atomic<std::size_t> nextShard{0};
+    std::vector<std::exception_ptr> errors(numThreads);
+
+    const auto worker = [&](const std::size_t threadIndex) {
+        try {
+            for (std::size_t i = nextShard++; i < shards.size(); i = nextShard++) {
+                MergeShardToSegment(shards[i], bamFiles, indexCache, createPbi);
+            }
+        } catch (...) {
+            errors[threadIndex] = std::current_exception();
+            nextShard = shards.size();  // stop other workers early
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (const auto& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+void WriteHeaderSegment(const BamHeader& header, const std::string& filename)
+{
+    std::unique_ptr<BGZF, HtslibBgzfDeleter> bgzf{bgzf_open(filename.c_str(), "wb")};
+    if (!bgzf) {
+        throw BamFileMergerException{filename, "could not open temp file for writing"};
+    }
+
+    const auto rawHeader = BamHeaderMemory::MakeRawHeader(header);
+    if (bam_hdr_write(bgzf.get(), rawHeader.get()) != 0) {
+        throw BamFileMergerException{filename, "could not write header"};
+    }
+    if (bgzf_close(bgzf.release()) != 0) {
+        throw BamFileMergerException{filename, "could not close temp file"};
+    }
+}
+
+// Returns the end of a BGZF file's data, i.e. its size minus the trailing EOF
+// marker (if present).
+std::int64_t BgzfDataEnd(const std::string& filename)
+{
+    std::unique_ptr<std::FILE, Utility::FileDeleter> in{std::fopen(filename.c_str(), "rb")};
+    if (!in) {
+        throw BamFileMergerException{filename, "could not open file for reading"};
+    }
+
+    auto numBytes = static_cast<std::int64_t>(std::filesystem::file_size(filename));
+    if (numBytes >= static_cast<std::int64_t>(BgzfEofMarker.size())) {
+        std::array<std::uint8_t, BgzfEofMarker.size()> tail;
+        std::fseek(in.get(), numBytes - static_cast<long>(tail.size()), SEEK_SET);
+        if (std::fread(tail.data(), 1, tail.size(), in.get()) == tail.size() &&
+            tail == BgzfEofMarker) {
+            numBytes -= tail.size();
+        }
+    }
+    return numBytes;
+}
+
+// Copies the raw bytes [begin, end) of a file to 'out'. Returns the number of
+// bytes written.
+std::int64_t CopyFileRange(const std::string& filename, const std::int64_t begin,
+                           const std::int64_t end, std::FILE* out,
+                           const std::string& outputFilename)
+{
+    if (end <= begin) {
+        return 0;
+    }
+
+    std::unique_ptr<std::FILE, Utility::FileDeleter> in{std::fopen(filename.c_str(), "rb")};
+    if (!in) {
+        throw BamFileMergerException{filename, "could not open file for reading"};
+    }
+    if (std::fseek(in.get(), begin, SEEK_SET) != 0) {
+        throw BamFileMergerException{filename, "could not seek in file"};
+    }
+
+    std::vector<char> buffer(0x100000);
+    std::int64_t remaining = end - begin;
+    while (remaining > 0) {
+        const auto chunkSize =
+            static_cast<std::size_t>(std::min<std::int64_t>(remaining, buffer.size()));
+        if (std::fread(buffer.data(), 1, chunkSize, in.get()) != chunkSize) {
+            throw BamFileMergerException{filename, "could not read from file"};
+        }
+        if (std::fwrite(buffer.data(), 1, chunkSize, out) != chunkSize) {
+            throw BamFileMergerException{outputFilename, "could not write merged data"};
+        }
+        remaining -= chunkSize;
+    }
+    return end - begin;
+}
+
+// Appends a complete BGZF file's compressed blocks to 'out', minus its EOF
+// marker. Returns the number of bytes written.
+std::int64_t AppendBgzfSegment(const std::string& filename, std::FILE* out,
+                               const std::string& outputFilename)
+{
+    return CopyFileRange(filename, 0, BgzfDataEnd(filename), out, outputFilename);
+}
+
+// Concatenates the per-shard indices, in output order. Virtual offsets must
+// already be shifted to their position in the final BAM.
+PbiRawData StitchShardIndices(std::vector<MergeShard>& shards, const std::size_t numReferences)
+{
+    PbiRawData result;
+    auto& basicData = result.BasicData();
+    auto& mappedData = result.MappedData();
+    auto& barcodeData = result.BarcodeData();
+
+    std::uint32_t numReads = 0;
+    for (auto& shard : shards) {
+        if (shard.numRecords == 0) {
+            continue;
+        }
+        numReads += shard.numRecords;
+
+        auto& shardBasic = shard.index.BasicData();
+        Utility::MoveAppend(std::move(shardBasic.rgId_), basicData.rgId_);
+        Utility::MoveAppend(std::move(shardBasic.qStart_), basicData.qStart_);
+        Utility::MoveAppend(std::move(shardBasic.qEnd_), basicData.qEnd_);
+        Utility::MoveAppend(std::move(shardBasic.holeNumber_), basicData.holeNumber_);
+        Utility::MoveAppend(std::move(shardBasic.readQual_), basicData.readQual_);
+        Utility::MoveAppend(std::move(shardBasic.ctxtFlag_), basicData.ctxtFlag_);
+        Utility::MoveAppend(std::move(shardBasic.fileOffset_), basicData.fileOffset_);
+        Utility::MoveAppend(std::move(shardBasic.fileNumber_), basicData.fileNumber_);
+
+        auto& shardMapped = shard.index.MappedData();
+        Utility::MoveAppend(std::move(shardMapped.tId_), mappedData.tId_);
+        Utility::MoveAppend(std::move(shardMapped.tStart_), mappedData.tStart_);
+        Utility::MoveAppend(std::move(shardMapped.tEnd_), mappedData.tEnd_);
+        Utility::MoveAppend(std::move(shardMapped.aStart_), mappedData.aStart_);
+        Utility::MoveAppend(std::move(shardMapped.aEnd_), mappedData.aEnd_);
+        Utility::MoveAppend(std::move(shardMapped.revStrand_), mappedData.revStrand_);
+        Utility::MoveAppend(std::move(shardMapped.nM_), mappedData.nM_);
+        Utility::MoveAppend(std::move(shardMapped.nMM_), mappedData.nMM_);
+        Utility::MoveAppend(std::move(shardMapped.mapQV_), mappedData.mapQV_);
+        Utility::MoveAppend(std::move(shardMapped.nInsOps_), mappedData.nInsOps_);
+        Utility::MoveAppend(std::move(shardMapped.nDelOps_), mappedData.nDelOps_);
+
+        auto& shardBarcode = shard.index.BarcodeData();
+        Utility::MoveAppend(std::move(shardBarcode.bcForward_), barcodeData.bcForward_);
+        Utility::MoveAppend(std::move(shardBarcode.bcReverse_), barcodeData.bcReverse_);
+        Utility::MoveAppend(std::move(shardBarcode.bcQual_), barcodeData.bcQual_);
+    }
+
+    // Rebuild ReferenceData over the final row numbers. Entries for all known
+    // references, plus the unmapped entry last, match PbiReferenceDataBuilder.
+    auto& entries = result.ReferenceData().entries_;
+    entries.reserve(numReferences + 1);
+    for (std::size_t i = 0; i < numReferences; ++i) {
+        entries.emplace_back(static_cast<PbiReferenceEntry::ID>(i));
+    }
+    entries.emplace_back();
+    for (std::uint32_t row = 0; row < numReads; ++row) {
+        const auto tId = mappedData.tId_[row];
+        auto& entry = (tId < 0 || static_cast<std::size_t>(tId) >= numReferences)
+                          ? entries.back()
+                          : entries[tId];
+        if (entry.beginRow_ == PbiReferenceEntry::UNSET_ROW) {
+            entry.beginRow_ = row;
+        }
+        entry.endRow_ = row + 1;
+    }
+
+    const auto isSet = [](const auto value) { return value != -1; };
+    const bool hasBarcodeData =
+        std::any_of(barcodeData.bcForward_.cbegin(), barcodeData.bcForward_.cend(), isSet) ||
+        std::any_of(barcodeData.bcReverse_.cbegin(), barcodeData.bcReverse_.cend(), isSet) ||
+        std::any_of(barcodeData.bcQual_.cbegin(), barcodeData.bcQual_.cend(), isSet);
+
+    PbiFile::Sections sections = PbiFile::BASIC | PbiFile::MAPPED | PbiFile::REFERENCE;
+    if (hasBarcodeData) {
+        sections |= PbiFile::BARCODE;
+    }
+    result.FileSections(sections);
+    result.NumReads(numReads);
+    result.Version(PbiFile::CurrentVersion);
+    return result;
+}
+
+void MergeToFileByRegion(const DataSet& dataset, const BamHeader& header,
+                         const PbiIndexCache& indexCache, const std::string& outputFilename,
+                         const bool createPbi, const std::size_t numThreads)
+{
+    TempFileCleanup tempFiles;
+
+    auto shards = MakeMergeShards(header, PbiFilter::FromDataSet(dataset), indexCache,
+                                  numThreads, outputFilename);
+    for (const auto& shard : shards) {
+        tempFiles.filenames.push_back(shard.filename);
+    }
+    const std::string headerFilename{outputFilename + ".header"};
+    tempFiles.filenames.push_back(headerFilename);
+
+    // merge reference intervals concurrently
+    const auto bamFiles = dataset.BamFiles();
+    MergeShards(shards, bamFiles, indexCache, createPbi,
+                std::min(numThreads, std::max<std::size_t>(1, shards.size())));
+
+    // concatenate header & shard segments, in genomic order
+    WriteHeaderSegment(header, headerFilename);
+    {
+        FileProducer producer{outputFilename};
+        std::unique_ptr<std::FILE, Utility::FileDeleter> out{
+            std::fopen(producer.TempFilename().c_str(), "wb")};
+        if (!out) {
+            throw BamFileMergerException{producer.TempFilename(),
+                                         "could not open file for writing"};
+        }
+
+        std::int64_t segmentStart = AppendBgzfSegment(headerFilename, out.get(), outputFilename);
+        for (auto& shard : shards) {
+            if (shard.numRecords == 0) {
+                continue;
+            }
+            for (auto& offset : shard.index.BasicData().fileOffset_) {
+                offset += (segmentStart << 16);
+            }
+            segmentStart += AppendBgzfSegment(shard.filename, out.get(), outputFilename);
+
+            std::error_code ec;
+            std::filesystem::remove(shard.filename, ec);
+        }
+
+        if (std::fwrite(BgzfEofMarker.data(), 1, BgzfEofMarker.size(), out.get()) !=
+                BgzfEofMarker.size() ||
+            std::fclose(out.release()) != 0) {
+            throw BamFileMergerException{producer.TempFilename(), "could not write merged data"};
+        }
+    }
+
+    if (createPbi) {
+        const auto index = StitchShardIndices(shards, header.NumSequences());
+        PbiIndexIO::Save(index, outputFilename + ".pbi");
+    }
+}
+
+// -----------------------------
+// BGZF block-copy concatenation
+// -----------------------------
+
+// Describes where an input's records landed in the concatenated output.
+//
+// Records sharing the input's first data block with the end of its header are
+// recompressed into a small segment (starting at 'partialStart', one block per
+// BGZF_BLOCK_SIZE bytes). All following blocks are copied verbatim, starting
+// at 'copiedStart'.
+struct ConcatSegment
+{
+    std::int64_t firstRecordOffset = 0;  // virtual offset, in input
+    std::int64_t copyBegin = 0;          // raw offset, in input
+    std::int64_t partialStart = 0;       // raw offset, in output
+    std::vector<std::int64_t> partialBlockStarts;
+    std::int64_t copiedStart = 0;  // raw offset, in output
+};
+
+bool CanConcatenate(const DataSet& dataset, const BamHeader& header,
+                    const std::vector<BamFile>& bamFiles)
+{
+    if (header.SortOrder() == "coordinate" || !PbiFilter::FromDataSet(dataset).IsEmpty()) {
+        return false;
+    }
+
+    // Records are copied as-is, so their reference IDs must mean the same
+    // thing in the merged header.
+    const auto sequenceNames = header.SequenceNames();
+    return std::all_of(bamFiles.cbegin(), bamFiles.cend(), [&](const BamFile& f) {
+        return f.Header().SequenceNames() == sequenceNames;
+    });
+}
+
+// Input indices must agree on MappedData, which cannot be synthesized from
+// the PBI alone. Missing BarcodeData is filled in as 'no barcode'.
+bool HasConsistentIndexSections(const PbiIndexCache& indexCache)
+{
+    const auto hasMapped = [](const std::shared_ptr<PbiRawData>& index) {
+        return index->HasMappedData();
+    };
+    return std::all_of(indexCache->cbegin(), indexCache->cend(), hasMapped) ||
+           std::none_of(indexCache->cbegin(), indexCache->cend(), hasMapped);
+}
+
+// Recompresses the remainder of the input's first data block (after the end
+// of its header), if any, & appends it to 'out'. Returns the number of bytes
+// written.
+std::int64_t AppendPartialBlock(const std::string& filename, ConcatSegment& segment,
+                                const std::string& tempFilename, std::FILE* out,
+                                const std::string& outputFilename)
+{
+    const std::int64_t blockAddress = (segment.firstRecordOffset >> 16);
+    const int blockOffset = static_cast<int>(segment.firstRecordOffset & 0xFFFF);
+    segment.copyBegin = blockAddress;
+    if (blockOffset == 0) {
+        return 0;
+    }
+
+    std::unique_ptr<BGZF, HtslibBgzfDeleter> in{bgzf_open(filename.c_str(), "r")};
+    if (!in || bgzf_seek(in.get(), blockAddress << 16, SEEK_SET) != 0 ||
+        bgzf_read_block(in.get()) != 0) {
+        throw BamFileMergerException{filename, "could not read first data block"};
+    }
+    segment.copyBegin = htell(in->fp);
+
+    const auto* data = static_cast<const std::uint8_t*>(in->uncompressed_block);
+    const int dataLength = in->block_length;
+    if (blockOffset >= dataLength) {
+        return 0;
+    }
+
+    std::unique_ptr<BGZF, HtslibBgzfDeleter> partial{bgzf_open(tempFilename.c_str(), "wb")};
+    if (!partial) {
+        throw BamFileMergerException{tempFilename, "could not open temp file for writing"};
+    }
+    for (int pos = blockOffset; pos < dataLength; pos += BGZF_BLOCK_SIZE) {
+        segment.partialBlockStarts.push_back(bgzf_tell(partial.get()) >> 16);
+        const int chunkSize = std::min(dataLength - pos, BGZF_BLOCK_SIZE);
+        if (bgzf_write(partial.get(), data + pos, chunkSize) != chunkSize ||
+            bgzf_flush(partial.get()) != 0) {
+            throw BamFileMergerException{tempFilename, "could not write temp file"};
+        }
+    }
+    if (bgzf_close(partial.release()) != 0) {
+        throw BamFileMergerException{tempFilename, "could not close temp file"};
+    }
+    return AppendBgzfSegment(tempFilename, out, outputFilename);
+}
+
+// Maps an input record's virtual offset to its position in the output.
+std::int64_t ShiftVirtualOffset(const std::int64_t vOffset, const ConcatSegment& segment)
+{
+    const std::int64_t blockAddress = (vOffset >> 16);
+    const std::int64_t blockOffset = (vOffset & 0xFFFF);
+
+    if (blockAddress < segment.copyBegin) {
+        // within recompressed first block
+        const std::int64_t firstOffset = (segment.firstRecordOffset & 0xFFFF);
+        const std::int64_t pos = blockOffset - firstOffset;
+        const auto block = static_cast<std::size_t>(pos / BGZF_BLOCK_SIZE);
+        return ((segment.partialStart + segment.partialBlockStarts.at(block)) << 16) |
+               (pos % BGZF_BLOCK_SIZE);
+    }
+    return ((blockAddress - segment.copyBegin + segment.copiedStart) << 16) | blockOffset;
+}
+
+template <typename T>
+void AppendColumn(const std::vector<T>& input, std::vector<T>& output)
+{
+    output.insert(output.end(), input.cbegin(), input.cend());
+}
+
+PbiRawData ConcatenateIndices(const PbiIndexCache& indexCache,
+                              const std::vector<ConcatSegment>& segments)
+{
+    PbiRawData result;
+    auto& basicData = result.BasicData();
+    auto& mappedData = result.MappedData();
+    auto& barcodeData = result.BarcodeData();
+
+    const bool hasMappedData = !indexCache->empty() && indexCache->front()->HasMappedData();
+    bool hasBarcodeData = false;
+    std::uint32_t numReads = 0;
+
+    for (std::size_t i = 0; i < indexCache->size(); ++i) {
+        const auto& index = *indexCache->at(i);
+        const auto& segment = segments.at(i);
+        const auto n = index.NumReads();
+        numReads += n;
+
+        const auto& inBasic = index.BasicData();
+        AppendColumn(inBasic.rgId_, basicData.rgId_);
+        AppendColumn(inBasic.qStart_, basicData.qStart_);
+        AppendColumn(inBasic.qEnd_, basicData.qEnd_);
+        AppendColumn(inBasic.holeNumber_, basicData.holeNumber_);
+        AppendColumn(inBasic.readQual_, basicData.readQual_);
+        AppendColumn(inBasic.ctxtFlag_, basicData.ctxtFlag_);
+        for (const auto offset : inBasic.fileOffset_) {
+            basicData.fileOffset_.push_back(ShiftVirtualOffset(offset, segment));
+        }
+        basicData.fileNumber_.insert(basicData.fileNumber_.end(), n, 0);
+
+        if (hasMappedData) {
+            const auto& inMapped = index.MappedData();
+            AppendColumn(inMapped.tId_, mappedData.tId_);
+            AppendColumn(inMapped.tStart_, mappedData.tStart_);
+            AppendColumn(inMapped.tEnd_, mappedData.tEnd_);
+            AppendColumn(inMapped.aStart_, mappedData.aStart_);
+            AppendColumn(inMapped.aEnd_, mappedData.aEnd_);
+            AppendColumn(inMapped.revStrand_, mappedData.revStrand_);
+            AppendColumn(inMapped.nM_, mappedData.nM_);
+            AppendColumn(inMapped.nMM_, mappedData.nMM_);
+            AppendColumn(inMapped.mapQV_, mappedData.mapQV_);
+            AppendColumn(inMapped.nInsOps_, mappedData.nInsOps_);
+            AppendColumn(inMapped.nDelOps_, mappedData.nDelOps_);
+        }
+
+        if (index.HasBarcodeData()) {
+            hasBarcodeData = true;
+            const auto& inBarcode = index.BarcodeData();
+            AppendColumn(inBarcode.bcForward_, barcodeData.bcForward_);
+            AppendColumn(inBarcode.bcReverse_, barcodeData.bcReverse_);
+            AppendColumn(inBarcode.bcQual_, barcodeData.bcQual_);
+        } else {
+            barcodeData.bcForward_.insert(barcodeData.bcForward_.end(), n, -1);
+            barcodeData.bcReverse_.insert(barcodeData.bcReverse_.end(), n, -1);
+            barcodeData.bcQual_.insert(barcodeData.bcQual_.end(), n, -1);
+        }
+    }
+
+    PbiFile::Sections sections = PbiFile::BASIC;
+    if (hasMappedData) {
+        sections |= PbiFile::MAPPED;
+    }
+    if (hasBarcodeData) {
+        sections |= PbiFile::BARCODE;
+    }
+    result.FileSections(sections);
+    result.NumReads(numReads);
+    result.Version(PbiFile::CurrentVersion);
+    return result;
+}
+
+void ConcatenateToFile(const BamHeader& header, const std::vector<BamFile>& bamFiles,
+                       const PbiIndexCache& indexCache, const std::string& outputFilename,
+                       const bool createPbi)
+{
+    TempFileCleanup tempFiles;
+    const std::string headerFilename{outputFilename + ".header"};
+    const std::string partialFilename{outputFilename + ".partial"};
+    tempFiles.filenames = {headerFilename, partialFilename};
+
+    std::vector<ConcatSegment> segments(bamFiles.size());
+    WriteHeaderSegment(header, headerFilename);
+    {
+        FileProducer producer{outputFilename};
+        std::unique_ptr<std::FILE, Utility::FileDeleter> out{
+            std::fopen(producer.TempFilename().c_str(), "wb")};
+        if (!out) {
+            throw BamFileMergerException{producer.TempFilename(),
+                                         "could not open file for writing"};
+        }
+
+        std::int64_t outputPos = AppendBgzfSegment(headerFilename, out.get(), outputFilename);
+        for (std::size_t i = 0; i < bamFiles.size(); ++i) {
+            const auto& inputFilename = bamFiles.at(i).Filename();
+            auto& segment = segments.at(i);
+
+            // virtual offset of first record, just past the input's header
+            segment.firstRecordOffset = BamReader{inputFilename}.VirtualTell();
+
+            segment.partialStart = outputPos;
+            outputPos += AppendPartialBlock(inputFilename, segment, partialFilename, out.get(),
+                                            outputFilename);
+
+            segment.copiedStart = outputPos;
+            outputPos += CopyFileRange(inputFilename, segment.copyBegin, BgzfDataEnd(inputFilename),
+                                       out.get(), outputFilename);
+        }
+
+        if (std::fwrite(BgzfEofMarker.data(), 1, BgzfEofMarker.size(), out.get()) !=
+                BgzfEofMarker.size() ||
+            std::fclose(out.release()) != 0) {
+            throw BamFileMergerException{producer.TempFilename(), "could not write merged data"};
+        }
+    }
+
+    if (createPbi) {
+        const auto index = ConcatenateIndices(indexCache, segments);
+        PbiIndexIO::Save(index, outputFilename + ".pbi");
+    }
+}
+
+void MergeToFile(const DataSet& dataset, const std::string& outputFilename,
+                 const BamFileMerger::Config& config)
+{
+    BamHeader header{dataset};
+    const auto numThreads = ResolveNumThreads(config.numThreads);
+
+    // block-copy concatenation, if requested & possible
+    if (config.concatenate && outputFilename != "-") {
+        const auto bamFiles = dataset.BamFiles();
+        if (CanConcatenate(dataset, header, bamFiles)) {
+            const bool haveInputIndices =
+                std::all_of(bamFiles.cbegin(), bamFiles.cend(),
+                            [](const BamFile& f) { return f.PacBioIndexExists(); });
+            if (!config.createPbi || haveInputIndices) {
+                PbiIndexCache indexCache;
+                if (config.createPbi) {
+                    indexCache = MakePbiIndexCache(bamFiles);
+                }
+                if (!config.createPbi || HasConsistentIndexSections(indexCache)) {
+                    // Inputs are appended in the order given, so any input sort
+                    // order (e.g. queryname) no longer holds for the output. No
+                    // @HD:SS is carried over, as BamHeader does not keep it.
+                    header.SortOrder("unknown");
+                    if (config.pgInfo.IsValid()) {
+                        header.AddProgram(config.pgInfo);
+                    }
+                    ConcatenateToFile(header, bamFiles, indexCache, outputFilename,
+                                      config.createPbi);
+                    return;
+                }
+            }
+        }
+    }
+
+    // region-parallel merge, if possible
+    if (outputFilename != "-") {
+        const auto bamFiles = dataset.BamFiles();
+        if (CanMergeByRegion(header, bamFiles, numThreads)) {
+            const auto indexCache = MakePbiIndexCache(bamFiles);
+            if (HasMappedIndexData(indexCache)) {
+                if (config.pgInfo.IsValid()) {
+                    header.AddProgram(config.pgInfo);
+                }
+                MergeToFileByRegion(dataset, header, indexCache, outputFilename,
+                                    config.createPbi, numThreads);
+                return;
+            }
+        }
+    }
+
+    // otherwise, single-threaded merge
+    auto writer = MakeBamWriter(header, outputFilename, config.createPbi, config.pgInfo);
+    MergeToWriter(dataset, header, *writer);
+}
+
 void MergeToFile(const DataSet& dataset, const std::string& outputFilename, bool createPbi,
                  const ProgramInfo& pgInfo)
 {
-    const BamHeader header{dataset};
-    auto writer = MakeBamWriter(header, outputFilename, createPbi, pgInfo);
-    MergeToWriter(dataset, header, *writer);
+    BamFileMerger::Config config;
+    config.createPbi = createPbi;
+    config.pgInfo = pgInfo;
+    MergeToFile(dataset, outputFilename, config);
 }
 
 }  // namespace
@@ -93,6 +889,12 @@ void BamFileMerger::Merge(const DataSet& dataset, const std::string& outputFilen
     MergeToFile(dataset, outputFilename, createPbi, pgInfo);
 }
 
+void BamFileMerger::Merge(const DataSet& dataset, const std::string& outputFilename,
+                          const Config& config)
+{
+    MergeToFile(dataset, outputFilename, config);
+}
+
 void BamFileMerger::Merge(const std::vector<std::string>& bamFilenames,
                           const std::string& outputFilename, bool createPbi,
                           const ProgramInfo& pgInfo)
@@ -6,13 +6,20 @@
 #include <pbbam/DataSet.h>
 #include <pbbam/SamTagCodec.h>
 #include <pbbam/StringUtilities.h>
+#include "FrameCodecTable.h"
+#include "MemoryUtils.h"
 #include "Version.h"
 
 #include <htslib/hts.h>
 
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <type_traits>
 
 #include <cassert>
@@ -35,6 +42,26 @@ const std::string BamHeaderTokenpb{"pb"};
 
 const std::string CurrentSamFormatVersion{"1.6"};
 
+// Identifies a header's set of resolved frame codecs, unique across all
+// headers (and changes to their read groups).
+std::uint64_t NextFrameCodecsGeneration()
+{
+    static std::atomic<std::uint64_t> generation{0};
+    return generation.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+// Frame codecs last resolved on this thread. Records typically arrive in long
+// runs from one read group, so most lookups stop here, without touching the
+// header's shared state.
+struct LastFrameCodecs
+{
+    std::uint64_t generation = 0;
+    std::string readGroupId;
+    FrameCodecTables codecs{nullptr, nullptr};
+};
+
+thread_local LastFrameCodecs LastResolvedFrameCodecs;
+
 bool CheckSortOrder(const std::string& lhs, const std::string& rhs) { return lhs == rhs; }
 
 bool CheckPbVersion(const std::string& lhs, const std::string& rhs)
@@ -123,6 +150,19 @@ public:
     std::map<std::string, std::int32_t> sequenceIdLookup_;
 
     std::set<std::string> uniqueProgramIds_;
+
+    // read group id => frame codec tables, resolved on first use
+    std::shared_mutex frameCodecsMutex_;
+    std::map<std::string, FrameCodecTables, std::less<>> frameCodecs_;
+    std::atomic<std::uint64_t> frameCodecsGeneration_{NextFrameCodecsGeneration()};
+
+    void ClearFrameCodecs()
+    {
+        const std::unique_lock<std::shared_mutex> lock{frameCodecsMutex_};
+        frameCodecs_.clear();
+        frameCodecsGeneration_.store(NextFrameCodecsGeneration(), std::memory_order_release);
+    }
+
     void AddProgram(ProgramInfo pg, const AddProgramMode mode)
     {
         const std::string originalPgId = pg.Id();
@@ -266,6 +306,7 @@ BamHeader& BamHeader::AddReadGroup(ReadGroupInfo readGroup)
     const auto id = readGroup.Id();
     if (!HasReadGroup(id)) {
         d_->readGroups_[id] = std::move(readGroup);
+        d_->ClearFrameCodecs();
     }
     return *this;
 }
@@ -295,6 +336,7 @@ BamHeader& BamHeader::ClearPrograms()
 BamHeader& BamHeader::ClearReadGroups()
 {
     d_->readGroups_.clear();
+    d_->ClearFrameCodecs();
     return *this;
 }
 
@@ -451,6 +493,7 @@ std::vector<ReadGroupInfo> BamHeader::ReadGroups() const
 BamHeader& BamHeader::ReadGroups(std::vector<ReadGroupInfo> readGroups)
 {
     d_->readGroups_.clear();
+    d_->ClearFrameCodecs();
     for (auto&& rg : readGroups) {
         AddReadGroup(std::move(rg));
     }
@@ -561,5 +604,45 @@ BamHeader& BamHeader::Version(std::string version)
     return *this;
 }
 
+FrameCodecTables BamHeaderMemory::FrameCodecs(const BamHeader& header,
+                                              const std::string_view readGroupId)
+{
+    auto& d = *header.d_;
+    const std::uint64_t generation = d.frameCodecsGeneration_.load(std::memory_order_acquire);
+    auto& last = LastResolvedFrameCodecs;
+    if (last.generation == generation && last.readGroupId == readGroupId) {
+        return last.codecs;
+    }
+
+    const auto remember = [&](const FrameCodecTables& codecs) {
+        last.generation = generation;
+        last.readGroupId.assign(readGroupId);
+        last.codecs = codecs;
+        return codecs;
+    };
+
+    {
+        const std::shared_lock<std::shared_mutex> lock{d.frameCodecsMutex_};
+        const auto found = d.frameCodecs_.find(readGroupId);
+        if (found != d.frameCodecs_.cend()) {
+            return remember(found->second);
+        }
+    }
+
+    std::string id{readGroupId};
+    FrameCodecTables codecs{&FrameCodecTable::V1(), &FrameCodecTable::V1()};
+    try {
+        const ReadGroupInfo rg = header.ReadGroup(id);
+        codecs.ipd = &FrameCodecTable::For(rg.IpdFrameEncoder());
+        codecs.pulseWidth = &FrameCodecTable::For(rg.PulseWidthFrameEncoder());
+    } catch (const std::exception&) {
+        // fallback to V1 in corner cases w/ read group missing from header
+    }
+
+    const std::unique_lock<std::shared_mutex> lock{d.frameCodecsMutex_};
+    d.frameCodecs_.try_emplace(std::move(id), codecs);
+    return remember(codecs);
+}
+
 }  // namespace BAM
 }  // namespace PacBio
@@ -47,7 +47,8 @@ struct SamFileHandle
 class BamReader::BamReaderPrivate
 {
 public:
-    explicit BamReaderPrivate(std::string fn) : filename_{std::move(fn)}
+    explicit BamReaderPrivate(std::string fn, std::optional<BamHeader> knownHeader = std::nullopt)
+        : filename_{std::move(fn)}
     {
         auto displayFilename = [&]() {
             if (filename_ == "-") {
@@ -100,7 +101,12 @@ public:
             throw std::runtime_error{s.str()};
         }
 
-        header_ = BamHeaderMemory::FromRawData(hdr.get());
+        // re-use already-parsed header, if available
+        if (knownHeader) {
+            header_ = std::move(*knownHeader);
+        } else {
+            header_ = BamHeaderMemory::FromRawData(hdr.get());
+        }
     }
 
     std::string filename_;
@@ -114,7 +120,10 @@ BamReader::BamReader(std::string fn)
     : internal::IQuery{}, d_{std::make_unique<BamReaderPrivate>(std::move(fn))}
 {}
 
-BamReader::BamReader(BamFile bamFile) : BamReader{bamFile.Filename()} {}
+BamReader::BamReader(BamFile bamFile)
+    : internal::IQuery{}
+    , d_{std::make_unique<BamReaderPrivate>(bamFile.Filename(), bamFile.Header().DeepCopy())}
+{}
 
 BamReader::BamReader(BamReader&&) noexcept = default;
 
@@ -129,6 +138,30 @@ const std::string& BamReader::Filename() const { return d_->filename_; }
 const BamHeader& BamReader::Header() const { return d_->header_; }
 
 bool BamReader::GetNext(BamRecord& record)
+{
+    if (!ReadNext(record)) {
+        return false;
+    }
+
+    BamRecordMemory::UpdateRecordTags(record);
+#if PBBAM_AUTOVALIDATE
+    Validator::Validate(record);
+#endif
+    return true;
+}
+
+bool BamReader::GetNextRaw(BamRecord& record)
+{
+    if (!ReadNext(record)) {
+        return false;
+    }
+
+    // tag offsets will be computed on first access, if ever
+    BamRecordMemory::ClearRecordTags(record);
+    return true;
+}
+
+bool BamReader::ReadNext(BamRecord& record)
 {
     assert(BamRecordMemory::GetRawData(record).get());
 
@@ -136,13 +169,8 @@ bool BamReader::GetNext(BamRecord& record)
 
     // success
     if (result >= 0) {
-        BamRecordMemory::UpdateRecordTags(record);
-        record.header_ = d_->header_;
+        BamHeaderMemory::Share(d_->header_, record.header_);
         record.ResetCachedPositions();
-
-#if PBBAM_AUTOVALIDATE
-        Validator::Validate(record);
-#endif
         return true;
     }
 
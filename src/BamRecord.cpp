@@ -8,15 +8,15 @@
 #include <pbbam/virtual/VirtualRegionTypeMap.h>
 
 #include "BamRecordTags.h"
+#include "FrameCodecTable.h"
 #include "MemoryUtils.h"
 #include "Pulse2BaseCache.h"
+#include "RecordNameParser.h"
 #include "SequenceUtils.h"
 
 #include <pbcopper/data/Clipping.h>
-#include <pbcopper/data/FrameEncoders.h>
 #include <pbcopper/data/Position.h>
 #include <pbcopper/data/internal/ClippingImpl.h>
-#include <pbcopper/utility/Ssize.h>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/numeric/conversion/cast.hpp>
@@ -26,8 +26,10 @@
 #include <algorithm>
 #include <iterator>
 #include <numeric>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -35,52 +37,23 @@
 #include <cctype>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 namespace PacBio {
 namespace BAM {
 namespace {
 
-int32_t HoleNumberFromName(const std::string& fullName)
+int32_t HoleNumberFromName(const RecordNameParts& name)
 {
-    const auto mainTokens = Split(fullName, '/');
-    if (mainTokens.size() < 2) {
-        throw std::runtime_error{"[pbbam] BAM record ERROR: malformed record name: " + fullName};
-    }
-
-    try {
-        return std::stoi(mainTokens.at(1));
-    } catch (const std::exception&) {
+    if (!name.holeNumber) {
+        if (name.holeNumberText.empty()) {
+            throw std::runtime_error{"[pbbam] BAM record ERROR: malformed record name: " +
+                                     std::string{name.name}};
+        }
         throw std::runtime_error{"[pbbam] BAM record ERROR: invalid hole number: '" +
-                                 mainTokens.at(1) + "'"};
-    }
-}
-
-std::pair<Data::Position, Data::Position> QueryIntervalFromName(const std::string& fullName)
-{
-    const auto mainTokens = Split(fullName, '/');
-    if (Utility::Ssize(mainTokens) < 3) {
-        throw std::runtime_error{"[pbbam] BAM record ERROR: malformed record name: " + fullName};
+                                 std::string{name.holeNumberText} + "'"};
     }
-
-    const auto queryTokens = Split(mainTokens.back(), '_');
-    if (queryTokens.size() != 2) {
-        throw std::runtime_error{"[pbbam] BAM record ERROR: malformed record name: " + fullName};
-    }
-
-    return {
-        std::stoi(queryTokens.at(0)),
-        std::stoi(queryTokens.at(1)),
-    };
-}
-
-Data::Position QueryEndFromName(const std::string& fullName)
-{
-    return QueryIntervalFromName(fullName).second;
-}
-
-Data::Position QueryStartFromName(const std::string& fullName)
-{
-    return QueryIntervalFromName(fullName).first;
+    return *name.holeNumber;
 }
 
 std::string Label(const BamRecordTag tag) { return BamRecordTags::LabelFor(tag); }
@@ -165,21 +138,9 @@ T ClipPulse(const T& input, Pulse2BaseCache* p2bCache, const std::size_t pos, co
         return {};
     }
 
-    // find start
-    std::size_t start = p2bCache->FindFirst();
-    std::size_t basesSeen = 0;
-    while (basesSeen < pos) {
-        start = p2bCache->FindNext(start);
-        ++basesSeen;
-    }
-
-    // find end
-    std::size_t end = start;
-    std::size_t seen = 1;
-    while (seen < len) {
-        end = p2bCache->FindNext(end);
-        ++seen;
-    }
+    // pulse positions of first & last clipped basecalls
+    const std::size_t start = p2bCache->Select(pos);
+    const std::size_t end = (len > 1) ? p2bCache->Select(pos + len - 1) : start;
 
     // return clipped
     return {input.cbegin() + start, input.cbegin() + end + 1};
@@ -316,24 +277,14 @@ void ClipAndGapifyUInt8s(const BamRecordImpl& impl, const bool aligned, const bo
                                                            0);
 }
 
-Data::FrameEncoder IpdEncoder(const BamRecord& record)
+const FrameCodecTable& IpdCodecTable(const BamRecord& record)
 {
-    try {
-        return record.ReadGroup().IpdFrameEncoder();
-    } catch (const std::exception&) {
-        // fallback to V1 in corner cases w/ no read group set
-        return Data::V1FrameEncoder{};
-    }
+    return *ReadGroupFrameCodecs(record).ipd;
 }
 
-Data::FrameEncoder PwEncoder(const BamRecord& record)
+const FrameCodecTable& PwCodecTable(const BamRecord& record)
 {
-    try {
-        return record.ReadGroup().PulseWidthFrameEncoder();
-    } catch (const std::exception&) {
-        // fallback to V1 in corner cases w/ no read group set
-        return Data::V1FrameEncoder{};
-    }
+    return *ReadGroupFrameCodecs(record).pulseWidth;
 }
 
 void OrientBasesAsRequested(std::string* bases, Data::Orientation current,
@@ -374,6 +325,9 @@ BamRecord::BamRecord(const BamRecord& other)
     , header_{other.header_}
     , alignedStart_{other.alignedStart_}
     , alignedEnd_{other.alignedEnd_}
+    , cigarStats_{other.cigarStats_}
+    , cigarStatsCached_{other.cigarStatsCached_}
+    , cachedEditStamp_{other.cachedEditStamp_}
 {}
 
 BamRecord::BamRecord(BamRecord&&) noexcept = default;
@@ -385,6 +339,9 @@ BamRecord& BamRecord::operator=(const BamRecord& other)
         header_ = other.header_;
         alignedStart_ = other.alignedStart_;
         alignedEnd_ = other.alignedEnd_;
+        cigarStats_ = other.cigarStats_;
+        cigarStatsCached_ = other.cigarStatsCached_;
+        cachedEditStamp_ = other.cachedEditStamp_;
         p2bCache_.reset();  // just reset, for now at least
     }
     return *this;
@@ -396,6 +353,7 @@ BamRecord::~BamRecord() = default;
 
 Data::Position BamRecord::AlignedEnd() const
 {
+    ResetStaleCachedData();
     if (alignedEnd_ == Data::UNMAPPED_POSITION) {
         CalculateAlignedPositions();
     }
@@ -404,6 +362,7 @@ Data::Position BamRecord::AlignedEnd() const
 
 Data::Position BamRecord::AlignedStart() const
 {
+    ResetStaleCachedData();
     if (alignedStart_ == Data::UNMAPPED_POSITION) {
         CalculateAlignedPositions();
     }
@@ -503,7 +462,8 @@ BamRecord& BamRecord::Barcodes(const std::pair<std::int16_t, std::int16_t>& barc
 void BamRecord::CalculateAlignedPositions() const
 {
     // reset
-    ResetCachedPositions();
+    alignedStart_ = Data::UNMAPPED_POSITION;
+    alignedEnd_ = Data::UNMAPPED_POSITION;
 
     // skip if unmapped, or has no queryStart/End
     if (!impl_.IsMapped()) {
@@ -521,9 +481,9 @@ void BamRecord::CalculateAlignedPositions() const
     }
 
     // determine clipped end ranges
-    const auto alignedOffsets = AlignedOffsets(*this, seqLength);
-    const auto startOffset = alignedOffsets.first;
-    const auto endOffset = alignedOffsets.second;
+    const auto& stats = CigarStatistics();
+    const auto startOffset = stats.alignedStartOffset;
+    const auto endOffset = stats.alignedEndOffset;
     if (endOffset == -1 || startOffset == -1) {
         return;  // TODO: handle error more??
     }
@@ -538,8 +498,54 @@ void BamRecord::CalculateAlignedPositions() const
     }
 }
 
+void BamRecord::CalculateCigarStats() const
+{
+    CigarStats stats;
+
+    const auto& b = BamRecordMemory::GetRawData(impl_);
+    const std::uint32_t* cigarData = bam_get_cigar(b.get());
+    for (std::uint32_t i = 0; i < b->core.n_cigar; ++i) {
+        const std::size_t length = bam_cigar_oplen(cigarData[i]);
+        switch (static_cast<Data::CigarOperationType>(bam_cigar_op(cigarData[i]))) {
+            case Data::CigarOperationType::SEQUENCE_MATCH:
+                stats.numMatches += length;
+                stats.referenceSpan += length;
+                break;
+            case Data::CigarOperationType::SEQUENCE_MISMATCH:
+                stats.numMismatches += length;
+                stats.referenceSpan += length;
+                break;
+            case Data::CigarOperationType::INSERTION:
+                stats.numInsertedBases += length;
+                ++stats.numInsertionOperations;
+                break;
+            case Data::CigarOperationType::DELETION:
+                stats.numDeletedBases += length;
+                ++stats.numDeletionOperations;
+                stats.referenceSpan += length;
+                break;
+            case Data::CigarOperationType::ALIGNMENT_MATCH:
+            case Data::CigarOperationType::REFERENCE_SKIP:
+                stats.referenceSpan += length;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // only visits clipping ops at either end
+    const auto alignedOffsets = AlignedOffsets(*this, static_cast<int>(impl_.SequenceLength()));
+    stats.alignedStartOffset = alignedOffsets.first;
+    stats.alignedEndOffset = alignedOffsets.second;
+
+    cigarStats_ = stats;
+    cigarStatsCached_ = true;
+}
+
 void BamRecord::CalculatePulse2BaseCache() const
 {
+    ResetStaleCachedData();
+
     // skip already calculated
     if (p2bCache_) {
         return;
@@ -550,9 +556,27 @@ void BamRecord::CalculatePulse2BaseCache() const
         throw std::runtime_error{
             "[pbbam] BAM record ERROR: cannot calculate pulse2base mapping without 'pc' tag."};
     }
-    const auto pulseCalls = FetchBases(BamRecordTag::PULSE_CALL, Data::Orientation::NATIVE, false,
-                                       false, PulseBehavior::ALL);
-    p2bCache_ = std::make_unique<Pulse2BaseCache>(pulseCalls);
+
+    // build directly from raw 'pc' data, skipping the tag copy
+    const auto& b = BamRecordMemory::GetRawData(impl_);
+    const std::string label = BamRecordTags::LabelFor(BamRecordTag::PULSE_CALL);
+    const std::uint8_t* data = bam_aux_get(b.get(), label.c_str());
+    if (data == nullptr || *data != 'Z') {
+        throw std::runtime_error{
+            "[pbbam] BAM record ERROR: cannot calculate pulse2base mapping from malformed 'pc' "
+            "tag."};
+    }
+    const char* pulseCalls = reinterpret_cast<const char*>(data + 1);
+    p2bCache_ = std::make_unique<Pulse2BaseCache>(std::string_view{pulseCalls});
+}
+
+const BamRecord::CigarStats& BamRecord::CigarStatistics() const
+{
+    ResetStaleCachedData();
+    if (!cigarStatsCached_) {
+        CalculateCigarStats();
+    }
+    return cigarStats_;
 }
 
 Data::Cigar BamRecord::CigarData(bool exciseAllClips) const
@@ -626,9 +650,31 @@ void BamRecord::ClipTags(const std::size_t clipFrom, const std::size_t clipLengt
     ClipSeqTag(BamRecordTag::DELETION_TAG);
     ClipSeqTag(BamRecordTag::SUBSTITUTION_TAG);
 
+    // Lossy codes are clipped as-is when the read group's codec reproduces
+    // them, skipping the decode & re-encode.
+    const auto StoredCodes = [&](const BamRecordTag tag, const Data::FrameCodec codec,
+                                 const FrameCodecTable& table)
+        -> std::optional<std::vector<std::uint8_t>> {
+        if (codec == Data::FrameCodec::RAW || !table.PreservesCodes()) {
+            return std::nullopt;
+        }
+        const auto frameTag = impl_.TagValue(tag);
+        if (!frameTag.IsUInt8Array()) {
+            return std::nullopt;
+        }
+        return frameTag.ToUInt8Array();
+    };
+
     const auto ClipKineticsTag = [&](const BamRecordTag tag, const Data::FrameCodec codec,
-                                     const Data::FrameEncoder& encoder) {
+                                     const FrameCodecTable& table) {
         if (impl_.HasTag(tag)) {
+            if (const auto codes = StoredCodes(tag, codec, table)) {
+                if (!codes->empty()) {
+                    tags[Label(tag)] = ClipSeqQV(*codes, clipFrom, clipLength);
+                }
+                return;
+            }
+
             const auto frames = FetchFrames(tag).Data();
             if (frames.empty()) {
                 return;
@@ -637,13 +683,23 @@ void BamRecord::ClipTags(const std::size_t clipFrom, const std::size_t clipLengt
             if (codec == Data::FrameCodec::RAW) {
                 tags[Label(tag)] = ClipSeqQV(frames, clipFrom, clipLength);
             } else {
-                tags[Label(tag)] = ClipSeqQV(encoder.Encode(frames), clipFrom, clipLength);
+                tags[Label(tag)] = ClipSeqQV(table.Encode(frames), clipFrom, clipLength);
             }
         }
     };
     const auto ClipReverseKineticsTag = [&](const BamRecordTag tag, const Data::FrameCodec codec,
-                                            const Data::FrameEncoder& encoder) {
+                                            const FrameCodecTable& table) {
         if (impl_.HasTag(tag)) {
+            if (const auto codes = StoredCodes(tag, codec, table)) {
+                if (!codes->empty()) {
+                    const std::size_t originalClipEnd = clipFrom + clipLength;
+                    assert(originalClipEnd <= codes->size());
+                    tags[Label(tag)] =
+                        ClipSeqQV(*codes, codes->size() - originalClipEnd, clipLength);
+                }
+                return;
+            }
+
             const auto frames = FetchFrames(tag).Data();
             if (frames.empty()) {
                 return;
@@ -655,21 +711,22 @@ void BamRecord::ClipTags(const std::size_t clipFrom, const std::size_t clipLengt
             if (codec == Data::FrameCodec::RAW) {
                 tags[Label(tag)] = ClipSeqQV(frames, reverseClipFrom, clipLength);
             } else {
-                tags[Label(tag)] = ClipSeqQV(encoder.Encode(frames), reverseClipFrom, clipLength);
+                tags[Label(tag)] = ClipSeqQV(table.Encode(frames), reverseClipFrom, clipLength);
             }
         }
     };
     const auto rg = ReadGroup();
     const auto ipdCodec = rg.IpdCodec();
-    const auto ipdEncoder = rg.IpdFrameEncoder();
     const auto pwCodec = rg.PulseWidthCodec();
-    const auto pwEncoder = rg.IpdFrameEncoder();
-    ClipKineticsTag(BamRecordTag::IPD, ipdCodec, ipdEncoder);
-    ClipKineticsTag(BamRecordTag::PULSE_WIDTH, pwCodec, pwEncoder);
-    ClipKineticsTag(BamRecordTag::FORWARD_IPD, ipdCodec, ipdEncoder);
-    ClipKineticsTag(BamRecordTag::FORWARD_PW, pwCodec, pwEncoder);
-    ClipReverseKineticsTag(BamRecordTag::REVERSE_IPD, ipdCodec, ipdEncoder);
-    ClipReverseKineticsTag(BamRecordTag::REVERSE_PW, pwCodec, pwEncoder);
+    const auto codecTables = ReadGroupFrameCodecs(*this);
+    const auto& ipdTable = *codecTables.ipd;
+    const auto& pwTable = *codecTables.pulseWidth;
+    ClipKineticsTag(BamRecordTag::IPD, ipdCodec, ipdTable);
+    ClipKineticsTag(BamRecordTag::PULSE_WIDTH, pwCodec, pwTable);
+    ClipKineticsTag(BamRecordTag::FORWARD_IPD, ipdCodec, ipdTable);
+    ClipKineticsTag(BamRecordTag::FORWARD_PW, pwCodec, pwTable);
+    ClipReverseKineticsTag(BamRecordTag::REVERSE_IPD, ipdCodec, ipdTable);
+    ClipReverseKineticsTag(BamRecordTag::REVERSE_PW, pwCodec, pwTable);
 
     // basemods tags
     if (impl_.HasTag(BamRecordTag::BASEMOD_LOCI)) {
@@ -1093,30 +1150,38 @@ std::string BamRecord::FetchBases(const BamRecordTag tag, const Data::Orientatio
 
 Data::Frames BamRecord::FetchFramesRaw(const BamRecordTag tag) const
 {
-    const auto frameTag = impl_.TagValue(tag);
-    if (frameTag.IsNull()) {
-        throw std::runtime_error{"[pbbam] BAM record ERROR: tag '" + BamRecordTags::LabelFor(tag) +
+    const auto& b = BamRecordMemory::GetRawData(impl_);
+    const std::string label = BamRecordTags::LabelFor(tag);
+    const std::uint8_t* data = bam_aux_get(b.get(), label.c_str());
+    if (data == nullptr) {
+        throw std::runtime_error{"[pbbam] BAM record ERROR: tag '" + label +
                                  "' was requested but is missing"};
     }
 
-    // lossy frame codes
-    if (frameTag.IsUInt8Array()) {
-        const auto& decoder = [&]() -> Data::FrameEncoder {
+    // lossy frame codes, decoded directly from the record's data
+    if (data[0] == 'B' && data[1] == 'C') {
+        std::uint32_t length = 0;
+        std::memcpy(&length, data + 2, sizeof(length));
+        const auto codecTables = ReadGroupFrameCodecs(*this);
+        const FrameCodecTable& table = [&]() -> const FrameCodecTable& {
             if (BamRecordTags::IsIPD(tag)) {
-                return IpdEncoder(*this);
+                return *codecTables.ipd;
             } else {
                 assert(BamRecordTags::IsPW(tag));
-                return PwEncoder(*this);
+                return *codecTables.pulseWidth;
             }
         }();
-        return decoder.Decode(frameTag.ToUInt8Array());
+
+        Data::Frames frames;
+        frames.DataRaw().resize(length);
+        table.Decode(data + 2 + sizeof(length), length, frames.DataRaw().data());
+        return frames;
     }
 
     // lossless frame data
-    else {
-        assert(frameTag.IsUInt16Array());
-        return Data::Frames{frameTag.ToUInt16Array()};
-    }
+    const auto frameTag = impl_.TagValue(tag);
+    assert(frameTag.IsUInt16Array());
+    return Data::Frames{frameTag.ToUInt16Array()};
 }
 
 Data::Frames BamRecord::FetchFrames(const BamRecordTag tag, const Data::Orientation orientation,
@@ -1400,8 +1465,7 @@ BamRecord& BamRecord::ForwardIPD(const Data::Frames& frames, const Data::FrameCo
     if (encoding == Data::FrameCodec::RAW) {
         CreateOrEdit(BamRecordTag::FORWARD_IPD, frameData, &impl_);
     } else {
-        const auto encoder = IpdEncoder(*this);
-        CreateOrEdit(BamRecordTag::FORWARD_IPD, encoder.Encode(frameData), &impl_);
+        CreateOrEdit(BamRecordTag::FORWARD_IPD, IpdCodecTable(*this).Encode(frameData), &impl_);
     }
     return *this;
 }
@@ -1418,8 +1482,7 @@ BamRecord& BamRecord::ForwardPulseWidth(const Data::Frames& frames, const Data::
     if (encoding == Data::FrameCodec::RAW) {
         CreateOrEdit(BamRecordTag::FORWARD_PW, frameData, &impl_);
     } else {
-        const auto encoder = PwEncoder(*this);
-        CreateOrEdit(BamRecordTag::FORWARD_PW, encoder.Encode(frameData), &impl_);
+        CreateOrEdit(BamRecordTag::FORWARD_PW, PwCodecTable(*this).Encode(frameData), &impl_);
     }
     return *this;
 }
@@ -1573,7 +1636,7 @@ int32_t BamRecord::HoleNumber() const
     }
 
     // missing zm tag - try to pull from name
-    return HoleNumberFromName(FullName());
+    return HoleNumberFromName(ParseRecordName(BamRecordMemory::GetRawData(impl_).get()));
 }
 
 BamRecord& BamRecord::HoleNumber(const std::int32_t holeNumber)
@@ -1618,8 +1681,7 @@ BamRecord& BamRecord::IPD(const Data::Frames& frames, const Data::FrameCodec enc
     if (encoding == Data::FrameCodec::RAW) {
         CreateOrEdit(BamRecordTag::IPD, frameData, &impl_);
     } else {
-        const auto encoder = IpdEncoder(*this);
-        CreateOrEdit(BamRecordTag::IPD, encoder.Encode(frameData), &impl_);
+        CreateOrEdit(BamRecordTag::IPD, IpdCodecTable(*this).Encode(frameData), &impl_);
     }
     return *this;
 }
@@ -1719,8 +1781,7 @@ BamRecord& BamRecord::Map(const std::int32_t referenceId, const Data::Position r
     }
 
     // reset any cached aligned start/end
-    alignedStart_ = Data::UNMAPPED_POSITION;
-    alignedEnd_ = Data::UNMAPPED_POSITION;
+    ResetCachedPositions();
 
     return *this;
 }
@@ -1969,12 +2030,8 @@ std::string BamRecord::MovieName() const
     if (!rgId.empty()) {
         return header_.ReadGroup(rgId).MovieName();
     } else {
-        const auto nameParts = Split(FullName(), '/');
-        if (nameParts.empty()) {
-            throw std::runtime_error{"[pbbam] BAM record ERROR: has malformed name: '" +
-                                     FullName() + "'"};
-        }
-        return nameParts[0];
+        return std::string{
+            ParseRecordName(BamRecordMemory::GetRawData(impl_).get()).movieName};
     }
 }
 
@@ -1987,40 +2044,16 @@ size_t BamRecord::NumDeletionOperations() const
 
 std::pair<std::size_t, std::size_t> BamRecord::NumInsertedAndDeletedBases() const
 {
-    std::size_t nInsBases = 0;
-    std::size_t nDelBases = 0;
-
-    auto& b = BamRecordMemory::GetRawData(this);
-    std::uint32_t* cigarData = bam_get_cigar(b.get());
-    for (std::uint32_t i = 0; i < b->core.n_cigar; ++i) {
-        const auto type = static_cast<Data::CigarOperationType>(bam_cigar_op(cigarData[i]));
-        if (type == Data::CigarOperationType::INSERTION) {
-            nInsBases += bam_cigar_oplen(cigarData[i]);
-        } else if (type == Data::CigarOperationType::DELETION) {
-            nDelBases += bam_cigar_oplen(cigarData[i]);
-        }
-    }
-    return {nInsBases, nDelBases};
+    const auto& stats = CigarStatistics();
+    return {stats.numInsertedBases, stats.numDeletedBases};
 }
 
 size_t BamRecord::NumInsertedBases() const { return NumInsertedAndDeletedBases().first; }
 
 std::pair<std::size_t, std::size_t> BamRecord::NumInsertionAndDeletionOperations() const
 {
-    std::size_t nInsOps = 0;
-    std::size_t nDelOps = 0;
-
-    auto& b = BamRecordMemory::GetRawData(this);
-    std::uint32_t* cigarData = bam_get_cigar(b.get());
-    for (std::uint32_t i = 0; i < b->core.n_cigar; ++i) {
-        const auto type = static_cast<Data::CigarOperationType>(bam_cigar_op(cigarData[i]));
-        if (type == Data::CigarOperationType::INSERTION) {
-            ++nInsOps;
-        } else if (type == Data::CigarOperationType::DELETION) {
-            ++nDelOps;
-        }
-    }
-    return {nInsOps, nDelOps};
+    const auto& stats = CigarStatistics();
+    return {stats.numInsertionOperations, stats.numDeletionOperations};
 }
 
 size_t BamRecord::NumInsertionOperations() const
@@ -2032,19 +2065,8 @@ size_t BamRecord::NumMatches() const { return NumMatchesAndMismatches().first; }
 
 std::pair<std::size_t, std::size_t> BamRecord::NumMatchesAndMismatches() const
 {
-    std::pair<std::size_t, std::size_t> result = std::make_pair(0, 0);
-
-    auto& b = BamRecordMemory::GetRawData(this);
-    std::uint32_t* cigarData = bam_get_cigar(b.get());
-    for (std::uint32_t i = 0; i < b->core.n_cigar; ++i) {
-        const auto type = static_cast<Data::CigarOperationType>(bam_cigar_op(cigarData[i]));
-        if (type == Data::CigarOperationType::SEQUENCE_MATCH) {
-            result.first += bam_cigar_oplen(cigarData[i]);
-        } else if (type == Data::CigarOperationType::SEQUENCE_MISMATCH) {
-            result.second += bam_cigar_oplen(cigarData[i]);
-        }
-    }
-    return result;
+    const auto& stats = CigarStatistics();
+    return {stats.numMatches, stats.numMismatches};
 }
 
 size_t BamRecord::NumMismatches() const { return NumMatchesAndMismatches().second; }
@@ -2234,6 +2256,7 @@ std::string BamRecord::PulseCall(Data::Orientation orientation, bool aligned, bo
 BamRecord& BamRecord::PulseCall(const std::string& tags)
 {
     CreateOrEdit(BamRecordTag::PULSE_CALL, tags, &impl_);
+    p2bCache_.reset();
     return *this;
 }
 
@@ -2312,8 +2335,7 @@ BamRecord& BamRecord::PulseWidth(const Data::Frames& frames, const Data::FrameCo
     if (encoding == Data::FrameCodec::RAW) {
         CreateOrEdit(BamRecordTag::PULSE_WIDTH, frameData, &impl_);
     } else {
-        const auto encoder = PwEncoder(*this);
-        CreateOrEdit(BamRecordTag::PULSE_WIDTH, encoder.Encode(frameData), &impl_);
+        CreateOrEdit(BamRecordTag::PULSE_WIDTH, PwCodecTable(*this).Encode(frameData), &impl_);
     }
     return *this;
 }
@@ -2350,12 +2372,13 @@ Data::Position BamRecord::QueryEnd() const
     }
 
     // PacBio BAM, non-CCS/transcript
-    try {
-        return QueryEndFromName(FullName());
-    } catch (std::exception&) {
-        // return fallback position
-        return 0;
+    const auto name = ParseRecordName(BamRecordMemory::GetRawData(impl_).get());
+    if (name.queryInterval) {
+        return name.queryInterval->second;
     }
+
+    // return fallback position
+    return 0;
 }
 
 BamRecord& BamRecord::QueryEnd(const Data::Position pos)
@@ -2407,12 +2430,13 @@ Data::Position BamRecord::QueryStart() const
     }
 
     // PacBio BAM, non-CCS/transcript
-    try {
-        return QueryStartFromName(FullName());
-    } catch (std::exception&) {
-        // return fallback position
-        return 0;
+    const auto name = ParseRecordName(BamRecordMemory::GetRawData(impl_).get());
+    if (name.queryInterval) {
+        return name.queryInterval->first;
     }
+
+    // return fallback position
+    return 0;
 }
 
 BamRecord& BamRecord::QueryStart(const Data::Position pos)
@@ -2491,7 +2515,13 @@ Data::Position BamRecord::ReferenceEnd() const
     if (!htsData) {
         return Data::UNMAPPED_POSITION;
     }
-    return bam_endpos(htsData.get());
+
+    // defer to htslib for its zero-length conventions
+    const auto span = CigarStatistics().referenceSpan;
+    if (span == 0) {
+        return bam_endpos(htsData.get());
+    }
+    return htsData->core.pos + static_cast<Data::Position>(span);
 }
 
 int32_t BamRecord::ReferenceId() const { return impl_.ReferenceId(); }
@@ -2520,8 +2550,7 @@ BamRecord& BamRecord::ReverseIPD(const Data::Frames& frames, const Data::FrameCo
     if (encoding == Data::FrameCodec::RAW) {
         CreateOrEdit(BamRecordTag::REVERSE_IPD, frameData, &impl_);
     } else {
-        const auto encoder = IpdEncoder(*this);
-        CreateOrEdit(BamRecordTag::REVERSE_IPD, encoder.Encode(frameData), &impl_);
+        CreateOrEdit(BamRecordTag::REVERSE_IPD, IpdCodecTable(*this).Encode(frameData), &impl_);
     }
     return *this;
 }
@@ -2538,8 +2567,7 @@ BamRecord& BamRecord::ReversePulseWidth(const Data::Frames& frames, const Data::
     if (encoding == Data::FrameCodec::RAW) {
         CreateOrEdit(BamRecordTag::REVERSE_PW, frameData, &impl_);
     } else {
-        const auto encoder = PwEncoder(*this);
-        CreateOrEdit(BamRecordTag::REVERSE_PW, encoder.Encode(frameData), &impl_);
+        CreateOrEdit(BamRecordTag::REVERSE_PW, PwCodecTable(*this).Encode(frameData), &impl_);
     }
     return *this;
 }
@@ -2548,12 +2576,21 @@ void BamRecord::ResetCachedPositions() const
 {
     alignedEnd_ = Data::UNMAPPED_POSITION;
     alignedStart_ = Data::UNMAPPED_POSITION;
+    cigarStatsCached_ = false;
+    p2bCache_.reset();
 }
 
 void BamRecord::ResetCachedPositions()
 {
-    alignedEnd_ = Data::UNMAPPED_POSITION;
-    alignedStart_ = Data::UNMAPPED_POSITION;
+    std::as_const(*this).ResetCachedPositions();
+}
+
+void BamRecord::ResetStaleCachedData() const
+{
+    if (cachedEditStamp_ != impl_.editStamp_) {
+        ResetCachedPositions();
+        cachedEditStamp_ = impl_.editStamp_;
+    }
 }
 
 VirtualRegionType BamRecord::ScrapRegionType() const
@@ -2732,20 +2769,16 @@ RecordType BamRecord::Type() const
         // read group not found, peek at name to see if we're possibly one of:
         //   CCS, TRANSCRIPT, SEGMENT
         //
-        const auto name = FullName();
-        if (name.find("transcript") == 0) {
-            return RecordType::TRANSCRIPT;
-        }
-        if (name.find("ccs") != std::string::npos) {
-            if (boost::algorithm::ends_with(name, "ccs") ||
-                boost::algorithm::ends_with(name, "fwd") ||
-                boost::algorithm::ends_with(name, "rev")) {
+        switch (ParseRecordName(BamRecordMemory::GetRawData(impl_).get()).type) {
+            case RecordNameType::TRANSCRIPT:
+                return RecordType::TRANSCRIPT;
+            case RecordNameType::CCS:
                 return RecordType::CCS;
-            }
-            assert(std::isdigit(name.back()));
-            return RecordType::SEGMENT;
+            case RecordNameType::SEGMENT:
+                return RecordType::SEGMENT;
+            default:
+                return RecordType::UNKNOWN;
         }
-        return RecordType::UNKNOWN;
     }
 }
 
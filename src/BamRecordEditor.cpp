@@ -0,0 +1,290 @@
+#include "PbbamInternalConfig.h"
+
+#include <pbbam/BamRecordEditor.h>
+
+#include <pbbam/BamRecord.h>
+#include <pbbam/BamRecordImpl.h>
+#include <pbbam/BamTagCodec.h>
+#include "BamRecordTags.h"
+#include "SequenceCodec.h"
+
+#include <pbcopper/utility/Ssize.h>
+
+#include <htslib/sam.h>
+
+#include <algorithm>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace PacBio {
+namespace BAM {
+namespace {
+
+std::uint16_t TagCode(const std::uint8_t* tagName)
+{
+    return (tagName[0] << 8) | tagName[1];
+}
+
+std::uint16_t TagCode(const std::string& tagName)
+{
+    if (tagName.size() != 2) {
+        throw std::runtime_error{"[pbbam] BAM record editor ERROR: tag name (" + tagName +
+                                 ") must have 2 characters only"};
+    }
+    return TagCode(reinterpret_cast<const std::uint8_t*>(tagName.data()));
+}
+
+}  // namespace
+
+BamRecordEditor::BamRecordEditor(BamRecordImpl& record) : impl_{&record} {}
+
+BamRecordEditor::BamRecordEditor(BamRecord& record) : record_{&record} {}
+
+BamRecordEditor::~BamRecordEditor() = default;
+
+BamRecordEditor& BamRecordEditor::CigarData(Data::Cigar cigar)
+{
+    cigar_ = std::move(cigar);
+    return RemoveTag("CG");
+}
+
+BamRecordEditor& BamRecordEditor::ClearTags()
+{
+    clearTags_ = true;
+    tagEdits_.clear();
+    return *this;
+}
+
+void BamRecordEditor::Commit()
+{
+    // edits below bypass BamRecordImpl's setters, so mark record data as edited
+    // up front (BamRecord's cached data is then reset on next use)
+    BamRecordImpl& impl = (record_ ? record_->Impl() : *impl_);
+    impl.UpdateEditStamp();
+    bam1_t* b = impl.d_.get();
+
+    // current layout
+    const std::uint8_t* oldCigar = reinterpret_cast<const std::uint8_t*>(bam_get_cigar(b));
+    const std::uint8_t* oldSequence = bam_get_seq(b);
+    const std::uint8_t* oldTags = bam_get_aux(b);
+    const int oldTagsLength = b->l_data - (oldTags - b->data);
+
+    // new section sizes
+    int nameLength = b->core.l_qname;
+    int numExtraNulls = b->core.l_extranul;
+    if (name_) {
+        const int numChars = Utility::Ssize(*name_) + 1;  // +1 for NULL-term
+        numExtraNulls = 4 - (numChars % 4);
+        nameLength = numChars + numExtraNulls;
+    }
+    const std::uint32_t numCigarOps = cigar_ ? cigar_->size() : b->core.n_cigar;
+    const int sequenceLength = sequence_ ? Utility::Ssize(*sequence_) : b->core.l_qseq;
+    const int encodedSequenceLength = (sequenceLength + 1) / 2;
+
+    // existing tags keep their position (unless removed), then new tags
+    int tagsLength = 0;
+    for (auto& edit : tagEdits_) {
+        edit.Offset = -1;
+    }
+    if (!clearTags_) {
+        int i = 0;
+        while (i < oldTagsLength) {
+            const int length = 2 + BamTagCodec::RawDataLength(oldTags + i + 2);
+            TagEdit* edit = FindTagEdit(TagCode(oldTags + i));
+            if (edit == nullptr) {
+                tagsLength += length;
+            } else if (edit->Offset == -1) {
+                edit->Offset = i;  // any duplicates are dropped
+                if (edit->Type != 0) {
+                    tagsLength += 3 + Utility::Ssize(edit->RawData);
+                }
+            }
+            i += length;
+        }
+    }
+    for (const auto& edit : tagEdits_) {
+        if (edit.Offset == -1 && edit.Type != 0) {
+            tagsLength += 3 + Utility::Ssize(edit.RawData);
+        }
+    }
+
+    const int cigarLength = static_cast<int>(numCigarOps * sizeof(std::uint32_t));
+    const int dataLength =
+        nameLength + cigarLength + encodedSequenceLength + sequenceLength + tagsLength;
+    std::uint32_t capacity = std::max(dataLength, 1);
+    kroundup32(capacity);
+    auto* data = static_cast<std::uint8_t*>(std::malloc(capacity));
+    if (data == nullptr) {
+        throw std::bad_alloc{};
+    }
+    std::uint8_t* out = data;
+
+    // name
+    if (name_) {
+        const int numChars = nameLength - numExtraNulls;
+        std::memcpy(out, name_->c_str(), numChars);
+        std::memset(out + numChars, '\0', numExtraNulls);
+    } else {
+        std::memcpy(out, b->data, nameLength);
+    }
+    out += nameLength;
+
+    // CIGAR
+    if (cigar_) {
+        for (const auto& op : *cigar_) {
+            const std::uint32_t encodedOp = bam_cigar_gen(op.Length(), static_cast<int>(op.Type()));
+            std::memcpy(out, &encodedOp, sizeof(std::uint32_t));
+            out += sizeof(std::uint32_t);
+        }
+    } else {
+        std::memcpy(out, oldCigar, cigarLength);
+        out += cigarLength;
+    }
+
+    // sequence & qualities
+    if (sequence_) {
+        EncodeSequence(sequence_->data(), sequenceLength, out);
+        out += encodedSequenceLength;
+        if (qualities_.empty()) {
+            std::memset(out, 0xff, sequenceLength);
+        } else {
+            EncodeFastqQualities(qualities_.data(), sequenceLength, out);
+        }
+        out += sequenceLength;
+    } else {
+        std::memcpy(out, oldSequence, encodedSequenceLength + sequenceLength);
+        out += encodedSequenceLength + sequenceLength;
+    }
+
+    // tags
+    const auto writeTag = [&out](const TagEdit& edit) {
+        out[0] = static_cast<std::uint8_t>(edit.Code >> 8);
+        out[1] = static_cast<std::uint8_t>(edit.Code & 0xFF);
+        out[2] = edit.Type;
+        std::memcpy(out + 3, edit.RawData.data(), edit.RawData.size());
+        out += 3 + edit.RawData.size();
+    };
+    if (!clearTags_) {
+        int i = 0;
+        while (i < oldTagsLength) {
+            const int length = 2 + BamTagCodec::RawDataLength(oldTags + i + 2);
+            const TagEdit* edit = FindTagEdit(TagCode(oldTags + i));
+            if (edit == nullptr) {
+                std::memcpy(out, oldTags + i, length);
+                out += length;
+            } else if (edit->Offset == i && edit->Type != 0) {
+                writeTag(*edit);
+            }
+            i += length;
+        }
+    }
+    for (const auto& edit : tagEdits_) {
+        if (edit.Offset == -1 && edit.Type != 0) {
+            writeTag(edit);
+        }
+    }
+    assert(out == data + dataLength);
+
+    // swap in new data
+    std::free(b->data);
+    b->data = data;
+    b->m_data = capacity;
+    b->l_data = dataLength;
+    b->core.l_qname = nameLength;
+    b->core.l_extranul = numExtraNulls;
+    b->core.n_cigar = numCigarOps;
+    b->core.l_qseq = sequenceLength;
+    impl.UpdateTagMap();
+
+    // reset for reuse
+    name_.reset();
+    cigar_.reset();
+    sequence_.reset();
+    qualities_.clear();
+    clearTags_ = false;
+    tagEdits_.clear();
+}
+
+BamRecordEditor::TagEdit& BamRecordEditor::FindOrAddTagEdit(const std::string& tagName)
+{
+    const std::uint16_t code = TagCode(tagName);
+    if (TagEdit* edit = FindTagEdit(code)) {
+        return *edit;
+    }
+    tagEdits_.push_back(TagEdit{code, 0, {}, -1});
+    return tagEdits_.back();
+}
+
+BamRecordEditor::TagEdit* BamRecordEditor::FindTagEdit(const std::uint16_t code)
+{
+    const auto found = std::find_if(tagEdits_.begin(), tagEdits_.end(),
+                                    [code](const TagEdit& edit) { return edit.Code == code; });
+    return (found == tagEdits_.end()) ? nullptr : &(*found);
+}
+
+BamRecordEditor& BamRecordEditor::Name(std::string name)
+{
+    name_ = std::move(name);
+    return *this;
+}
+
+BamRecordEditor& BamRecordEditor::RemoveTag(const std::string& tagName)
+{
+    TagEdit& edit = FindOrAddTagEdit(tagName);
+    edit.Type = 0;
+    edit.RawData.clear();
+    return *this;
+}
+
+BamRecordEditor& BamRecordEditor::RemoveTag(const BamRecordTag tag)
+{
+    return RemoveTag(BamRecordTags::LabelFor(tag));
+}
+
+BamRecordEditor& BamRecordEditor::SequenceAndQualities(std::string sequence,
+                                                       std::string qualities)
+{
+    if (!qualities.empty() && (sequence.size() != qualities.size())) {
+        std::ostringstream s;
+        s << "[pbbam] BAM record editor ERROR: if qualities are provided, the length must match "
+             "the sequence length:\n"
+          << "  sequence length: " << sequence.size() << '\n'
+          << "  qualities length: " << qualities.size();
+        throw std::runtime_error{s.str()};
+    }
+    sequence_ = std::move(sequence);
+    qualities_ = std::move(qualities);
+    return *this;
+}
+
+BamRecordEditor& BamRecordEditor::SetTag(const std::string& tagName, const Tag& value,
+                                         const TagModifier additionalModifier)
+{
+    auto rawData = BamTagCodec::ToRawData(value, additionalModifier);
+    if (rawData.empty()) {
+        throw std::runtime_error{
+            "[pbbam] BAM record editor ERROR: could not encode value for tag " + tagName};
+    }
+
+    TagEdit& edit = FindOrAddTagEdit(tagName);
+    edit.Type = BamTagCodec::TagTypeCode(value, additionalModifier);
+    edit.RawData = std::move(rawData);
+    return *this;
+}
+
+BamRecordEditor& BamRecordEditor::SetTag(const BamRecordTag tag, const Tag& value,
+                                         const TagModifier additionalModifier)
+{
+    return SetTag(BamRecordTags::LabelFor(tag), value, additionalModifier);
+}
+
+}  // namespace BAM
+}  // namespace PacBio
@@ -2,20 +2,23 @@
 
 #include <pbbam/BamRecordImpl.h>
 
+#include <pbbam/BamRecordPool.h>
 #include <pbbam/BamTagCodec.h>
 #include <pbbam/StringUtilities.h>
 #include "BamRecordTags.h"
 #include "MemoryUtils.h"
+#include "SequenceCodec.h"
 
 #include <pbcopper/utility/Ssize.h>
 
 #include <htslib/hts_endian.h>
 
 #include <algorithm>
-#include <array>
+#include <atomic>
 #include <optional>
 #include <sstream>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include <cassert>
@@ -41,16 +44,58 @@ Data::Cigar FetchRawCigar(const std::uint32_t* const src, const std::uint32_t le
     return result;
 }
 
+// initial tag offset table size, holds up to 32 tags before growing
+constexpr std::size_t MinTagSlots = 64;
+
+std::uint16_t TagCode(const char* tagName)
+{
+    return (static_cast<std::uint8_t>(tagName[0]) << 8) | static_cast<std::uint8_t>(tagName[1]);
+}
+
+std::size_t TagSlot(const std::uint16_t tagCode, const std::size_t mask)
+{
+    // multiplicative hash, so that both name characters affect the low bits
+    return ((tagCode * 0x9E3779B1u) >> 16) & mask;
+}
+
+std::uint64_t NextEditStamp()
+{
+    // stamps are reserved in blocks, so threads rarely touch the shared counter
+    constexpr std::uint64_t BlockSize = 1 << 16;
+    static std::atomic<std::uint64_t> nextBlock{1};
+    thread_local std::uint64_t next = 0;
+    thread_local std::uint64_t end = 0;
+    if (next == end) {
+        next = nextBlock.fetch_add(BlockSize, std::memory_order_relaxed);
+        end = next + BlockSize;
+    }
+    return next++;
+}
+
+// bam_dup1, with the copy's data block taken from the record pool
+bam1_t* DuplicateRecord(bam1_t* source)
+{
+    bam1_t* result = BamRecordPool::Acquire(source->l_data);
+    if (result != nullptr && bam_copy1(result, source) == nullptr) {
+        bam_destroy1(result);
+        return nullptr;
+    }
+    return result;
+}
+
 }  // namespace
 
-BamRecordImpl::BamRecordImpl() : d_{nullptr}
+BamRecordImpl::BamRecordImpl() : d_{nullptr}, editStamp_{NextEditStamp()}
 {
     InitializeData();
     assert(d_);
 }
 
 BamRecordImpl::BamRecordImpl(const BamRecordImpl& other)
-    : d_{bam_dup1(other.d_.get())}, tagOffsets_{other.tagOffsets_}
+    : d_{DuplicateRecord(other.d_.get())}
+    , tagOffsets_{other.tagOffsets_}
+    , numTags_{other.numTags_}
+    , editStamp_{other.editStamp_}
 {
     assert(d_);
 }
@@ -67,12 +112,14 @@ BamRecordImpl& BamRecordImpl::operator=(const BamRecordImpl& other)
                                      other.Name() + '\''};
         }
         tagOffsets_ = other.tagOffsets_;
+        numTags_ = other.numTags_;
+        editStamp_ = other.editStamp_;
     }
     assert(d_);
     return *this;
 }
 
-BamRecordImpl::~BamRecordImpl() = default;
+BamRecordImpl::~BamRecordImpl() { BamRecordPool::Release(d_.release()); }
 
 bool BamRecordImpl::AddTag(const std::string& tagName, const Tag& value)
 {
@@ -90,9 +137,13 @@ bool BamRecordImpl::AddTag(const std::string& tagName, const Tag& value,
     if (tagName.size() != 2 || HasTag(tagName)) {
         return false;
     }
+
+    // new tag is appended to aux data
+    const auto* tagStart = bam_get_aux(d_);
+    const int offset = d_->l_data - (tagStart - d_->data) + 2;
     const auto added = AddTagImpl(tagName, value, additionalModifier);
     if (added) {
-        UpdateTagMap();
+        InsertTagOffset(TagCode(tagName.c_str()), offset);
     }
     return added;
 }
@@ -113,6 +164,7 @@ bool BamRecordImpl::AddTagImpl(const std::string& tagName, const Tag& value,
 
     bam_aux_append(d_.get(), tagName.c_str(), BamTagCodec::TagTypeCode(value, additionalModifier),
                    rawData.size(), const_cast<std::uint8_t*>(rawData.data()));
+    UpdateEditStamp();
     return true;
 }
 
@@ -158,18 +210,36 @@ bool BamRecordImpl::EditTag(const BamRecordTag tag, const Tag& newValue)
 bool BamRecordImpl::EditTag(const std::string& tagName, const Tag& newValue,
                             const TagModifier additionalModifier)
 {
-    // try remove old value (with delayed tag map update)
-    const bool removed = RemoveTagImpl(tagName);
-    if (!removed) {
+    if (tagName.size() != 2) {
+        return false;
+    }
+    const int offset = TagOffset(tagName);
+    if (offset == -1) {
+        return false;
+    }
+    const auto rawData = BamTagCodec::ToRawData(newValue, additionalModifier);
+    if (rawData.empty()) {
         return false;
     }
 
-    // if old value removed, add new value
-    const bool added = AddTagImpl(tagName, newValue, additionalModifier);
-    if (added) {
-        UpdateTagMap();
+    // replace value in place, shifting any following tags if its size changes
+    const int oldLength = BamTagCodec::RawDataLength(bam_get_aux(d_) + offset);
+    const int newLength = 1 + Utility::Ssize(rawData);
+    const int diffNumBytes = newLength - oldLength;
+    if (diffNumBytes != 0) {
+        const int tailStart = (bam_get_aux(d_) - d_->data) + offset + oldLength;
+        const int tailLength = d_->l_data - tailStart;
+        d_->l_data += diffNumBytes;
+        MaybeReallocData();
+        std::memmove(d_->data + tailStart + diffNumBytes, d_->data + tailStart, tailLength);
+        ShiftTagOffsets(offset, diffNumBytes);
     }
-    return added;
+
+    std::uint8_t* tagValue = bam_get_aux(d_) + offset;
+    tagValue[0] = BamTagCodec::TagTypeCode(newValue, additionalModifier);
+    std::memcpy(tagValue + 1, rawData.data(), rawData.size());
+    UpdateEditStamp();
+    return true;
 }
 
 bool BamRecordImpl::EditTag(const BamRecordTag tag, const Tag& newValue,
@@ -199,6 +269,7 @@ uint32_t BamRecordImpl::Flag() const { return d_->core.flag; }
 BamRecordImpl& BamRecordImpl::Flag(std::uint32_t flag)
 {
     d_->core.flag = flag;
+    UpdateEditStamp();
     return *this;
 }
 
@@ -228,7 +299,7 @@ bool BamRecordImpl::HasTag(const BamRecordTag tag) const
 
 void BamRecordImpl::InitializeData()
 {
-    d_.reset(bam_init1());
+    d_.reset(BamRecordPool::Acquire());
 
     // init unmapped
     Position(Data::UNMAPPED_POSITION);
@@ -240,8 +311,6 @@ void BamRecordImpl::InitializeData()
 
     // init empty QNAME
     Name("");
-
-    tagOffsets_.reserve(32);
 }
 
 int32_t BamRecordImpl::InsertSize() const { return d_->core.isize; }
@@ -323,6 +392,7 @@ Data::Position BamRecordImpl::Position() const { return d_->core.pos; }
 BamRecordImpl& BamRecordImpl::Position(Data::Position pos)
 {
     d_->core.pos = pos;
+    UpdateEditStamp();
     return *this;
 }
 
@@ -341,6 +411,7 @@ BamRecordImpl& BamRecordImpl::SetDuplicate(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::DUPLICATE;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -392,31 +463,54 @@ BamRecordImpl& BamRecordImpl::Name(const std::string& name)
 
 Data::QualityValues BamRecordImpl::Qualities() const
 {
+    Data::QualityValues result;
+    QualitiesInto(result);
+    return result;
+}
+
+void BamRecordImpl::QualitiesInto(Data::QualityValues& qualities) const
+{
+    qualities.clear();
     if (d_->core.l_qseq == 0) {
-        return Data::QualityValues();
+        return;
     }
 
-    std::uint8_t* qualData = bam_get_qual(d_);
+    const std::uint8_t* qualData = bam_get_qual(d_);
     if (qualData[0] == 0xff) {
-        return Data::QualityValues();
+        return;
     }
 
     const std::size_t numQuals = d_->core.l_qseq;
-    Data::QualityValues result;
-    result.reserve(numQuals);
-    for (std::size_t i = 0; i < numQuals; ++i) {
-        result.push_back(Data::QualityValue(qualData[i]));
+    qualities.resize(numQuals);
+    if constexpr (sizeof(Data::QualityValue) == 1 &&
+                  std::is_trivially_copyable_v<Data::QualityValue>) {
+        std::memcpy(qualities.data(), qualData, numQuals);
+    } else {
+        for (std::size_t i = 0; i < numQuals; ++i) {
+            qualities[i] = Data::QualityValue(qualData[i]);
+        }
     }
-    return result;
 }
 
 bool BamRecordImpl::RemoveTag(const std::string& tagName)
 {
-    const bool removed = RemoveTagImpl(tagName);
-    if (removed) {
-        UpdateTagMap();
+    if (tagName.size() != 2) {
+        return false;
     }
-    return removed;
+    const int offset = TagOffset(tagName);
+    if (offset == -1) {
+        return false;
+    }
+
+    std::uint8_t* tagValue = bam_get_aux(d_) + offset;
+    const int numBytes = 2 + BamTagCodec::RawDataLength(tagValue);
+    if (bam_aux_del(d_.get(), tagValue) != 0) {
+        return false;
+    }
+    EraseTagOffset(TagCode(tagName.c_str()));
+    ShiftTagOffsets(offset, -numBytes);
+    UpdateEditStamp();
+    return true;
 }
 
 bool BamRecordImpl::RemoveTag(const BamRecordTag tag)
@@ -424,29 +518,23 @@ bool BamRecordImpl::RemoveTag(const BamRecordTag tag)
     return RemoveTag(BamRecordTags::LabelFor(tag));
 }
 
-bool BamRecordImpl::RemoveTagImpl(const std::string& tagName)
+std::string BamRecordImpl::Sequence() const
 {
-    if (tagName.size() != 2) {
-        return false;
-    }
-    std::uint8_t* data = bam_aux_get(d_.get(), tagName.c_str());
-    if (data == nullptr) {
-        return false;
-    }
-    const bool ok = bam_aux_del(d_.get(), data) == 0;
-    return ok;
+    std::string result;
+    SequenceInto(result);
+    return result;
 }
 
-std::string BamRecordImpl::Sequence() const
+void BamRecordImpl::SequenceInto(std::string& sequence, const bool reverseComplement) const
 {
-    std::string result(d_->core.l_qseq, '\0');
-    constexpr std::array<char, 16> DNA_LOOKUP{
-        {'=', 'A', 'C', 'M', 'G', 'R', 'S', 'V', 'T', 'W', 'Y', 'H', 'K', 'D', 'B', 'N'}};
+    const std::size_t length = d_->core.l_qseq;
+    sequence.resize(length);
     const std::uint8_t* seqData = bam_get_seq(d_);
-    for (int i = 0; i < d_->core.l_qseq; ++i) {
-        result[i] = DNA_LOOKUP[bam_seqi(seqData, i)];
+    if (reverseComplement) {
+        DecodeReverseComplementSequence(seqData, length, sequence.data());
+    } else {
+        DecodeSequence(seqData, length, sequence.data());
     }
-    return result;
 }
 
 size_t BamRecordImpl::SequenceLength() const { return d_->core.l_qseq; }
@@ -475,6 +563,7 @@ void BamRecordImpl::SetCigarData(const Data::Cigar& cigar)
         const Data::CigarOperation& cigarOp = cigar.at(i);
         cigarDataStart[i] = bam_cigar_gen(cigarOp.Length(), static_cast<int>(cigarOp.Type()));
     }
+    UpdateEditStamp();
 }
 
 BamRecordImpl& BamRecordImpl::SetFailedQC(bool ok)
@@ -484,6 +573,7 @@ BamRecordImpl& BamRecordImpl::SetFailedQC(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::FAILED_QC;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -494,6 +584,7 @@ BamRecordImpl& BamRecordImpl::SetFirstMate(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::MATE_1;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -504,6 +595,7 @@ BamRecordImpl& BamRecordImpl::SetMapped(bool ok)
     } else {
         d_->core.flag |= BamRecordImpl::UNMAPPED;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -514,6 +606,7 @@ BamRecordImpl& BamRecordImpl::SetMateMapped(bool ok)
     } else {
         d_->core.flag |= BamRecordImpl::MATE_UNMAPPED;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -524,6 +617,7 @@ BamRecordImpl& BamRecordImpl::SetMateReverseStrand(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::MATE_REVERSE_STRAND;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -534,6 +628,7 @@ BamRecordImpl& BamRecordImpl::SetPaired(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::PAIRED;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -544,6 +639,7 @@ BamRecordImpl& BamRecordImpl::SetPrimaryAlignment(bool ok)
     } else {
         d_->core.flag |= BamRecordImpl::SECONDARY;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -554,6 +650,7 @@ BamRecordImpl& BamRecordImpl::SetProperPair(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::PROPER_PAIR;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -564,6 +661,7 @@ BamRecordImpl& BamRecordImpl::SetReverseStrand(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::REVERSE_STRAND;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -574,6 +672,7 @@ BamRecordImpl& BamRecordImpl::SetSecondMate(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::MATE_2;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -635,22 +734,17 @@ BamRecordImpl& BamRecordImpl::SetSequenceAndQualitiesInternal(const char* sequen
     if (isPreencoded) {
         std::memcpy(pEncodedSequence, sequence, encodedSequenceLength);
     } else {
-        std::memset(pEncodedSequence, 0, encodedSequenceLength);
-        for (std::size_t i = 0; i < sequenceLength; ++i) {
-            pEncodedSequence[i >> 1] |= seq_nt16_table[static_cast<int>(sequence[i])]
-                                        << ((~i & 1) << 2);
-        }
+        EncodeSequence(sequence, sequenceLength, pEncodedSequence);
     }
 
     // fill in quality values
     std::uint8_t* encodedQualities = bam_get_qual(d_);
-    if ((qualities == nullptr) || (std::strlen(qualities) == 0)) {
+    if ((qualities == nullptr) || (qualities[0] == '\0')) {
         std::memset(encodedQualities, 0xff, sequenceLength);
     } else {
-        for (std::size_t i = 0; i < sequenceLength; ++i) {
-            encodedQualities[i] = qualities[i] - 33;  // FASTQ ASCII -> int conversion
-        }
+        EncodeFastqQualities(qualities, sequenceLength, encodedQualities);
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -661,6 +755,7 @@ BamRecordImpl& BamRecordImpl::SetSupplementaryAlignment(bool ok)
     } else {
         d_->core.flag &= ~BamRecordImpl::SUPPLEMENTARY;
     }
+    UpdateEditStamp();
     return *this;
 }
 
@@ -722,16 +817,80 @@ int BamRecordImpl::TagOffset(const std::string& tagName) const
         UpdateTagMap();
     }
 
-    const std::uint16_t tagCode =
-        (static_cast<std::uint8_t>(tagName.at(0)) << 8) | static_cast<std::uint8_t>(tagName.at(1));
-    for (const auto& tag : tagOffsets_) {
-        if (tag.Code == tagCode) {
-            return tag.Offset;
+    // table is never full, so probing always reaches an empty slot
+    const std::uint16_t tagCode = TagCode(tagName.c_str());
+    const std::size_t mask = tagOffsets_.size() - 1;
+    for (std::size_t slot = TagSlot(tagCode, mask); tagOffsets_[slot].Code != 0;
+         slot = (slot + 1) & mask) {
+        if (tagOffsets_[slot].Code == tagCode) {
+            return tagOffsets_[slot].Offset;
         }
     }
     return -1;  // not found
 }
 
+void BamRecordImpl::InsertTagOffset(const std::uint16_t code, const int offset) const
+{
+    if (2 * (numTags_ + 1) > static_cast<int>(tagOffsets_.size())) {
+        ResizeTagOffsets(std::max(2 * tagOffsets_.size(), MinTagSlots));
+    }
+
+    const std::size_t mask = tagOffsets_.size() - 1;
+    std::size_t slot = TagSlot(code, mask);
+    while (tagOffsets_[slot].Code != 0) {
+        if (tagOffsets_[slot].Code == code) {
+            return;  // keep first occurrence, as htslib lookup does
+        }
+        slot = (slot + 1) & mask;
+    }
+    tagOffsets_[slot] = TagOffsetEntry{code, offset};
+    ++numTags_;
+}
+
+void BamRecordImpl::EraseTagOffset(const std::uint16_t code)
+{
+    const std::size_t mask = tagOffsets_.size() - 1;
+    std::size_t slot = TagSlot(code, mask);
+    while (tagOffsets_[slot].Code != code) {
+        if (tagOffsets_[slot].Code == 0) {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    tagOffsets_[slot] = TagOffsetEntry{};
+    --numTags_;
+
+    // re-insert the remainder of the probe run, so that lookups do not stop at
+    // the newly emptied slot
+    for (slot = (slot + 1) & mask; tagOffsets_[slot].Code != 0; slot = (slot + 1) & mask) {
+        const TagOffsetEntry entry = tagOffsets_[slot];
+        tagOffsets_[slot] = TagOffsetEntry{};
+        --numTags_;
+        InsertTagOffset(entry.Code, entry.Offset);
+    }
+}
+
+void BamRecordImpl::ShiftTagOffsets(const int from, const int diff)
+{
+    for (auto& entry : tagOffsets_) {
+        if (entry.Code != 0 && entry.Offset > from) {
+            entry.Offset += diff;
+        }
+    }
+}
+
+void BamRecordImpl::ResizeTagOffsets(const std::size_t numSlots) const
+{
+    std::vector<TagOffsetEntry> entries(numSlots);
+    entries.swap(tagOffsets_);
+    numTags_ = 0;
+    for (const auto& entry : entries) {
+        if (entry.Code != 0) {
+            InsertTagOffset(entry.Code, entry.Offset);
+        }
+    }
+}
+
 BamRecordImpl& BamRecordImpl::Tags(const TagCollection& tags)
 {
     // convert tags to binary
@@ -754,6 +913,7 @@ BamRecordImpl& BamRecordImpl::Tags(const TagCollection& tags)
 
     // update tag info
     UpdateTagMap();
+    UpdateEditStamp();
     return *this;
 }
 
@@ -791,9 +951,13 @@ Tag BamRecordImpl::TagValue(const BamRecordTag tag) const
     return TagValue(BamRecordTags::LabelFor(tag));
 }
 
+void BamRecordImpl::UpdateEditStamp() { editStamp_ = NextEditStamp(); }
+
 void BamRecordImpl::UpdateTagMap() const
 {
-    tagOffsets_.clear();
+    // keep any table growth from previous records
+    tagOffsets_.assign(std::max(tagOffsets_.size(), MinTagSlots), TagOffsetEntry{});
+    numTags_ = 0;
 
     const std::uint8_t* tagStart = bam_get_aux(d_);
     if (tagStart == nullptr) {
@@ -805,81 +969,16 @@ void BamRecordImpl::UpdateTagMap() const
     // a lot of string constructions & comparisons. All valid tags will be 2 chars
     // anyway, so this should be a nice lookup mechanism.
     //
-    std::uint16_t tagNameCode;
     int i = 0;
     while (i < numBytes) {
 
         // store (tag name code -> start offset into tag data)
-        tagNameCode = static_cast<char>(tagStart[i]) << 8 | static_cast<char>(tagStart[i + 1]);
+        const std::uint16_t tagNameCode = TagCode(reinterpret_cast<const char*>(&tagStart[i]));
         i += 2;
-        tagOffsets_.push_back(TagOffsetEntry{tagNameCode, i});
+        InsertTagOffset(tagNameCode, i);
 
         // skip tag contents
-        const auto tagType = static_cast<char>(tagStart[i++]);
-        switch (tagType) {
-            case 'A':
-            case 'a':
-            case 'c':
-            case 'C': {
-                i += 1;
-                break;
-            }
-            case 's':
-            case 'S': {
-                i += 2;
-                break;
-            }
-            case 'i':
-            case 'I':
-            case 'f': {
-                i += 4;
-                break;
-            }
-
-            case 'Z':
-            case 'H': {
-                // null-terminated string
-                i += std::strlen(reinterpret_cast<const char*>(&tagStart[i])) + 1;
-                break;
-            }
-
-            case 'B': {
-                const char subTagType = tagStart[i++];
-                std::size_t elementSize = 0;
-                switch (subTagType) {
-                    case 'c':
-                    case 'C':
-                        elementSize = 1;
-                        break;
-                    case 's':
-                    case 'S':
-                        elementSize = 2;
-                        break;
-                    case 'i':
-                    case 'I':
-                    case 'f':
-                        elementSize = 4;
-                        break;
-
-                    // unknown subTagType
-                    default:
-                        throw std::runtime_error{
-                            "[pbbam] BAM record ERROR: unsupported array-tag-type encountered: " +
-                            std::string{1, subTagType}};
-                }
-
-                std::uint32_t numElements = 0;
-                std::memcpy(&numElements, &tagStart[i], sizeof(std::uint32_t));
-                i += (4 + (elementSize * numElements));
-                break;
-            }
-
-            // unknown tagType
-            default:
-                throw std::runtime_error{
-                    "[pbbam] BAM record ERROR: unsupported tag-type encountered: " +
-                    std::string{1, tagType}};
-        }
+        i += BamTagCodec::RawDataLength(&tagStart[i]);
     }
 }
 
@@ -0,0 +1,270 @@
+#include "PbbamInternalConfig.h"
+
+#include <pbbam/BamRecordPool.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <vector>
+
+#include <cstdint>
+#include <cstring>
+
+namespace PacBio {
+namespace BAM {
+namespace {
+
+// size class N holds records with data capacity in [2^(N-1), 2^N)
+constexpr int NumSizeClasses = 33;
+
+std::atomic<std::size_t> MaxRecordsPerThread{0};
+std::atomic<std::size_t> MaxSharedRecords{0};
+std::atomic<std::size_t> MaxRecordBytes{BamRecordPool::Config{}.maxRecordBytes};
+
+int SizeClass(const std::uint32_t capacity) { return static_cast<int>(std::bit_width(capacity)); }
+
+// first size class whose records all hold at least 'minBytes'
+int FirstSizeClass(const std::size_t minBytes)
+{
+    if (minBytes == 0) {
+        return 0;
+    }
+    if (minBytes > (std::size_t{1} << (NumSizeClasses - 2))) {
+        return NumSizeClasses - 1;
+    }
+    return static_cast<int>(std::bit_width(minBytes - 1)) + 1;
+}
+
+struct RecordLists
+{
+    std::array<std::vector<bam1_t*>, NumSizeClasses> bySizeClass;
+    std::size_t size = 0;
+
+    // adds record, without taking ownership if this throws
+    void Add(bam1_t* b)
+    {
+        bySizeClass[SizeClass(b->m_data)].push_back(b);
+        ++size;
+    }
+
+    // prefers the smallest record that holds 'minBytes', otherwise the largest
+    // record available
+    bam1_t* Take(const std::size_t minBytes) noexcept
+    {
+        if (size == 0) {
+            return nullptr;
+        }
+        const int first = FirstSizeClass(minBytes);
+        for (int i = first; i < NumSizeClasses; ++i) {
+            if (!bySizeClass[i].empty()) {
+                return PopBack(i);
+            }
+        }
+        for (int i = first - 1; i >= 0; --i) {
+            if (!bySizeClass[i].empty()) {
+                return PopBack(i);
+            }
+        }
+        return nullptr;
+    }
+
+    bam1_t* PopBack(const int sizeClass) noexcept
+    {
+        bam1_t* b = bySizeClass[sizeClass].back();
+        bySizeClass[sizeClass].pop_back();
+        --size;
+        return b;
+    }
+
+    void FreeAll() noexcept
+    {
+        for (auto& records : bySizeClass) {
+            for (bam1_t* b : records) {
+                bam_destroy1(b);
+            }
+            records.clear();
+        }
+        size = 0;
+    }
+};
+
+// Set at thread exit, so that records released afterwards (e.g. by other
+// thread_local objects) are freed directly.
+thread_local bool ThreadCacheDestroyed = false;
+
+struct ThreadCache : RecordLists
+{
+    ~ThreadCache()
+    {
+        ThreadCacheDestroyed = true;
+        FreeAll();
+    }
+};
+
+ThreadCache& LocalCache()
+{
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+struct SharedCache
+{
+    std::mutex mutex;
+    RecordLists records;
+
+    ~SharedCache() { records.FreeAll(); }
+};
+
+SharedCache& Shared()
+{
+    static SharedCache cache;
+    return cache;
+}
+
+// records moved between thread & shared lists at once, to limit locking
+std::size_t TransferBatchSize(const std::size_t maxRecordsPerThread)
+{
+    return std::max<std::size_t>(1, maxRecordsPerThread / 2);
+}
+
+void RefillFromShared(ThreadCache& cache, const std::size_t minBytes,
+                      const std::size_t maxRecordsPerThread)
+{
+    auto& shared = Shared();
+    const std::lock_guard<std::mutex> lock{shared.mutex};
+    const std::size_t batchSize = TransferBatchSize(maxRecordsPerThread);
+    for (std::size_t i = 0; i < batchSize && cache.size < maxRecordsPerThread; ++i) {
+        bam1_t* b = shared.records.Take(minBytes);
+        if (b == nullptr) {
+            break;
+        }
+        try {
+            cache.Add(b);
+        } catch (...) {
+            bam_destroy1(b);
+            break;
+        }
+    }
+}
+
+// moves 'b', plus a batch of same-sized records, to the shared list
+bool SpillToShared(ThreadCache& cache, bam1_t* b, const std::size_t maxRecordsPerThread,
+                   const std::size_t maxSharedRecords)
+{
+    auto& shared = Shared();
+    const std::lock_guard<std::mutex> lock{shared.mutex};
+    if (shared.records.size >= maxSharedRecords) {
+        return false;
+    }
+    shared.records.Add(b);
+
+    auto& records = cache.bySizeClass[SizeClass(b->m_data)];
+    const std::size_t batchSize = TransferBatchSize(maxRecordsPerThread);
+    for (std::size_t i = 1;
+         i < batchSize && !records.empty() && shared.records.size < maxSharedRecords; ++i) {
+        try {
+            shared.records.Add(records.back());
+        } catch (...) {
+            break;
+        }
+        records.pop_back();
+        --cache.size;
+    }
+    return true;
+}
+
+void ResetRecord(bam1_t* b) noexcept
+{
+    std::memset(&b->core, 0, sizeof(b->core));
+    b->l_data = 0;
+}
+
+}  // namespace
+
+bam1_t* BamRecordPool::Acquire(const std::size_t minBytes)
+{
+    const std::size_t maxRecordsPerThread = MaxRecordsPerThread.load(std::memory_order_relaxed);
+    if (maxRecordsPerThread == 0 || ThreadCacheDestroyed) {
+        return bam_init1();
+    }
+
+    auto& cache = LocalCache();
+    bam1_t* b = cache.Take(minBytes);
+    if (b == nullptr && MaxSharedRecords.load(std::memory_order_relaxed) > 0) {
+        RefillFromShared(cache, minBytes, maxRecordsPerThread);
+        b = cache.Take(minBytes);
+    }
+    if (b == nullptr) {
+        return bam_init1();
+    }
+
+    ResetRecord(b);
+    return b;
+}
+
+void BamRecordPool::ClearThreadCache() noexcept
+{
+    if (!ThreadCacheDestroyed) {
+        LocalCache().FreeAll();
+    }
+}
+
+void BamRecordPool::Configure(const Config& config)
+{
+    MaxRecordsPerThread.store(config.maxRecordsPerThread, std::memory_order_relaxed);
+    MaxSharedRecords.store(config.maxSharedRecords, std::memory_order_relaxed);
+    MaxRecordBytes.store(config.maxRecordBytes, std::memory_order_relaxed);
+
+    auto& shared = Shared();
+    const std::lock_guard<std::mutex> lock{shared.mutex};
+    shared.records.FreeAll();
+}
+
+BamRecordPool::Config BamRecordPool::CurrentConfig()
+{
+    Config config;
+    config.maxRecordsPerThread = MaxRecordsPerThread.load(std::memory_order_relaxed);
+    config.maxSharedRecords = MaxSharedRecords.load(std::memory_order_relaxed);
+    config.maxRecordBytes = MaxRecordBytes.load(std::memory_order_relaxed);
+    return config;
+}
+
+std::size_t BamRecordPool::NumThreadCachedRecords()
+{
+    return ThreadCacheDestroyed ? 0 : LocalCache().size;
+}
+
+void BamRecordPool::Release(bam1_t* record) noexcept
+{
+    if (record == nullptr) {
+        return;
+    }
+
+    const std::size_t maxRecordsPerThread = MaxRecordsPerThread.load(std::memory_order_relaxed);
+    if (maxRecordsPerThread == 0 || ThreadCacheDestroyed ||
+        record->m_data > MaxRecordBytes.load(std::memory_order_relaxed)) {
+        bam_destroy1(record);
+        return;
+    }
+
+    try {
+        auto& cache = LocalCache();
+        if (cache.size < maxRecordsPerThread) {
+            cache.Add(record);
+            return;
+        }
+        const std::size_t maxSharedRecords = MaxSharedRecords.load(std::memory_order_relaxed);
+        if (maxSharedRecords > 0 &&
+            SpillToShared(cache, record, maxRecordsPerThread, maxSharedRecords)) {
+            return;
+        }
+    } catch (...) {
+        // fall through, freeing record
+    }
+    bam_destroy1(record);
+}
+
+}  // namespace BAM
+}  // namespace PacBio
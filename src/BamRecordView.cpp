@@ -2,8 +2,115 @@
 
 #include <pbbam/BamRecordView.h>
 
+#include "BamRecordTags.h"
+#include "FrameCodecTable.h"
+#include "MemoryUtils.h"
+#include "SequenceUtils.h"
+
+#include <htslib/sam.h>
+
+#include <stdexcept>
+#include <string_view>
+
+#include <cstring>
+
 namespace PacBio {
 namespace BAM {
+namespace {
+
+constexpr std::int32_t DeletionPosition = -1;
+constexpr std::int32_t PaddingPosition = -2;
+
+///
+/// Maps output positions to genomic query positions, shared by all fields
+/// fetched from a record.
+///
+struct Projection
+{
+    // aligned positions, or null if no clipping/gapping applies
+    const std::vector<std::int32_t>* positions;
+    std::size_t mappedQueryLength;
+
+    // output runs opposite to genomic orientation
+    bool reverseOutput;
+    bool reverseStrand;
+};
+
+const std::uint8_t* RequiredTagData(const bam1_t* b, const BamRecordTag tag)
+{
+    const std::string label = BamRecordTags::LabelFor(tag);
+    const std::uint8_t* data = bam_aux_get(b, label.c_str());
+    if (!data) {
+        throw std::runtime_error{"[pbbam] BAM record ERROR: tag '" + label +
+                                 "' was requested but is missing"};
+    }
+    return data;
+}
+
+std::string_view StringTagData(const bam1_t* b, const BamRecordTag tag)
+{
+    const std::uint8_t* data = RequiredTagData(b, tag);
+    if (data[0] != 'Z' && data[0] != 'H') {
+        throw std::runtime_error{"[pbbam] BAM record ERROR: tag '" +
+                                 BamRecordTags::LabelFor(tag) + "' is not a string"};
+    }
+    return std::string_view{reinterpret_cast<const char*>(data + 1)};
+}
+
+///
+/// Writes a field's \p length stored values to \p out, in output order.
+///
+/// \p storedNative indicates that values are stored in native orientation.
+/// \p value converts a storage index to an output element, while
+/// \p deletionValue & \p paddingValue are used at gapped positions.
+///
+template <typename Container, typename ValueFn>
+void Project(const Projection& proj, const BamRecordTag tag, const std::size_t length,
+             const bool storedNative, const typename Container::value_type deletionValue,
+             const typename Container::value_type paddingValue, ValueFn&& value, Container& out)
+{
+    if (length == 0) {
+        out.clear();
+        return;
+    }
+
+    const bool reverseStored = storedNative && proj.reverseStrand;
+    const auto storageIndex = [&](const std::size_t queryPos) {
+        return reverseStored ? (length - 1 - queryPos) : queryPos;
+    };
+
+    // no CIGAR ops applied, just orient
+    if (!proj.positions) {
+        out.resize(length);
+        for (std::size_t i = 0; i < length; ++i) {
+            const std::size_t queryPos = proj.reverseOutput ? (length - 1 - i) : i;
+            out[i] = value(storageIndex(queryPos));
+        }
+        return;
+    }
+
+    if (length != proj.mappedQueryLength) {
+        throw std::runtime_error{"[pbbam] BAM record ERROR: length of '" +
+                                 BamRecordTags::LabelFor(tag) +
+                                 "' does not match the record's CIGAR"};
+    }
+
+    const auto& positions = *proj.positions;
+    const std::size_t outputLength = positions.size();
+    out.resize(outputLength);
+    for (std::size_t i = 0; i < outputLength; ++i) {
+        const auto queryPos = positions[proj.reverseOutput ? (outputLength - 1 - i) : i];
+        if (queryPos == DeletionPosition) {
+            out[i] = deletionValue;
+        } else if (queryPos == PaddingPosition) {
+            out[i] = paddingValue;
+        } else {
+            out[i] = value(storageIndex(static_cast<std::size_t>(queryPos)));
+        }
+    }
+}
+
+}  // namespace
 
 BamRecordView::BamRecordView(const BamRecord& record, const Data::Orientation orientation,
                              const bool aligned, const bool exciseSoftClips,
@@ -115,6 +222,121 @@ std::string BamRecordView::Sequence() const
     return record_.Sequence(orientation_, aligned_, exciseSoftClips_);
 }
 
+void BamRecordView::Fetch(const Fields& fields) const
+{
+    const auto& impl = record_.Impl();
+    const bam1_t* b = BamRecordMemory::GetRawData(record_).get();
+
+    const bool reverseStrand = impl.IsReverseStrand();
+    const bool applyCigar = impl.IsMapped() && (aligned_ || exciseSoftClips_);
+    if (applyCigar) {
+        UpdatePositionMap();
+    }
+    const Projection proj{applyCigar ? &positions_ : nullptr, mappedQueryLength_,
+                          (orientation_ == Data::Orientation::NATIVE) && reverseStrand,
+                          reverseStrand};
+
+    // SEQ & QUAL are stored in genomic orientation, all tags in native
+    const bool complementSeq = proj.reverseOutput;
+    const bool complementTags = reverseStrand && (orientation_ == Data::Orientation::GENOMIC);
+
+    if (fields.sequence) {
+        if (!applyCigar) {
+            impl.SequenceInto(*fields.sequence, complementSeq);
+        } else {
+            const std::uint8_t* seq = bam_get_seq(b);
+            Project(
+                proj, BamRecordTag::SEQ, b->core.l_qseq, false, '-', '*',
+                [&](const std::size_t i) {
+                    const char base = seq_nt16_str[bam_seqi(seq, i)];
+                    return complementSeq ? Complement(base) : base;
+                },
+                *fields.sequence);
+        }
+    }
+
+    if (fields.qualities) {
+        const std::uint8_t* qual = bam_get_qual(b);
+        const bool hasQuals = (b->core.l_qseq > 0) && (qual[0] != 0xff);
+        Project(
+            proj, BamRecordTag::QUAL, hasQuals ? b->core.l_qseq : 0, false,
+            Data::QualityValue{0}, Data::QualityValue{0},
+            [&](const std::size_t i) { return Data::QualityValue(qual[i]); }, *fields.qualities);
+    }
+
+    const auto fetchBases = [&](const BamRecordTag tag, std::string* out) {
+        if (!out) {
+            return;
+        }
+        const auto text = StringTagData(b, tag);
+        Project(
+            proj, tag, text.size(), true, '-', '*',
+            [&](const std::size_t i) { return complementTags ? Complement(text[i]) : text[i]; },
+            *out);
+    };
+    fetchBases(BamRecordTag::DELETION_TAG, fields.deletionTags);
+    fetchBases(BamRecordTag::SUBSTITUTION_TAG, fields.substitutionTags);
+
+    const auto fetchQualities = [&](const BamRecordTag tag, Data::QualityValues* out) {
+        if (!out) {
+            return;
+        }
+        const auto text = StringTagData(b, tag);
+        Project(
+            proj, tag, text.size(), true, Data::QualityValue{0}, Data::QualityValue{0},
+            [&](const std::size_t i) {
+                return Data::QualityValue(static_cast<std::uint8_t>(text[i] - 33));
+            },
+            *out);
+    };
+    fetchQualities(BamRecordTag::DELETION_QV, fields.deletionQVs);
+    fetchQualities(BamRecordTag::INSERTION_QV, fields.insertionQVs);
+    fetchQualities(BamRecordTag::MERGE_QV, fields.mergeQVs);
+    fetchQualities(BamRecordTag::SUBSTITUTION_QV, fields.substitutionQVs);
+
+    const auto fetchFrames = [&](const BamRecordTag tag, Data::Frames* out) {
+        if (!out) {
+            return;
+        }
+        const std::uint8_t* data = RequiredTagData(b, tag);
+        if (data[0] != 'B') {
+            throw std::runtime_error{"[pbbam] BAM record ERROR: tag '" +
+                                     BamRecordTags::LabelFor(tag) + "' is not an array"};
+        }
+        std::uint32_t length = 0;
+        std::memcpy(&length, data + 2, sizeof(length));
+        const std::uint8_t* values = data + 2 + sizeof(length);
+
+        // lossless frame data
+        if (data[1] == 'S') {
+            Project(
+                proj, tag, length, true, std::uint16_t{0}, std::uint16_t{0},
+                [&](const std::size_t i) {
+                    std::uint16_t frame;
+                    std::memcpy(&frame, values + (i * sizeof(frame)), sizeof(frame));
+                    return frame;
+                },
+                out->DataRaw());
+        }
+
+        // lossy frame codes
+        else if (data[1] == 'C') {
+            const auto codecTables = ReadGroupFrameCodecs(record_);
+            const FrameCodecTable& table =
+                (tag == BamRecordTag::IPD) ? *codecTables.ipd : *codecTables.pulseWidth;
+            Project(
+                proj, tag, length, true, std::uint16_t{0}, std::uint16_t{0},
+                [&](const std::size_t i) { return table.Decode(values[i]); }, out->DataRaw());
+        } else {
+            throw std::runtime_error{"[pbbam] BAM record ERROR: tag '" +
+                                     BamRecordTags::LabelFor(tag) +
+                                     "' is not a std::uint8_t or std::uint16_t array"};
+        }
+    };
+    fetchFrames(BamRecordTag::IPD, fields.ipd);
+    fetchFrames(BamRecordTag::PULSE_WIDTH, fields.pulseWidths);
+}
+
 std::vector<std::uint32_t> BamRecordView::StartFrames() const
 {
     return record_.StartFrame(orientation_, aligned_, exciseSoftClips_, pulseBehavior_);
@@ -130,5 +352,45 @@ std::string BamRecordView::SubstitutionTags() const
     return record_.SubstitutionTag(orientation_, aligned_, exciseSoftClips_);
 }
 
+void BamRecordView::UpdatePositionMap() const
+{
+    const bam1_t* b = BamRecordMemory::GetRawData(record_).get();
+    const std::uint32_t* cigar = bam_get_cigar(b);
+
+    positions_.clear();
+    std::int32_t queryPos = 0;
+    for (std::uint32_t i = 0; i < b->core.n_cigar; ++i) {
+        const auto opType = bam_cigar_op(cigar[i]);
+        const auto opLength = static_cast<std::int32_t>(bam_cigar_oplen(cigar[i]));
+
+        // nothing to do for hard-clipped & ref-skipped positions
+        if (opType == BAM_CHARD_CLIP || opType == BAM_CREF_SKIP) {
+            continue;
+        }
+
+        // maybe skip soft-clipped positions
+        else if (opType == BAM_CSOFT_CLIP && exciseSoftClips_) {
+            queryPos += opLength;
+        }
+
+        // maybe add deletion/padding positions
+        else if (opType == BAM_CDEL || opType == BAM_CPAD) {
+            if (aligned_) {
+                const auto gap = (opType == BAM_CDEL) ? DeletionPosition : PaddingPosition;
+                positions_.insert(positions_.end(), opLength, gap);
+            }
+        }
+
+        // all other CIGAR ops
+        else {
+            for (std::int32_t j = 0; j < opLength; ++j) {
+                positions_.push_back(queryPos + j);
+            }
+            queryPos += opLength;
+        }
+    }
+    mappedQueryLength_ = static_cast<std::size_t>(queryPos);
+}
+
 }  // namespace BAM
 }  // namespace PacBio
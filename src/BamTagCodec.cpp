@@ -383,6 +383,66 @@ Tag BamTagCodec::FromRawData(std::uint8_t* rawData)
     return {};
 }
 
+int BamTagCodec::RawDataLength(const std::uint8_t* rawData)
+{
+    const auto tagType = static_cast<char>(rawData[0]);
+    switch (tagType) {
+        case 'A':
+        case 'a':
+        case 'c':
+        case 'C':
+            return 2;
+        case 's':
+        case 'S':
+            return 3;
+        case 'i':
+        case 'I':
+        case 'f':
+            return 5;
+
+        case 'Z':
+        case 'H':
+            // null-terminated string
+            return 2 + static_cast<int>(std::strlen(reinterpret_cast<const char*>(&rawData[1])));
+
+        case 'B': {
+            const auto subTagType = static_cast<char>(rawData[1]);
+            int elementSize = 0;
+            switch (subTagType) {
+                case 'c':
+                case 'C':
+                    elementSize = 1;
+                    break;
+                case 's':
+                case 'S':
+                    elementSize = 2;
+                    break;
+                case 'i':
+                case 'I':
+                case 'f':
+                    elementSize = 4;
+                    break;
+
+                // unknown subTagType
+                default:
+                    throw std::runtime_error{
+                        "[pbbam] BAM tag format ERROR: unsupported array-tag-type encountered: " +
+                        std::string{1, subTagType}};
+            }
+
+            std::uint32_t numElements = 0;
+            std::memcpy(&numElements, &rawData[2], sizeof(std::uint32_t));
+            return 6 + static_cast<int>(elementSize * numElements);
+        }
+
+        // unknown tagType
+        default:
+            throw std::runtime_error{
+                "[pbbam] BAM tag format ERROR: unsupported tag-type encountered: " +
+                std::string{1, tagType}};
+    }
+}
+
 std::vector<std::uint8_t> BamTagCodec::ToRawData(const Tag& tag,
                                                  const TagModifier& additionalModifier)
 {
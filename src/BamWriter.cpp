@@ -96,21 +96,7 @@ public:
 #if PBBAM_AUTOVALIDATE
         Validator::Validate(record);
 #endif
-
-        const auto& rawRecord = BamRecordMemory::GetRawData(record);
-
-        // (probably) store bins
-        // min_shift=14 & n_lvls=5 are BAM "magic numbers"
-        if (calculateBins_) {
-            rawRecord->core.bin =
-                hts_reg2bin(rawRecord->core.pos, bam_endpos(rawRecord.get()), 14, 5);
-        }
-
-        // write record to file
-        const auto ret = sam_write1(file_.get(), header_.get(), rawRecord.get());
-        if (ret <= 0) {
-            throw BamWriterException{outputFilename_, "could not write record"};
-        }
+        WriteRawData(BamRecordMemory::GetRawData(record).get());
     }
 
     void Write(const BamRecord& record, std::int64_t* vOffset)
@@ -132,7 +118,26 @@ public:
         Write(record);
     }
 
-    void Write(const BamRecordImpl& recordImpl) { Write(BamRecord(recordImpl)); }
+    void Write(const BamRecordImpl& recordImpl)
+    {
+        // no need to wrap in a (copied) BamRecord, just write the raw data
+        WriteRawData(BamRecordMemory::GetRawData(recordImpl).get());
+    }
+
+    void WriteRawData(bam1_t* rawRecord)
+    {
+        // (probably) store bins
+        // min_shift=14 & n_lvls=5 are BAM "magic numbers"
+        if (calculateBins_) {
+            rawRecord->core.bin = hts_reg2bin(rawRecord->core.pos, bam_endpos(rawRecord), 14, 5);
+        }
+
+        // write record to file
+        const auto ret = sam_write1(file_.get(), header_.get(), rawRecord);
+        if (ret <= 0) {
+            throw BamWriterException{outputFilename_, "could not write record"};
+        }
+    }
 
     bool calculateBins_;
     std::unique_ptr<samFile, HtslibFileDeleter> file_;
@@ -4,11 +4,46 @@
 
 #include <pbbam/BamFile.h>
 
+#include <functional>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
 
 namespace PacBio {
 namespace BAM {
+namespace internal {
+
+ReaderReopener MakeReaderReopener(const BamReader& reader, const BamFile& file)
+{
+    if (const auto* pbiReader = dynamic_cast<const PbiIndexedBamReader*>(&reader)) {
+        // resume at the first unread index block
+        return [filter = pbiReader->Filter(), file, index = pbiReader->Index(),
+                blocks = pbiReader->RemainingIndexBlocks()]() -> std::unique_ptr<BamReader> {
+            return std::make_unique<PbiIndexedBamReader>(filter, file, index, blocks);
+        };
+    }
+
+    if (typeid(reader) == typeid(BamReader)) {
+        // resume at the next record's virtual offset
+        return [file, offset = reader.VirtualTell()]() -> std::unique_ptr<BamReader> {
+            auto result = std::make_unique<BamReader>(file);
+            result->VirtualSeek(offset);
+            return result;
+        };
+    }
+
+    // other reader types (e.g. BAI iterators) keep internal state that we
+    // cannot restore
+    return {};
+}
+
+}  // namespace internal
 
 // -----------------------------------
 // GenomicIntervalCompositeBamReader
@@ -21,10 +56,12 @@ GenomicIntervalCompositeBamReader::GenomicIntervalCompositeBamReader(
 
 GenomicIntervalCompositeBamReader::GenomicIntervalCompositeBamReader(
     const std::vector<BamFile>& bamFiles, const BaiIndexCache& cache)
-    : SortedCompositeBamReader<Compare::AlignmentPosition>{bamFiles}, indexCache_{cache}
+    : SortedCompositeBamReader<Compare::AlignmentPosition>{bamFiles, DeferOpen{}}
+    , indexCache_{cache}
+    , idleReaders_(bamFiles.size())
+    , fileReaders_(bamFiles.size(), nullptr)
 {
-    // no interval set, so no valid readers
-    mergeItems_.clear();
+    // no interval set, so no readers opened yet
 }
 
 GenomicIntervalCompositeBamReader::GenomicIntervalCompositeBamReader(const DataSet& dataset)
@@ -67,28 +104,41 @@ const Data::GenomicInterval& GenomicIntervalCompositeBamReader::Interval() const
 GenomicIntervalCompositeBamReader& GenomicIntervalCompositeBamReader::Interval(
     const Data::GenomicInterval& interval)
 {
-    // reset readers
-    mergeItems_.clear();
+    RetargetReaders([&interval](BaiIndexedBamReader& reader) { reader.Interval(interval); });
+    interval_ = interval;
+    return *this;
+}
 
-    // create readers for files
-    container_type updatedMergeItems;
-    std::vector<std::string> missingBai;
-    for (std::size_t i = 0; i < bamFiles_.size(); ++i) {
-        const auto& bamFile = bamFiles_.at(i);
-        if (bamFile.StandardIndexExists()) {
-            internal::CompositeMergeItem item{std::unique_ptr<BamReader>{
-                new BaiIndexedBamReader{interval, bamFile, indexCache_->at(i)}}};
-            if (item.reader->GetNext(item.record)) {
-                updatedMergeItems.insert(std::move(item));
-            }
-            // else not an error, simply no data matching interval
-        } else {
-            // maybe handle PBI-backed interval searches if BAI missing, but for now treat as error
-            missingBai.push_back(bamFile.Filename());
+GenomicIntervalCompositeBamReader& GenomicIntervalCompositeBamReader::Intervals(
+    const std::vector<Data::GenomicInterval>& intervals)
+{
+    RetargetReaders([&intervals](BaiIndexedBamReader& reader) { reader.Intervals(intervals); });
+    interval_ = Data::GenomicInterval{};
+    return *this;
+}
+
+void GenomicIntervalCompositeBamReader::ReleaseReader(std::unique_ptr<BamReader> reader)
+{
+    // return reader to the pool, for re-use by the next interval
+    for (std::size_t i = 0; i < fileReaders_.size(); ++i) {
+        if (fileReaders_[i] == reader.get()) {
+            idleReaders_[i].reset(static_cast<BaiIndexedBamReader*>(reader.release()));
+            return;
         }
     }
+}
 
+void GenomicIntervalCompositeBamReader::RetargetReaders(
+    const std::function<void(BaiIndexedBamReader&)>& retarget)
+{
     // throw if any files missing BAI
+    std::vector<std::string> missingBai;
+    for (const auto& bamFile : bamFiles_) {
+        // maybe handle PBI-backed interval searches if BAI missing, but for now treat as error
+        if (!bamFile.StandardIndexExists()) {
+            missingBai.push_back(bamFile.Filename());
+        }
+    }
     if (!missingBai.empty()) {
         std::ostringstream e;
         e << "[pbbam] composite BAM reader ERROR: failed to open because the following files are "
@@ -99,9 +149,39 @@ GenomicIntervalCompositeBamReader& GenomicIntervalCompositeBamReader::Interval(
         throw std::runtime_error{e.str()};
     }
 
-    // update our actual container and return
-    mergeItems_ = std::move(updatedMergeItems);
-    return *this;
+    // return active readers to the pool
+    while (!mergeItems_.empty()) {
+        auto node = mergeItems_.extract(mergeItems_.begin());
+        ReleaseReader(std::move(node.value().reader));
+    }
+
+    // Re-target each file's reader, opening it only on first use. New items
+    // are only used once all readers are re-targeted. Otherwise, no readers are
+    // left active, rather than a mix of old & new targets.
+    container_type newItems;
+    try {
+        for (std::size_t i = 0; i < bamFiles_.size(); ++i) {
+            auto& reader = idleReaders_.at(i);
+            if (!reader) {
+                reader = std::make_unique<BaiIndexedBamReader>(bamFiles_.at(i), indexCache_->at(i));
+                fileReaders_.at(i) = reader.get();
+            }
+            retarget(*reader);
+
+            // reader stays in the pool if there is no data matching interval
+            BamRecord record;
+            if (reader->GetNext(record)) {
+                newItems.insert(internal::CompositeMergeItem{std::move(reader), std::move(record)});
+            }
+        }
+    } catch (...) {
+        while (!newItems.empty()) {
+            auto node = newItems.extract(newItems.begin());
+            ReleaseReader(std::move(node.value().reader));
+        }
+        throw;
+    }
+    mergeItems_.swap(newItems);
 }
 
 // ------------------------------
@@ -121,12 +201,23 @@ SequentialCompositeBamReader::SequentialCompositeBamReader(const DataSet& datase
 {}
 
 bool SequentialCompositeBamReader::GetNext(BamRecord& record)
+{
+    return GetNextImpl(record, false);
+}
+
+bool SequentialCompositeBamReader::GetNextRaw(BamRecord& record)
+{
+    return GetNextImpl(record, true);
+}
+
+bool SequentialCompositeBamReader::GetNextImpl(BamRecord& record, const bool raw)
 {
     // try first reader, if successful return true
     // else pop reader and try next, until all readers exhausted
     while (!readers_.empty()) {
         auto& reader = readers_.front();
-        if (reader->GetNext(record)) {
+        const bool hasNext = raw ? reader->GetNextRaw(record) : reader->GetNext(record);
+        if (hasNext) {
             return true;
         } else {
             readers_.pop_front();
@@ -2,6 +2,8 @@
 
 #include "FaiZmwChunker.h"
 
+#include "RecordNameParser.h"
+
 #include <algorithm>
 #include <numeric>
 #include <stdexcept>
@@ -15,18 +17,12 @@ namespace {
 
 int32_t HoleNumber(const std::string& name)
 {
-    const auto firstSlash = name.find('/');
-    if (firstSlash == std::string::npos) {
+    const auto holeNumber = ParseRecordName(name).holeNumber;
+    if (!holeNumber) {
         throw std::runtime_error{
             "[pbbam] FAI chunking ERROR: could not parse hole number from name: " + name};
     }
-
-    auto numberEnd = name.find('/', firstSlash + 1);
-    if (numberEnd == std::string::npos) {
-        numberEnd = name.size();
-    }
-
-    return std::stoi(name.substr(firstSlash + 1, (numberEnd - firstSlash)));
+    return *holeNumber;
 }
 
 }  // namespace
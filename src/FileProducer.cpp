@@ -32,9 +32,18 @@ FileProducer::FileProducer(std::string targetFilename, std::string tempFilename)
 
 FileProducer::~FileProducer()
 {
+    if (tempFilename_ == "-") {
+        return;
+    }
+
+    // remove discarded output (e.g. after a failed flush)
+    if (discardTempFile_) {
+        std::remove(tempFilename_.c_str());
+        return;
+    }
+
     // skip renaming if there is a 'live' exception
-    // or if writing to stdout
-    if ((std::current_exception() == nullptr) && (tempFilename_ != "-")) {
+    if (std::current_exception() == nullptr) {
         std::rename(tempFilename_.c_str(), targetFilename_.c_str());
     }
 }
@@ -17,7 +17,9 @@ namespace BAM {
 // FileProducer's destructor will ensure that the temp file will be renamed to
 // the target filename.
 //
-// If destruction is triggered by an exception, no renaming will occur.
+// If destruction is triggered by an exception, no renaming will occur. Derived
+// classes may also call DiscardTempFile() (e.g. if a final flush fails), to
+// remove the temp file instead.
 //
 class FileProducer
 {
@@ -44,9 +46,14 @@ public:
     const std::string& TargetFilename() const { return targetFilename_; }
     const std::string& TempFilename() const { return tempFilename_; }
 
+protected:
+    // Removes the temp file on destruction, rather than renaming it.
+    void DiscardTempFile() { discardTempFile_ = true; }
+
 private:
     std::string targetFilename_;
     std::string tempFilename_;
+    bool discardTempFile_ = false;
 };
 
 }  // namespace BAM
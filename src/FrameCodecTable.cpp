@@ -0,0 +1,166 @@
+#include "PbbamInternalConfig.h"
+
+#include "FrameCodecTable.h"
+
+#include <pbbam/BamRecord.h>
+#include "MemoryUtils.h"
+
+#include <htslib/sam.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string_view>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PBBAM_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace PacBio {
+namespace BAM {
+namespace {
+
+constexpr std::size_t NumFrameValues = 1 << 16;
+
+void DecodeScalar(const std::uint8_t* codes, const std::size_t length, std::uint16_t* frames,
+                  const std::uint32_t* lookup)
+{
+    for (std::size_t i = 0; i < length; ++i) {
+        frames[i] = static_cast<std::uint16_t>(lookup[codes[i]]);
+    }
+}
+
+#ifdef PBBAM_X86_KERNELS
+
+// 16 codes -> 16 frames per iteration
+__attribute__((target("avx2"))) void DecodeAvx2(const std::uint8_t* codes,
+                                                const std::size_t length, std::uint16_t* frames,
+                                                const std::uint32_t* lookup)
+{
+    const auto* table = reinterpret_cast<const int*>(lookup);
+
+    std::size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i));
+        const __m256i first = _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(bytes), 4);
+        const __m256i second =
+            _mm256_i32gather_epi32(table, _mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)), 4);
+
+        // pack works within 128-bit lanes, so restore order across lanes
+        const __m256i packed =
+            _mm256_permute4x64_epi64(_mm256_packus_epi32(first, second), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(frames + i), packed);
+    }
+    DecodeScalar(codes + i, length - i, frames + i, lookup);
+}
+
+#endif  // PBBAM_X86_KERNELS
+
+struct TableCache
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<FrameCodecTable>> tables;
+};
+
+TableCache& Tables()
+{
+    static TableCache cache;
+    return cache;
+}
+
+}  // namespace
+
+FrameCodecTable::FrameCodecTable(const Data::FrameEncoder& encoder)
+{
+    std::vector<std::uint8_t> codes(decode_.size());
+    std::iota(codes.begin(), codes.end(), 0);
+    const auto decoded = encoder.Decode(codes).Data();
+    std::copy(decoded.cbegin(), decoded.cend(), decode_.begin());
+
+    std::vector<std::uint16_t> frames(NumFrameValues);
+    std::iota(frames.begin(), frames.end(), 0);
+    encode_ = encoder.Encode(frames);
+
+    preservesCodes_ = true;
+    for (std::size_t code = 0; code < decode_.size(); ++code) {
+        if (encode_[decode_[code]] != code) {
+            preservesCodes_ = false;
+            break;
+        }
+    }
+}
+
+void FrameCodecTable::Decode(const std::uint8_t* codes, const std::size_t length,
+                             std::uint16_t* frames) const
+{
+    Decode(codes, length, frames, DetectedSimdLevel());
+}
+
+void FrameCodecTable::Decode(const std::uint8_t* codes, const std::size_t length,
+                             std::uint16_t* frames, const SimdLevel level) const
+{
+#ifdef PBBAM_X86_KERNELS
+    if (std::min(level, DetectedSimdLevel()) == SimdLevel::AVX2) {
+        DecodeAvx2(codes, length, frames, decode_.data());
+        return;
+    }
+#else
+    static_cast<void>(level);
+#endif
+    DecodeScalar(codes, length, frames, decode_.data());
+}
+
+std::vector<std::uint16_t> FrameCodecTable::Decode(const std::vector<std::uint8_t>& codes) const
+{
+    std::vector<std::uint16_t> frames(codes.size());
+    Decode(codes.data(), codes.size(), frames.data());
+    return frames;
+}
+
+std::vector<std::uint8_t> FrameCodecTable::Encode(const std::vector<std::uint16_t>& frames) const
+{
+    std::vector<std::uint8_t> codes(frames.size());
+    std::transform(frames.cbegin(), frames.cend(), codes.begin(),
+                   [this](const std::uint16_t f) { return encode_[f]; });
+    return codes;
+}
+
+const FrameCodecTable& FrameCodecTable::For(const Data::FrameEncoder& encoder)
+{
+    // Read groups with equivalent codecs share a table. This runs once per read
+    // group (per header), so building the candidate up front is fine.
+    FrameCodecTable candidate{encoder};
+
+    auto& cache = Tables();
+    const std::lock_guard<std::mutex> lock{cache.mutex};
+    for (const auto& table : cache.tables) {
+        if (table->decode_ == candidate.decode_ && table->encode_ == candidate.encode_) {
+            return *table;
+        }
+    }
+    cache.tables.push_back(std::make_unique<FrameCodecTable>(std::move(candidate)));
+    return *cache.tables.back();
+}
+
+const FrameCodecTable& FrameCodecTable::V1()
+{
+    static const FrameCodecTable& table = For(Data::V1FrameEncoder{});
+    return table;
+}
+
+FrameCodecTables ReadGroupFrameCodecs(const BamRecord& record)
+{
+    const auto& b = BamRecordMemory::GetRawData(record);
+    const std::uint8_t* rg = bam_aux_get(b.get(), "RG");
+    if (rg == nullptr || rg[0] != 'Z') {
+        // fallback to V1 in corner cases w/ no read group set
+        return FrameCodecTables{&FrameCodecTable::V1(), &FrameCodecTable::V1()};
+    }
+    return BamHeaderMemory::FrameCodecs(BamRecordMemory::GetHeader(record),
+                                        std::string_view{reinterpret_cast<const char*>(rg + 1)});
+}
+
+}  // namespace BAM
+}  // namespace PacBio
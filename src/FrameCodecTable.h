@@ -0,0 +1,88 @@
+#ifndef PBBAM_FRAMECODECTABLE_H
+#define PBBAM_FRAMECODECTABLE_H
+
+#include <pbbam/Config.h>
+
+#include "SequenceCodec.h"
+
+#include <pbcopper/data/FrameEncoders.h>
+
+#include <array>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace BAM {
+
+class BamRecord;
+
+///
+/// Lookup tables for a lossy frame codec (V1, or V2 with given bit widths),
+/// built once from its Data::FrameEncoder and shared process-wide.
+///
+/// Decoding maps each 8-bit code through a 256-entry table (with AVX2 gathers,
+/// where supported). Encoding maps each 16-bit frame count through a 64K-entry
+/// table, so is branch-free. Output matches the encoder's own Decode/Encode.
+///
+class FrameCodecTable
+{
+public:
+    /// \returns shared table for \p encoder, built on first use
+    static const FrameCodecTable& For(const Data::FrameEncoder& encoder);
+
+    /// \returns shared table for the V1 codec
+    static const FrameCodecTable& V1();
+
+    explicit FrameCodecTable(const Data::FrameEncoder& encoder);
+
+    std::uint16_t Decode(const std::uint8_t code) const { return decode_[code]; }
+
+    ///
+    /// \brief Decodes \p length codes into \p frames (which must hold at least
+    ///        \p length values).
+    ///
+    void Decode(const std::uint8_t* codes, std::size_t length, std::uint16_t* frames) const;
+    void Decode(const std::uint8_t* codes, std::size_t length, std::uint16_t* frames,
+                SimdLevel level) const;
+
+    std::vector<std::uint16_t> Decode(const std::vector<std::uint8_t>& codes) const;
+
+    std::uint8_t Encode(const std::uint16_t frames) const { return encode_[frames]; }
+
+    std::vector<std::uint8_t> Encode(const std::vector<std::uint16_t>& frames) const;
+
+    /// \returns true if decoding, then re-encoding, returns the original code
+    ///          for all codes. Lossy data may then be copied or clipped as-is.
+    bool PreservesCodes() const { return preservesCodes_; }
+
+private:
+    // widened to 32 bits for gathers
+    std::array<std::uint32_t, 256> decode_;
+    std::vector<std::uint8_t> encode_;  // indexed by frame count
+    bool preservesCodes_;
+};
+
+///
+/// Frame codec tables for a read group's IPD & pulse width tags
+///
+struct FrameCodecTables
+{
+    const FrameCodecTable* ipd;
+    const FrameCodecTable* pulseWidth;
+};
+
+///
+/// \returns codec tables for \p record's read group, resolved once per read
+///          group by its header. Each thread also keeps the last result, so
+///          runs of records from one read group skip the header's lock. Falls
+///          back to V1 if the record has no read group, or it is missing from
+///          the header.
+///
+FrameCodecTables ReadGroupFrameCodecs(const BamRecord& record);
+
+}  // namespace BAM
+}  // namespace PacBio
+
+#endif  // PBBAM_FRAMECODECTABLE_H
@@ -4,8 +4,11 @@
 
 #include <pbbam/Deleters.h>
 
+#include <htslib/sam.h>
+
 #include <string>
 
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 
@@ -46,5 +49,24 @@ std::shared_ptr<bam_hdr_t> BamHeaderMemory::MakeRawHeader(const BamHeader& heade
     return rawData;
 }
 
+std::int64_t BamRecordMemory::EncodedLength(const bam1_t* b)
+{
+    const auto* c = &b->core;
+    constexpr std::int64_t FIXED_LENGTH = 36;
+    const std::int64_t qnameLength = (c->l_qname - c->l_extranul);
+
+    std::int64_t remainingLength = 0;
+    if (c->n_cigar <= 0xffff) {
+        remainingLength = (b->l_data - c->l_qname);
+    } else {
+        // 2-op placeholder CIGAR, then seq/qual/tags, then the 'CG' tag:
+        // "CGBI", its element count, & the actual CIGAR
+        const std::int64_t cigarEnd =
+            (reinterpret_cast<const std::uint8_t*>(bam_get_cigar(b)) - b->data) + (c->n_cigar * 4);
+        remainingLength = 8 + (b->l_data - cigarEnd) + 8 + (4 * c->n_cigar);
+    }
+    return FIXED_LENGTH + qnameLength + remainingLength;
+}
+
 }  // namespace BAM
 }  // namespace PacBio
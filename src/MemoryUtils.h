@@ -8,15 +8,34 @@
 #include <pbbam/BamRecordImpl.h>
 
 #include <memory>
+#include <string_view>
+
+#include <cstdint>
 
 namespace PacBio {
 namespace BAM {
 
+struct FrameCodecTables;
+
 class BamHeaderMemory
 {
 public:
     static BamHeader FromRawData(bam_hdr_t* header);
     static std::shared_ptr<bam_hdr_t> MakeRawHeader(const BamHeader& header);
+
+    // Frame codec tables for a read group, cached by the header's (shared)
+    // data & per thread. Defined in BamHeader.cpp.
+    static FrameCodecTables FrameCodecs(const BamHeader& header, std::string_view readGroupId);
+
+    // Assigns \p source to \p target, unless they already share data. Readers
+    // reuse records, so this skips the (atomic) reference count update for
+    // all but the first record read.
+    static void Share(const BamHeader& source, BamHeader& target)
+    {
+        if (target.d_ != source.d_) {
+            target = source;
+        }
+    }
 };
 
 class BamRecordMemory
@@ -30,8 +49,17 @@ public:
     static const auto& GetRawData(const BamRecord& r) { return GetRawData(r.impl_); }
     static const auto& GetRawData(const BamRecord* r) { return GetRawData(r->impl_); }
 
+    static const BamHeader& GetHeader(const BamRecord& r) { return r.header_; }
+
+    // Length of the record as encoded by bam_write1(), including its
+    // block_size field. Overlong CIGARs are moved to the 'CG' tag on write.
+    static std::int64_t EncodedLength(const bam1_t* b);
+
     static void UpdateRecordTags(const BamRecord& r) { UpdateRecordTags(r.impl_); }
     static void UpdateRecordTags(const BamRecordImpl& r) { r.UpdateTagMap(); }
+
+    static void ClearRecordTags(const BamRecord& r) { ClearRecordTags(r.impl_); }
+    static void ClearRecordTags(const BamRecordImpl& r) { r.tagOffsets_.clear(); }
 };
 
 }  // namespace BAM
@@ -133,15 +133,14 @@ void PbiBuilderBase::AddMappedData(const BamRecord& b)
     }();
 
     // alignment quality
-    const auto matchData = b.NumMatchesAndMismatches();
-    const auto nM = static_cast<std::uint32_t>(matchData.first);
-    const auto nMM = static_cast<std::uint32_t>(matchData.second);
+    const auto& cigarStats = b.CigarStatistics();
+    const auto nM = static_cast<std::uint32_t>(cigarStats.numMatches);
+    const auto nMM = static_cast<std::uint32_t>(cigarStats.numMismatches);
     const auto mapQuality = b.MapQuality();
 
     // indel operations
-    const auto indelOps = b.NumInsertionAndDeletionOperations();
-    const auto nInsOps = indelOps.first;
-    const auto nDelOps = indelOps.second;
+    const auto nInsOps = cigarStats.numInsertionOperations;
+    const auto nDelOps = cigarStats.numDeletionOperations;
 
     if (tId >= 0) {
         hasMappedData_ = true;
@@ -163,8 +162,9 @@ void PbiBuilderBase::AddMappedData(const BamRecord& b)
 
 void PbiBuilderBase::AddRecord(const BamRecord& b, std::int64_t uOffset)
 {
-    // ensure updated data (necessary?)
-    BAM::BamRecordMemory::UpdateRecordTags(b);
+    // Tag offsets are either current, or (for records fetched via
+    // BamReader::GetNextRaw) computed lazily on first lookup below. No need to
+    // force a rescan of the tag data here.
     b.ResetCachedPositions();
 
     // store record data & maybe flush to temp file
@@ -4,6 +4,7 @@
 
 #include <pbbam/RecordType.h>
 #include <pbbam/StringUtilities.h>
+#include "RecordNameParser.h"
 
 #include <boost/algorithm/string.hpp>
 
@@ -437,47 +438,40 @@ public:
 
     void HandleName(const std::string& queryName, const RecordType type)
     {
-        const auto nameParts = Split(queryName, '/');
-        if (std::ssize(nameParts) < 2) {
+        const auto name = ParseRecordName(queryName);
+        if (name.holeNumberText.empty()) {
             throw std::runtime_error{"[pbbam] PBI filter ERROR: requested QNAME (" + queryName +
                                      ") is not a valid PacBio BAM QNAME. See spec for details"};
         }
+        if (!name.holeNumber) {
+            throw std::runtime_error{"[pbbam] PBI filter ERROR: requested QNAME (" + queryName +
+                                     ") is not a valid PacBio BAM QNAME. ZMW id must be a number."};
+        }
+        const std::int32_t zmwId = *name.holeNumber;
 
         // generate candidate read group IDs from movie name & record type, then
         // add to lookup table
-        const std::shared_ptr<ZmwData> zmw = UpdateRgLookup(CandidateRgIds(nameParts.at(0), type));
+        const std::shared_ptr<ZmwData> zmw =
+            UpdateRgLookup(CandidateRgIds(std::string{name.movieName}, type));
 
         // add ZMW to read group. Add qStart/qEnd to ZMW if not a CCS/transcript record
-        const auto zmwId = [&]() {
-            try {
-                return std::stoi(nameParts.at(1));
-            } catch (const std::invalid_argument&) {
-                throw std::runtime_error{
-                    "[pbbam] PBI filter ERROR: requested QNAME (" + queryName +
-                    ") is not a valid PacBio BAM QNAME. ZMW id must be a number."};
-            }
-        }();
         if (IsCcsOrTranscript(type)) {
             // normal CCS and TRANSCRIPT types have no interval
             zmw->emplace(zmwId, std::optional<QueryIntervals>{});
         } else {
 
-            const auto queryIntervalParts = Split(nameParts.back(), '_');
-            if (std::ssize(queryIntervalParts) != 2) {
-                throw std::runtime_error{"[pbbam] PBI filter ERROR: requested QNAME (" + queryName +
-                                         ") is not a valid PacBio BAM QNAME. See spec for details"};
-            }
-
-            const auto queryInterval = [&]() {
-                try {
-                    return std::make_pair(std::stoi(queryIntervalParts.at(0)),
-                                          std::stoi(queryIntervalParts.at(1)));
-                } catch (const std::invalid_argument&) {
+            if (!name.queryInterval) {
+                const auto lastSlash = queryName.rfind('/');
+                if (queryName.find('_', lastSlash) == std::string::npos) {
                     throw std::runtime_error{
                         "[pbbam] PBI filter ERROR: requested QNAME (" + queryName +
-                        ") is not a valid PacBio BAM QNAME. qStart/qEnd must be numbers."};
+                        ") is not a valid PacBio BAM QNAME. See spec for details"};
                 }
-            }();
+                throw std::runtime_error{
+                    "[pbbam] PBI filter ERROR: requested QNAME (" + queryName +
+                    ") is not a valid PacBio BAM QNAME. qStart/qEnd must be numbers."};
+            }
+            const QueryInterval queryInterval = *name.queryInterval;
 
             const auto zmwResult = zmw->emplace(zmwId, QueryIntervals{});
             const auto zmwIter = zmwResult.first;
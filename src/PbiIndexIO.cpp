@@ -12,7 +12,9 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
 #include <array>
+#include <memory>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
@@ -70,11 +72,8 @@ void CheckExpectedSize(const PbiRawMappedData& mappedData, const std::size_t num
     }
 }
 
-}  // namespace
-
-void PbiIndexIO::LoadFromFile(PbiRawData& rawData, const std::string& filename)
+std::unique_ptr<BGZF, HtslibBgzfDeleter> OpenPbiFile(const std::string& filename)
 {
-    // open file for reading
     if (!boost::algorithm::iends_with(filename, ".pbi")) {
         std::ostringstream msg;
         msg << "[pbbam] PBI index I/O ERROR: unsupported file extension:\n"
@@ -83,14 +82,22 @@ void PbiIndexIO::LoadFromFile(PbiRawData& rawData, const std::string& filename)
     }
 
     std::unique_ptr<BGZF, HtslibBgzfDeleter> bgzf(bgzf_open(filename.c_str(), "rb"));
-    auto* fp = bgzf.get();
-    if (fp == nullptr) {
+    if (!bgzf) {
         std::ostringstream msg;
         msg << "[pbbam] PBI index I/O ERROR: could not open file for reading:\n"
             << "  file: " << filename;
         MaybePrintErrnoReason(msg);
         throw std::runtime_error{msg.str()};
     }
+    return bgzf;
+}
+
+}  // namespace
+
+void PbiIndexIO::LoadFromFile(PbiRawData& rawData, const std::string& filename)
+{
+    const auto bgzf = OpenPbiFile(filename);
+    auto* fp = bgzf.get();
 
     // load data
     LoadHeader(rawData, fp);
@@ -285,6 +292,35 @@ void PbiIndexIO::LoadHeader(PbiRawData& index, BGZF* fp)
     bytesRead = bgzf_read(fp, &reserved, reservedLength);
 }
 
+PbiIndexIO::HoleNumberRange PbiIndexIO::LoadHoleNumberRange(const std::string& filename)
+{
+    const auto bgzf = OpenPbiFile(filename);
+    auto* fp = bgzf.get();
+
+    PbiRawData header;
+    LoadHeader(header, fp);
+
+    HoleNumberRange result;
+    result.numReads = header.NumReads();
+
+    // hole numbers follow the rgId, qStart, & qEnd columns, all 32-bit
+    constexpr std::uint32_t ChunkSize = 1 << 16;
+    std::vector<std::int32_t> chunk;
+    for (int column = 0; column < 4; ++column) {
+        const bool isHoleNumber = (column == 3);
+        for (std::uint32_t begin = 0; begin < result.numReads; begin += ChunkSize) {
+            const auto length = std::min(ChunkSize, result.numReads - begin);
+            LoadBgzfVector(fp, chunk, length);
+            if (isHoleNumber) {
+                const auto [first, last] = std::minmax_element(chunk.cbegin(), chunk.cend());
+                result.first = std::min(result.first, *first);
+                result.last = std::max(result.last, *last);
+            }
+        }
+    }
+    return result;
+}
+
 void PbiIndexIO::LoadMappedData(PbiRawMappedData& mappedData, const std::uint32_t numReads,
                                 BGZF* fp)
 {
@@ -401,7 +437,7 @@ void PbiIndexIO::WriteHeader(const PbiRawData& index, BGZF* fp)
     // version, pbi_flags, & n_reads
     auto version = static_cast<std::uint32_t>(index.Version());
     std::uint16_t pbi_flags = index.FileSections();
-    auto numReads = static_cast<std::uint16_t>(index.NumReads());
+    std::uint32_t numReads = index.NumReads();
     if (fp->is_be) {
         version = ed_swap_4(version);
         pbi_flags = ed_swap_2(pbi_flags);
@@ -11,6 +11,7 @@
 #include <htslib/bgzf.h>
 #include <htslib/sam.h>
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -26,11 +27,22 @@ namespace BAM {
 class PbiIndexIO
 {
 public:
+    struct HoleNumberRange
+    {
+        std::int32_t first = std::numeric_limits<std::int32_t>::max();
+        std::int32_t last = std::numeric_limits<std::int32_t>::min();
+        std::uint32_t numReads = 0;
+    };
+
     // top-level entry points
     static void LoadFromFile(PbiRawData& rawData, const std::string& filename);
     static void LoadFromDataSet(PbiRawData& aggregateData, const DataSet& dataset);
     static void Save(const PbiRawData& rawData, const std::string& filename);
 
+    // Smallest & largest ZMW hole numbers in a PBI file, streamed in chunks
+    // rather than loading the index.
+    static HoleNumberRange LoadHoleNumberRange(const std::string& filename);
+
     // per-component load
     static void LoadBarcodeData(PbiRawBarcodeData& barcodeData, std::uint32_t numReads, BGZF* fp);
     static void LoadHeader(PbiRawData& index, BGZF* fp);
@@ -6,6 +6,8 @@
 
 #include <htslib/bgzf.h>
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 #include <stdexcept>
 
@@ -15,6 +17,39 @@
 namespace PacBio {
 namespace BAM {
 
+namespace {
+
+IndexResultBlocks MergedIndexBlocks(IndexList indices)
+{
+    if (indices.empty()) {
+        return {};
+    }
+
+    std::sort(indices.begin(), indices.end());
+    const auto newEndIter = std::unique(indices.begin(), indices.end());
+    const auto numIndices = std::distance(indices.begin(), newEndIter);
+    auto result = IndexResultBlocks{IndexResultBlock{indices.at(0), 1}};
+    for (auto i = 1; i < numIndices; ++i) {
+        if (indices.at(i) == indices.at(i - 1) + 1) {
+            ++result.back().numReads_;
+        } else {
+            result.emplace_back(indices.at(i), 1);
+        }
+    }
+    return result;
+}
+
+std::uint32_t NumReadsInBlocks(const IndexResultBlocks& blocks)
+{
+    std::uint32_t result = 0;
+    for (const auto& block : blocks) {
+        result += block.numReads_;
+    }
+    return result;
+}
+
+}  // namespace
+
 class PbiIndexedBamReader::PbiIndexedBamReaderPrivate
 {
 public:
@@ -22,64 +57,18 @@ public:
         : file_{std::move(file)}, index_{index}, currentBlockReadCount_{0}, numMatchingReads_{0}
     {}
 
-    void ApplyOffsets()
+    void Filter(const PbiFilter filter)
     {
-        const auto& fileOffsets = index_->BasicData().fileOffset_;
-        for (IndexResultBlock& block : blocks_) {
-            block.virtualOffset_ = fileOffsets.at(block.firstIndex_);
-        }
+        Filter(filter, MatchingIndexBlocks(filter, *index_));
     }
 
-    void Filter(const PbiFilter filter)
+    void Filter(PbiFilter filter, IndexResultBlocks blocks)
     {
         // store request & reset counters
         filter_ = std::move(filter);
         currentBlockReadCount_ = 0;
-        blocks_.clear();
-        numMatchingReads_ = 0;
-
-        // find blocks of reads passing filter criteria
-        const auto totalReads = index_->NumReads();
-        if (totalReads == 0) {  // empty PBI - no reads to use
-            return;
-        } else if (filter_.IsEmpty()) {  // empty filter - use all reads
-            numMatchingReads_ = totalReads;
-            blocks_.emplace_back(0, totalReads);
-        } else {
-            IndexList indices;
-            indices.reserve(totalReads);
-            const auto& idx = *index_;
-            for (std::size_t i = 0; i < totalReads; ++i) {
-                if (filter_.Accepts(idx, i)) {
-                    indices.push_back(i);
-                    ++numMatchingReads_;
-                }
-            }
-            blocks_ = MergedIndexBlocks(std::move(indices));
-        }
-
-        // apply offsets
-        ApplyOffsets();
-    }
-
-    IndexResultBlocks MergedIndexBlocks(IndexList indices) const
-    {
-        if (indices.empty()) {
-            return {};
-        }
-
-        std::sort(indices.begin(), indices.end());
-        const auto newEndIter = std::unique(indices.begin(), indices.end());
-        const auto numIndices = std::distance(indices.begin(), newEndIter);
-        auto result = IndexResultBlocks{IndexResultBlock{indices.at(0), 1}};
-        for (auto i = 1; i < numIndices; ++i) {
-            if (indices.at(i) == indices.at(i - 1) + 1) {
-                ++result.back().numReads_;
-            } else {
-                result.emplace_back(indices.at(i), 1);
-            }
-        }
-        return result;
+        blocks_ = std::move(blocks);
+        numMatchingReads_ = NumReadsInBlocks(blocks_);
     }
 
     int ReadRawData(BGZF* bgzf, bam1_t* b)
@@ -145,6 +134,14 @@ PbiIndexedBamReader::PbiIndexedBamReader(PbiFilter filter, BamFile bamFile,
     Filter(std::move(filter));
 }
 
+PbiIndexedBamReader::PbiIndexedBamReader(PbiFilter filter, BamFile bamFile,
+                                         const std::shared_ptr<PbiRawData>& index,
+                                         IndexResultBlocks blocks)
+    : PbiIndexedBamReader{std::move(bamFile), index}
+{
+    d_->Filter(std::move(filter), std::move(blocks));
+}
+
 PbiIndexedBamReader::PbiIndexedBamReader(const std::string& bamFilename)
     : PbiIndexedBamReader{BamFile{bamFilename}}
 {}
@@ -154,14 +151,14 @@ PbiIndexedBamReader::PbiIndexedBamReader(const std::string& bamFilename,
     : PbiIndexedBamReader{BamFile{bamFilename}, index}
 {}
 
-PbiIndexedBamReader::PbiIndexedBamReader(BamFile bamFile) : BamReader{bamFile.Filename()}
+PbiIndexedBamReader::PbiIndexedBamReader(BamFile bamFile) : BamReader{bamFile}
 {
     auto indexCache = MakePbiIndexCache(bamFile);
     d_ = std::make_unique<PbiIndexedBamReaderPrivate>(std::move(bamFile), indexCache->at(0));
 }
 
 PbiIndexedBamReader::PbiIndexedBamReader(BamFile bamFile, const std::shared_ptr<PbiRawData>& index)
-    : BamReader{bamFile.Filename()}
+    : BamReader{bamFile}
     , d_{std::make_unique<PbiIndexedBamReaderPrivate>(std::move(bamFile), index)}
 {}
 
@@ -183,8 +180,51 @@ PbiIndexedBamReader& PbiIndexedBamReader::Filter(PbiFilter filter)
 
 const IndexResultBlocks& PbiIndexedBamReader::IndexBlocks() const { return d_->blocks_; }
 
+IndexResultBlocks PbiIndexedBamReader::RemainingIndexBlocks() const
+{
+    auto result = d_->blocks_;
+    if (!result.empty() && d_->currentBlockReadCount_ > 0) {
+        auto& block = result.front();
+        block.firstIndex_ += d_->currentBlockReadCount_;
+        block.numReads_ -= d_->currentBlockReadCount_;
+        block.virtualOffset_ = d_->index_->BasicData().fileOffset_.at(block.firstIndex_);
+    }
+    return result;
+}
+
+const std::shared_ptr<PbiRawData>& PbiIndexedBamReader::Index() const { return d_->index_; }
+
 uint32_t PbiIndexedBamReader::NumReads() const { return d_->numMatchingReads_; }
 
+IndexResultBlocks PbiIndexedBamReader::MatchingIndexBlocks(const PbiFilter& filter,
+                                                           const PbiRawData& index)
+{
+    // find blocks of reads passing filter criteria
+    IndexResultBlocks result;
+    const auto totalReads = index.NumReads();
+    if (totalReads == 0) {  // empty PBI - no reads to use
+        return result;
+    } else if (filter.IsEmpty()) {  // empty filter - use all reads
+        result.emplace_back(0, totalReads);
+    } else {
+        IndexList indices;
+        indices.reserve(totalReads);
+        for (std::size_t i = 0; i < totalReads; ++i) {
+            if (filter.Accepts(index, i)) {
+                indices.push_back(i);
+            }
+        }
+        result = MergedIndexBlocks(std::move(indices));
+    }
+
+    // apply offsets
+    const auto& fileOffsets = index.BasicData().fileOffset_;
+    for (IndexResultBlock& block : result) {
+        block.virtualOffset_ = fileOffsets.at(block.firstIndex_);
+    }
+    return result;
+}
+
 int PbiIndexedBamReader::ReadRawData(samFile* sf, bam1_t* b)
 {
     return d_->ReadRawData(sf->fp.bgzf, b);
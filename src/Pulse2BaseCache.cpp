@@ -0,0 +1,150 @@
+#include "PbbamInternalConfig.h"
+
+#include "Pulse2BaseCache.h"
+
+#include "SequenceCodec.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PBBAM_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace PacBio {
+namespace BAM {
+namespace {
+
+bool IsUpper(const char c) { return static_cast<unsigned char>(c - 'A') < 26; }
+
+// one mask bit per pulse call, set for basecalls (uppercase)
+std::uint64_t ScalarMask(const char* pulseCalls, const std::size_t length)
+{
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        mask |= static_cast<std::uint64_t>(IsUpper(pulseCalls[i])) << i;
+    }
+    return mask;
+}
+
+#ifdef PBBAM_X86_KERNELS
+
+// Shifts 'A'-'Z' to the bottom of the signed byte range, so a single signed
+// compare finds uppercase.
+__attribute__((target("sse4.1"))) std::uint64_t SseMask(const char* pulseCalls)
+{
+    const __m128i shift = _mm_set1_epi8(static_cast<char>(0x80 - 'A'));
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(0x80 + 26));
+
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 64; i += 16) {
+        const __m128i calls = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pulseCalls + i));
+        const __m128i isUpper = _mm_cmplt_epi8(_mm_add_epi8(calls, shift), limit);
+        const auto bits = static_cast<std::uint16_t>(_mm_movemask_epi8(isUpper));
+        mask |= static_cast<std::uint64_t>(bits) << i;
+    }
+    return mask;
+}
+
+__attribute__((target("avx2"))) std::uint64_t Avx2Mask(const char* pulseCalls)
+{
+    const __m256i shift = _mm256_set1_epi8(static_cast<char>(0x80 - 'A'));
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(0x80 + 26));
+
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 64; i += 32) {
+        const __m256i calls =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pulseCalls + i));
+        const __m256i isUpper = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(calls, shift));
+        const auto bits = static_cast<std::uint32_t>(_mm256_movemask_epi8(isUpper));
+        mask |= static_cast<std::uint64_t>(bits) << i;
+    }
+    return mask;
+}
+
+#endif  // PBBAM_X86_KERNELS
+
+// in-word select: position of the k-th (0-based) set bit
+int SelectInWord(std::uint64_t word, std::size_t k)
+{
+    while (k > 0) {
+        word &= (word - 1);
+        --k;
+    }
+    return std::countr_zero(word);
+}
+
+}  // namespace
+
+Pulse2BaseCache::Pulse2BaseCache(const std::string_view pulseCalls)
+    : numPulses_{pulseCalls.size()}, numBases_{0}
+{
+    const std::size_t numWords = (numPulses_ + 63) / 64;
+    const std::size_t numFullWords = numPulses_ / 64;
+    words_.resize(numWords);
+    ranks_.resize(numWords);
+
+    const char* data = pulseCalls.data();
+    std::size_t i = 0;
+#ifdef PBBAM_X86_KERNELS
+    const SimdLevel level = DetectedSimdLevel();
+    if (level == SimdLevel::AVX2) {
+        for (; i < numFullWords; ++i) {
+            words_[i] = Avx2Mask(data + (i * 64));
+        }
+    } else if (level == SimdLevel::SSE4) {
+        for (; i < numFullWords; ++i) {
+            words_[i] = SseMask(data + (i * 64));
+        }
+    }
+#endif
+    for (; i < numWords; ++i) {
+        const std::size_t offset = i * 64;
+        words_[i] = ScalarMask(data + offset, std::min<std::size_t>(64, numPulses_ - offset));
+    }
+
+    for (std::size_t w = 0; w < numWords; ++w) {
+        ranks_[w] = static_cast<std::uint32_t>(numBases_);
+        numBases_ += std::popcount(words_[w]);
+    }
+}
+
+std::size_t Pulse2BaseCache::FindFirst() const { return numBases_ == 0 ? npos : Select(0); }
+
+std::size_t Pulse2BaseCache::FindNext(const std::size_t from) const
+{
+    std::size_t pos = from + 1;
+    if (pos >= numPulses_) {
+        return npos;
+    }
+
+    // remainder of current word, then scan forward
+    std::size_t w = pos / 64;
+    std::uint64_t word = words_[w] & (~std::uint64_t{0} << (pos % 64));
+    while (word == 0) {
+        if (++w == words_.size()) {
+            return npos;
+        }
+        word = words_[w];
+    }
+    return (w * 64) + std::countr_zero(word);
+}
+
+std::size_t Pulse2BaseCache::Select(const std::size_t baseIndex) const
+{
+    assert(baseIndex < numBases_);
+
+    // last word whose preceding rank is <= baseIndex
+    const auto found = std::upper_bound(ranks_.cbegin(), ranks_.cend(), baseIndex);
+    const std::size_t w = std::distance(ranks_.cbegin(), found) - 1;
+    return (w * 64) + SelectInWord(words_[w], baseIndex - ranks_[w]);
+}
+
+}  // namespace BAM
+}  // namespace PacBio
@@ -3,76 +3,83 @@
 
 #include <pbbam/Config.h>
 
-#include <boost/dynamic_bitset.hpp>
-#include <boost/version.hpp>
-
-#include <string>
-#include <type_traits>
+#include <algorithm>
+#include <bit>
+#include <string_view>
+#include <vector>
 
 #include <cassert>
-#include <cctype>
 #include <cstddef>
+#include <cstdint>
 
 namespace PacBio {
 namespace BAM {
 
+///
+/// Basecalled vs. squashed pulse positions, stored as a bitmask (1 bit per
+/// pulse) with a per-word rank directory.
+///
 class Pulse2BaseCache
 {
 public:
+    /// returned by FindFirst/FindNext when no basecall is found
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
     /// \brief Creates a Pulse2BaseCache from pulseCall data ('pc' tag)
     ///
     /// Computes & stores cache of basecalled vs. squashed pulse positions for
-    /// later masking of pulse data.
+    /// later masking of pulse data. Basecalled pulses are uppercase, squashed
+    /// pulses are lowercase.
     ///
-    /// \param pulseCalls[in]   string contents of 'pc' tag
+    /// \param pulseCalls[in]   contents of 'pc' tag (may refer directly to
+    ///                         raw tag data)
     ///
-    explicit Pulse2BaseCache(const std::string& pulseCalls) : data_(pulseCalls.size())
-    {
-        // basecalled pulse -> data[i] == 1
-        // squashed pulse   -> data[i] == 0
-        //
-        const auto numPulses = pulseCalls.size();
-        for (std::size_t i = 0; i < numPulses; ++i) {
-            data_[i] = std::isupper(pulseCalls.at(i));
-        }
-    }
+    explicit Pulse2BaseCache(std::string_view pulseCalls);
 
     Pulse2BaseCache() = delete;
     Pulse2BaseCache(const Pulse2BaseCache&) = default;
-    Pulse2BaseCache(Pulse2BaseCache&&) noexcept(
-        std::is_nothrow_move_constructible<boost::dynamic_bitset<>>::value) = default;
+    Pulse2BaseCache(Pulse2BaseCache&&) noexcept = default;
     Pulse2BaseCache& operator=(const Pulse2BaseCache&) = default;
-    Pulse2BaseCache& operator=(Pulse2BaseCache&&) noexcept(
-        std::is_nothrow_move_assignable<boost::dynamic_bitset<>>::value) = default;
+    Pulse2BaseCache& operator=(Pulse2BaseCache&&) noexcept = default;
     ~Pulse2BaseCache() = default;
 
-    ///
-    /// \brief FindFirst
-    /// \return
-    ///
-    std::size_t FindFirst() const { return data_.find_first(); }
+    /// \returns position of the first basecalled pulse, or npos if none
+    std::size_t FindFirst() const;
 
-    ///
-    /// \brief FindNext
-    /// \param from
-    /// \return
-    ///
-    std::size_t FindNext(std::size_t from) const { return data_.find_next(from); }
+    /// \returns position of the first basecalled pulse after \p from, or npos
+    ///          if none
+    std::size_t FindNext(std::size_t from) const;
 
-    ///
-    /// \brief IsBasecallAt
-    /// \param pos
-    /// \return
-    ///
-    bool IsBasecallAt(const std::size_t pos) const { return data_[pos]; }
+    /// \returns true if pulse at \p pos is basecalled
+    bool IsBasecallAt(const std::size_t pos) const
+    {
+        assert(pos < numPulses_);
+        return (words_[pos / 64] >> (pos % 64)) & 1;
+    }
 
     /// \returns the total number of pulses (basecalled & squashed)
     ///
-    std::size_t NumPulses() const { return data_.size(); }
+    std::size_t NumPulses() const { return numPulses_; }
 
     /// \returns the total number of basecalled pulses
     ///
-    std::size_t NumBases() const { return data_.count(); }
+    std::size_t NumBases() const { return numBases_; }
+
+    /// \returns the number of basecalled pulses before pulse \p pos
+    std::size_t Rank(const std::size_t pos) const
+    {
+        assert(pos <= numPulses_);
+        const std::size_t word = pos / 64;
+        const std::size_t bit = pos % 64;
+        if (bit == 0) {
+            return (word < ranks_.size()) ? ranks_[word] : numBases_;
+        }
+        const std::uint64_t below = words_[word] & ((std::uint64_t{1} << bit) - 1);
+        return ranks_[word] + std::popcount(below);
+    }
+
+    /// \returns the pulse position of basecall \p baseIndex (0-based)
+    std::size_t Select(std::size_t baseIndex) const;
 
     /// \brief Removes squashed pulse positions from input data.
     ///
@@ -82,24 +89,25 @@ public:
     template <typename T>
     T RemoveSquashedPulses(const T& pulseData) const
     {
-        const auto numPulses = pulseData.size();
-        assert(numPulses == data_.size());
+        assert(pulseData.size() == numPulses_);
 
-        // The reserve() below overshoots the required space, but numPulses is cheap
-        // to compute, and by definition will be sufficient to hold the result. Thus
-        // we only ever need to do one allocation.
-        //
         T result;
-        result.reserve(numPulses);
-
-        // Only include data at positions that match our cached pulse data.
-        //
-        std::size_t inputIndex = 0;
-        for (std::size_t i = 0; i < numPulses; ++i) {
-            if (data_[i]) {
-                result.push_back(pulseData.at(inputIndex));
+        result.resize(numBases_);
+
+        // copy whole runs of basecalls, otherwise gather set bits
+        auto out = result.begin();
+        auto in = pulseData.cbegin();
+        for (std::uint64_t word : words_) {
+            if (word == ~std::uint64_t{0}) {
+                out = std::copy_n(in, 64, out);
+            } else {
+                while (word != 0) {
+                    *out = in[std::countr_zero(word)];
+                    ++out;
+                    word &= (word - 1);
+                }
             }
-            ++inputIndex;
+            in += std::min<std::ptrdiff_t>(64, pulseData.cend() - in);
         }
         return result;
     }
@@ -113,22 +121,15 @@ public:
     ///
     int EstimatedBytesUsed() const
     {
-        int result = sizeof(boost::dynamic_bitset<>);
-#if BOOST_VERSION >= 106200
-        // bitset::capacity() (added in boost v1.62) returns the number of bits
-        // that can be stored before reallocating.
-        result += (data_.capacity() / sizeof(unsigned long));
-#else
-        // Cannot directly query the underlying container size prior to v1.62.
-        // This will likely undershoot the actual space used, but this provides
-        // at least a minimum.
-        result += (data_.size() / sizeof(unsigned long));
-#endif
-        return result;
+        return sizeof(Pulse2BaseCache) + (words_.capacity() * sizeof(std::uint64_t)) +
+               (ranks_.capacity() * sizeof(std::uint32_t));
     }
 
 private:
-    boost::dynamic_bitset<> data_;
+    std::vector<std::uint64_t> words_;  // basecalled pulse -> 1, squashed -> 0
+    std::vector<std::uint32_t> ranks_;  // number of basecalls before each word
+    std::size_t numPulses_;
+    std::size_t numBases_;
 };
 
 }  // namespace BAM
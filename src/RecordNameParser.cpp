@@ -0,0 +1,98 @@
+#include "PbbamInternalConfig.h"
+
+#include "RecordNameParser.h"
+
+#include <charconv>
+#include <system_error>
+
+#include <cstddef>
+
+namespace PacBio {
+namespace BAM {
+namespace {
+
+// only accepts a complete, non-empty token of decimal digits (w/ optional '-')
+template <typename T>
+std::optional<T> ParseNumber(const std::string_view text)
+{
+    if (text.empty()) {
+        return std::nullopt;
+    }
+    T value{};
+    const char* last = text.data() + text.size();
+    const auto result = std::from_chars(text.data(), last, value);
+    if (result.ec != std::errc{} || result.ptr != last) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+std::optional<std::pair<Data::Position, Data::Position>> ParseQueryInterval(
+    const std::string_view text)
+{
+    const auto underscore = text.find('_');
+    if (underscore == std::string_view::npos) {
+        return std::nullopt;
+    }
+    const auto qStart = ParseNumber<Data::Position>(text.substr(0, underscore));
+    const auto qEnd = ParseNumber<Data::Position>(text.substr(underscore + 1));
+    if (!qStart || !qEnd) {
+        return std::nullopt;
+    }
+    return std::make_pair(*qStart, *qEnd);
+}
+
+}  // namespace
+
+RecordNameParts ParseRecordName(const std::string_view name)
+{
+    RecordNameParts result;
+    result.name = name;
+
+    // substr() clamps the count when no further '/' is found (npos)
+    auto slash = name.find('/');
+    result.movieName = name.substr(0, slash);
+    if (slash == std::string_view::npos) {
+        return result;
+    }
+
+    std::size_t start = slash + 1;
+    slash = name.find('/', start);
+    result.holeNumberText = name.substr(start, slash - start);
+    result.holeNumber = ParseNumber<std::int32_t>(result.holeNumberText);
+
+    if (result.movieName == "transcript") {
+        result.type = RecordNameType::TRANSCRIPT;
+        return result;
+    }
+
+    // remaining components: [ccs[/fwd|/rev]][/<qs>_<qe>]
+    bool isCcs = false;
+    std::string_view component;
+    while (slash != std::string_view::npos) {
+        start = slash + 1;
+        slash = name.find('/', start);
+        component = name.substr(start, slash - start);
+        if (component == "ccs") {
+            isCcs = true;
+        } else if (isCcs && (component == "fwd" || component == "rev")) {
+            result.strand = component;
+        }
+    }
+    result.queryInterval = ParseQueryInterval(component);
+
+    if (isCcs) {
+        result.type = result.queryInterval ? RecordNameType::SEGMENT : RecordNameType::CCS;
+    } else if (result.queryInterval) {
+        result.type = RecordNameType::QUERY;
+    }
+    return result;
+}
+
+RecordNameParts ParseRecordName(const bam1_t* record)
+{
+    return ParseRecordName(std::string_view{bam_get_qname(record)});
+}
+
+}  // namespace BAM
+}  // namespace PacBio
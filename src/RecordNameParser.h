@@ -0,0 +1,69 @@
+#ifndef PBBAM_RECORDNAMEPARSER_H
+#define PBBAM_RECORDNAMEPARSER_H
+
+#include <pbbam/Config.h>
+
+#include <pbcopper/data/Position.h>
+
+#include <htslib/sam.h>
+
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include <cstdint>
+
+namespace PacBio {
+namespace BAM {
+
+///
+/// Read name layout, as determined from name components alone.
+///
+enum class RecordNameType
+{
+    UNKNOWN,     ///< "<movie>" or "<movie>/<zmw>"
+    QUERY,       ///< "<movie>/<zmw>/<qs>_<qe>" (subread, ZMW read, etc.)
+    CCS,         ///< "<movie>/<zmw>/ccs[/fwd|/rev]"
+    SEGMENT,     ///< "<movie>/<zmw>/ccs[/fwd|/rev]/<qs>_<qe>"
+    TRANSCRIPT,  ///< "transcript/<id>"
+};
+
+///
+/// Components of a %PacBio read name. Views refer to the parsed name.
+///
+struct RecordNameParts
+{
+    /// entire name
+    std::string_view name;
+
+    /// first component, or the entire name if it has no '/'
+    std::string_view movieName;
+
+    /// second component (raw text), and its value if numeric
+    std::string_view holeNumberText;
+    std::optional<std::int32_t> holeNumber;
+
+    /// from a final "<qs>_<qe>" component, if present & numeric
+    std::optional<std::pair<Data::Position, Data::Position>> queryInterval;
+
+    /// "fwd" or "rev" for by-strand CCS names, empty otherwise
+    std::string_view strand;
+
+    RecordNameType type = RecordNameType::UNKNOWN;
+};
+
+///
+/// \brief Splits a read name into its %PacBio components, in a single pass
+///        and without allocation.
+///
+/// Never throws; any missing or non-numeric components are left empty.
+///
+RecordNameParts ParseRecordName(std::string_view name);
+
+/// \brief Parses the name of a raw htslib record.
+RecordNameParts ParseRecordName(const bam1_t* record);
+
+}  // namespace BAM
+}  // namespace PacBio
+
+#endif  // PBBAM_RECORDNAMEPARSER_H
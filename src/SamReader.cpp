@@ -87,7 +87,7 @@ bool SamReader::GetNext(BamRecord& record)
     // success
     if (result >= 0) {
         BamRecordMemory::UpdateRecordTags(record);
-        record.header_ = d_->fullHeader_;
+        BamHeaderMemory::Share(d_->fullHeader_, record.header_);
         record.ResetCachedPositions();
         return true;
     }
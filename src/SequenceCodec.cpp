@@ -0,0 +1,251 @@
+#include "PbbamInternalConfig.h"
+
+#include "SequenceCodec.h"
+
+#include <htslib/hts.h>
+
+#include <algorithm>
+#include <array>
+
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PBBAM_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace PacBio {
+namespace BAM {
+namespace {
+
+// 4-bit code -> base
+alignas(16) constexpr std::array<char, 16> DNA_LOOKUP{
+    {'=', 'A', 'C', 'M', 'G', 'R', 'S', 'V', 'T', 'W', 'Y', 'H', 'K', 'D', 'B', 'N'}};
+
+// 4-bit code -> complemented base
+alignas(16) constexpr std::array<char, 16> COMPLEMENT_LOOKUP{
+    {'=', 'T', 'G', 'K', 'C', 'Y', 'S', 'B', 'A', 'W', 'R', 'D', 'M', 'H', 'V', 'N'}};
+
+std::uint8_t EncodedBase(const char base)
+{
+    return seq_nt16_table[static_cast<unsigned char>(base)];
+}
+
+void DecodeScalar(const std::uint8_t* encoded, const std::size_t length, char* out,
+                  const std::array<char, 16>& lookup)
+{
+    // whole bytes, then any final high nibble
+    const std::size_t numPairs = length / 2;
+    for (std::size_t i = 0; i < numPairs; ++i) {
+        const std::uint8_t byte = encoded[i];
+        out[2 * i] = lookup[byte >> 4];
+        out[2 * i + 1] = lookup[byte & 0x0F];
+    }
+    if (length & 1) {
+        out[length - 1] = lookup[encoded[numPairs] >> 4];
+    }
+}
+
+void EncodeScalar(const char* sequence, const std::size_t length, std::uint8_t* encoded)
+{
+    const std::size_t numPairs = length / 2;
+    for (std::size_t i = 0; i < numPairs; ++i) {
+        encoded[i] = (EncodedBase(sequence[2 * i]) << 4) | EncodedBase(sequence[2 * i + 1]);
+    }
+    if (length & 1) {
+        encoded[numPairs] = EncodedBase(sequence[length - 1]) << 4;
+    }
+}
+
+#ifdef PBBAM_X86_KERNELS
+
+// 16 packed bytes -> 32 bases per iteration
+__attribute__((target("sse4.1"))) void DecodeSse(const std::uint8_t* encoded,
+                                                 const std::size_t length, char* out,
+                                                 const std::array<char, 16>& lookup)
+{
+    const __m128i lut = _mm_load_si128(reinterpret_cast<const __m128i*>(lookup.data()));
+    const __m128i lowMask = _mm_set1_epi8(0x0F);
+
+    std::size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(encoded + i / 2));
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(packed, 4), lowMask);
+        const __m128i low = _mm_and_si128(packed, lowMask);
+        const __m128i highBases = _mm_shuffle_epi8(lut, high);
+        const __m128i lowBases = _mm_shuffle_epi8(lut, low);
+
+        // first base of each pair is in the high nibble
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_unpacklo_epi8(highBases, lowBases));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 16),
+                         _mm_unpackhi_epi8(highBases, lowBases));
+    }
+    DecodeScalar(encoded + i / 2, length - i, out + i, lookup);
+}
+
+// 32 packed bytes -> 64 bases per iteration
+__attribute__((target("avx2"))) void DecodeAvx2(const std::uint8_t* encoded,
+                                                const std::size_t length, char* out,
+                                                const std::array<char, 16>& lookup)
+{
+    const __m256i lut = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<const __m128i*>(lookup.data())));
+    const __m256i lowMask = _mm256_set1_epi8(0x0F);
+
+    std::size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        const __m256i packed =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(encoded + i / 2));
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(packed, 4), lowMask);
+        const __m256i low = _mm256_and_si256(packed, lowMask);
+        const __m256i highBases = _mm256_shuffle_epi8(lut, high);
+        const __m256i lowBases = _mm256_shuffle_epi8(lut, low);
+
+        // unpack works within 128-bit lanes, so restore byte order across lanes
+        const __m256i first = _mm256_unpacklo_epi8(highBases, lowBases);
+        const __m256i second = _mm256_unpackhi_epi8(highBases, lowBases);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                            _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 32),
+                            _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    DecodeSse(encoded + i / 2, length - i, out + i, lookup);
+}
+
+// 16 bases -> 8 packed bytes per iteration. Blocks containing anything other
+// than (upper or lower case) A, C, G, T, or N use the scalar table.
+__attribute__((target("sse4.1"))) void EncodeSse(const char* sequence, const std::size_t length,
+                                                 std::uint8_t* encoded)
+{
+    // (base >> 1) & 0xF is distinct for A, C, G, T, & N (either case)
+    const __m128i codeLut = _mm_setr_epi8(1, 2, 0, 4, 0, 0, 0, 15, 0, 0, 8, 0, 0, 0, 0, 0);
+    const __m128i checkLut =
+        _mm_setr_epi8(0, 'A', 'C', 0, 'G', 0, 0, 0, 'T', 0, 0, 0, 0, 0, 0, 'N');
+    const __m128i lowMask = _mm_set1_epi8(0x0F);
+    const __m128i upperCaseMask = _mm_set1_epi8(static_cast<char>(0xDF));
+    const __m128i pairWeights = _mm_set1_epi16(0x0110);  // (first << 4) + second
+
+    std::size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        const __m128i bases = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sequence + i));
+        const __m128i index = _mm_and_si128(_mm_srli_epi16(bases, 1), lowMask);
+        const __m128i codes = _mm_shuffle_epi8(codeLut, index);
+
+        const __m128i expected = _mm_and_si128(bases, upperCaseMask);
+        const __m128i matches = _mm_cmpeq_epi8(_mm_shuffle_epi8(checkLut, codes), expected);
+        if (_mm_movemask_epi8(matches) != 0xFFFF) {
+            EncodeScalar(sequence + i, 16, encoded + i / 2);
+            continue;
+        }
+
+        const __m128i pairs = _mm_maddubs_epi16(codes, pairWeights);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(encoded + i / 2),
+                         _mm_packus_epi16(pairs, pairs));
+    }
+    EncodeScalar(sequence + i, length - i, encoded + i / 2);
+}
+
+#endif  // PBBAM_X86_KERNELS
+
+SimdLevel UsableLevel(const SimdLevel requested)
+{
+    return std::min(requested, DetectedSimdLevel());
+}
+
+void Decode(const std::uint8_t* encoded, const std::size_t length, char* out,
+            const std::array<char, 16>& lookup, const SimdLevel level)
+{
+#ifdef PBBAM_X86_KERNELS
+    switch (UsableLevel(level)) {
+        case SimdLevel::AVX2:
+            DecodeAvx2(encoded, length, out, lookup);
+            return;
+        case SimdLevel::SSE4:
+            DecodeSse(encoded, length, out, lookup);
+            return;
+        case SimdLevel::SCALAR:
+            break;
+    }
+#else
+    static_cast<void>(level);
+#endif
+    DecodeScalar(encoded, length, out, lookup);
+}
+
+}  // namespace
+
+SimdLevel DetectedSimdLevel()
+{
+#ifdef PBBAM_X86_KERNELS
+    static const SimdLevel level = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return SimdLevel::SSE4;
+        }
+        return SimdLevel::SCALAR;
+    }();
+    return level;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+void DecodeSequence(const std::uint8_t* encoded, const std::size_t length, char* out)
+{
+    DecodeSequence(encoded, length, out, DetectedSimdLevel());
+}
+
+void DecodeSequence(const std::uint8_t* encoded, const std::size_t length, char* out,
+                    const SimdLevel level)
+{
+    Decode(encoded, length, out, DNA_LOOKUP, level);
+}
+
+void DecodeReverseComplementSequence(const std::uint8_t* encoded, const std::size_t length,
+                                     char* out)
+{
+    DecodeReverseComplementSequence(encoded, length, out, DetectedSimdLevel());
+}
+
+void DecodeReverseComplementSequence(const std::uint8_t* encoded, const std::size_t length,
+                                     char* out, const SimdLevel level)
+{
+    // complement while decoding, then reverse in place (both passes vectorize)
+    Decode(encoded, length, out, COMPLEMENT_LOOKUP, level);
+    std::reverse(out, out + length);
+}
+
+void EncodeSequence(const char* sequence, const std::size_t length, std::uint8_t* encoded)
+{
+    EncodeSequence(sequence, length, encoded, DetectedSimdLevel());
+}
+
+void EncodeSequence(const char* sequence, const std::size_t length, std::uint8_t* encoded,
+                    const SimdLevel level)
+{
+#ifdef PBBAM_X86_KERNELS
+    if (UsableLevel(level) != SimdLevel::SCALAR) {
+        EncodeSse(sequence, length, encoded);
+        return;
+    }
+#else
+    static_cast<void>(level);
+#endif
+    EncodeScalar(sequence, length, encoded);
+}
+
+void EncodeFastqQualities(const char* fastq, const std::size_t length, std::uint8_t* out)
+{
+    // simple enough for compiler auto-vectorization
+    for (std::size_t i = 0; i < length; ++i) {
+        out[i] = static_cast<std::uint8_t>(fastq[i] - 33);
+    }
+}
+
+}  // namespace BAM
+}  // namespace PacBio
@@ -0,0 +1,60 @@
+#ifndef PBBAM_SEQUENCECODEC_H
+#define PBBAM_SEQUENCECODEC_H
+
+#include <pbbam/Config.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace PacBio {
+namespace BAM {
+
+///
+/// Kernels for BAM-encoded (4-bit packed) sequence & quality data.
+///
+/// Vectorized (SSE4.1 or AVX2) versions are selected at runtime, based on CPU
+/// support. All versions produce identical output.
+///
+enum class SimdLevel
+{
+    SCALAR,
+    SSE4,
+    AVX2
+};
+
+/// \returns highest instruction set level supported by this CPU (and build)
+SimdLevel DetectedSimdLevel();
+
+///
+/// \brief Decodes \p length bases from packed \p encoded data into \p out
+///        (which must hold at least \p length chars).
+///
+void DecodeSequence(const std::uint8_t* encoded, std::size_t length, char* out);
+void DecodeSequence(const std::uint8_t* encoded, std::size_t length, char* out, SimdLevel level);
+
+///
+/// \brief Decodes \p length bases from packed \p encoded data into \p out,
+///        reverse-complemented.
+///
+void DecodeReverseComplementSequence(const std::uint8_t* encoded, std::size_t length, char* out);
+void DecodeReverseComplementSequence(const std::uint8_t* encoded, std::size_t length, char* out,
+                                     SimdLevel level);
+
+///
+/// \brief Packs \p length bases from \p sequence into \p encoded (which must
+///        hold at least (length + 1) / 2 bytes).
+///
+void EncodeSequence(const char* sequence, std::size_t length, std::uint8_t* encoded);
+void EncodeSequence(const char* sequence, std::size_t length, std::uint8_t* encoded,
+                    SimdLevel level);
+
+///
+/// \brief Converts \p length FASTQ (ASCII, Phred+33) quality chars into raw
+///        BAM quality values.
+///
+void EncodeFastqQualities(const char* fastq, std::size_t length, std::uint8_t* out);
+
+}  // namespace BAM
+}  // namespace PacBio
+
+#endif  // PBBAM_SEQUENCECODEC_H
@@ -82,8 +82,16 @@ T Reversed(const T& input)
 
 inline void ReverseComplement(std::string& seq)
 {
-    std::transform(seq.begin(), seq.end(), seq.begin(), Complement);
-    Reverse(seq);
+    // single pass, swapping complemented bases from both ends
+    auto first = seq.begin();
+    auto last = seq.end();
+    while (first < last) {
+        --last;
+        const char base = Complement(*first);
+        *first = Complement(*last);
+        *last = base;
+        ++first;
+    }
 }
 
 inline std::string MaybeReverseComplement(std::string&& seq, bool reverse)
@@ -8,24 +8,39 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <htslib/bgzf.h>
+
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <type_traits>
 
+#include <cstddef>
+
 namespace PacBio {
 namespace BAM {
+namespace {
+
+// Output is flushed in chunks of (at least) this size. Also a multiple of the
+// BGZF block size, so full buffers split evenly into compression jobs.
+constexpr std::size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+}  // namespace
 
 class TextFileWriter::TextFileWriterPrivate : public FileProducer
 {
 public:
-    TextFileWriterPrivate(const std::string& filename) : FileProducer{filename}
+    TextFileWriterPrivate(const std::string& filename, const std::size_t numThreads)
+        : FileProducer{filename}
     {
         isZipped_ = boost::algorithm::iends_with(filename, ".gz");
 
         if (isZipped_) {
-            // open for gzipped text
-            bgzf_.reset(bgzf_open(TempFilename().c_str(), "wg"));
+            // open for gzipped text, using (multithreaded) BGZF if requested
+            const bool useThreads = numThreads > 1;
+            bgzf_.reset(bgzf_open(TempFilename().c_str(), (useThreads ? "w" : "wg")));
             if (bgzf_.get() == nullptr) {
                 std::ostringstream msg;
                 msg << "[pbbam] text file writer ERROR: could not open zipped file:\n"
@@ -33,6 +48,13 @@ public:
                 MaybePrintErrnoReason(msg);
                 throw std::runtime_error{msg.str()};
             }
+            if (useThreads && bgzf_mt(bgzf_.get(), numThreads, 256) != 0) {
+                DiscardTempFile();
+                throw std::runtime_error{
+                    "[pbbam] text file writer ERROR: could not start compression threads for "
+                    "file: " +
+                    filename};
+            }
         } else {
             // open for plain text
             out_.open(TempFilename());
@@ -44,33 +66,103 @@ public:
                 throw std::runtime_error{msg.str()};
             }
         }
+
+        buffer_.reserve(OUTPUT_BUFFER_SIZE + 1024);
+    }
+
+    TextFileWriterPrivate(const TextFileWriterPrivate&) = delete;
+    TextFileWriterPrivate& operator=(const TextFileWriterPrivate&) = delete;
+
+    ~TextFileWriterPrivate() noexcept
+    {
+        // flush remaining output before the file is closed & renamed
+        try {
+            Close();
+        } catch (...) {
+            // temp file is discarded, remain no-throw
+        }
+    }
+
+    // Flushes & closes output. On failure, the temp file is discarded rather
+    // than renamed to the target filename.
+    void Close()
+    {
+        if (isClosed_) {
+            return;
+        }
+        isClosed_ = true;
+
+        try {
+            Flush();
+            if (isZipped_) {
+                if (bgzf_close(bgzf_.release()) != 0) {
+                    throw WriteError();
+                }
+            } else {
+                out_.close();
+                if (!out_) {
+                    throw WriteError();
+                }
+            }
+        } catch (...) {
+            DiscardTempFile();
+            throw;
+        }
     }
 
-    void Write(const std::string& line)
+    void Flush()
     {
+        if (buffer_.empty()) {
+            return;
+        }
+
         if (isZipped_) {
-            const std::size_t length = line.size();
-            ssize_t written = bgzf_write(bgzf_.get(), line.c_str(), length);
-            written += bgzf_write(bgzf_.get(), "\n", 1);
-            if (written != static_cast<ssize_t>(length + 1)) {
-                std::ostringstream msg;
-                msg << "[pbbam] text file writer ERROR: could not write to file:\n"
-                    << "  file: " << TempFilename();
-                MaybePrintErrnoReason(msg);
-                throw std::runtime_error{msg.str()};
+            const ssize_t written = bgzf_write(bgzf_.get(), buffer_.data(), buffer_.size());
+            if (written != static_cast<ssize_t>(buffer_.size())) {
+                throw WriteError();
             }
         } else {
-            out_ << line << '\n';
+            out_.write(buffer_.data(), buffer_.size());
+            if (!out_) {
+                throw WriteError();
+            }
         }
+        buffer_.clear();
+    }
+
+    void Write(const std::string_view line)
+    {
+        if (isClosed_) {
+            throw std::runtime_error{
+                "[pbbam] text file writer ERROR: cannot write to closed file: " +
+                TargetFilename()};
+        }
+
+        buffer_.append(line);
+        buffer_.push_back('\n');
+        if (buffer_.size() >= OUTPUT_BUFFER_SIZE) {
+            Flush();
+        }
+    }
+
+    std::runtime_error WriteError() const
+    {
+        std::ostringstream msg;
+        msg << "[pbbam] text file writer ERROR: could not write to file:\n"
+            << "  file: " << TempFilename();
+        MaybePrintErrnoReason(msg);
+        return std::runtime_error{msg.str()};
     }
 
     bool isZipped_ = false;
+    bool isClosed_ = false;
     std::unique_ptr<BGZF, HtslibBgzfDeleter> bgzf_;
     std::ofstream out_;
+    std::string buffer_;
 };
 
-TextFileWriter::TextFileWriter(const std::string& filename)
-    : d_{std::make_unique<TextFileWriterPrivate>(filename)}
+TextFileWriter::TextFileWriter(const std::string& filename, const std::size_t numThreads)
+    : d_{std::make_unique<TextFileWriterPrivate>(filename, numThreads)}
 {}
 
 TextFileWriter::TextFileWriter(TextFileWriter&&) noexcept = default;
@@ -79,7 +171,9 @@ TextFileWriter& TextFileWriter::operator=(TextFileWriter&&) noexcept = default;
 
 TextFileWriter::~TextFileWriter() = default;
 
-void TextFileWriter::Write(const std::string& line) { d_->Write(line); }
+void TextFileWriter::Close() { d_->Close(); }
+
+void TextFileWriter::Write(const std::string_view line) { d_->Write(line); }
 
 }  // namespace BAM
 }  // namespace PacBio
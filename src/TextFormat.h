@@ -0,0 +1,34 @@
+#ifndef PBBAM_TEXTFORMAT_H
+#define PBBAM_TEXTFORMAT_H
+
+#include <pbbam/Config.h>
+
+#include <array>
+#include <charconv>
+#include <string>
+#include <type_traits>
+
+namespace PacBio {
+namespace BAM {
+
+///
+/// \brief Appends the text form of numeric \p value to \p out.
+///
+/// Uses std::to_chars, which avoids stream & locale overhead. Floating-point
+/// values are written in their shortest round-trip form.
+///
+template <typename T>
+void AppendNumber(std::string& out, const T value)
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+
+    // large enough for any 64-bit integer or shortest-form double
+    std::array<char, 32> buffer;
+    const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    out.append(buffer.data(), result.ptr);
+}
+
+}  // namespace BAM
+}  // namespace PacBio
+
+#endif  // PBBAM_TEXTFORMAT_H
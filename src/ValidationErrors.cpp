@@ -51,10 +51,35 @@ void ValidationErrors::AddTagLengthError(const std::string& name, const std::str
     AddRecordError(name, s.str());
 }
 
+void ValidationErrors::Append(ValidationErrors&& other)
+{
+    for (auto& [fn, errors] : other.fileErrors_) {
+        for (auto& details : errors) {
+            AddFileError(fn, std::move(details));
+        }
+    }
+    for (auto& [rg, errors] : other.readGroupErrors_) {
+        for (auto& details : errors) {
+            AddReadGroupError(rg, std::move(details));
+        }
+    }
+    for (auto& [name, errors] : other.recordErrors_) {
+        for (auto& details : errors) {
+            AddRecordError(name, std::move(details));
+        }
+    }
+    other.fileErrors_.clear();
+    other.readGroupErrors_.clear();
+    other.recordErrors_.clear();
+    other.currentNumErrors_ = 0;
+}
+
 bool ValidationErrors::IsEmpty() const { return currentNumErrors_ == 0; }
 
 size_t ValidationErrors::MaxNumErrors() const { return maxNumErrors_; }
 
+size_t ValidationErrors::NumErrors() const { return currentNumErrors_; }
+
 void ValidationErrors::OnErrorAdded()
 {
     ++currentNumErrors_;
@@ -39,8 +39,13 @@ public:
     void AddTagLengthError(const std::string& name, const std::string& tagLabel,
                            const std::string& tagName, std::size_t observed, std::size_t expected);
 
+    // Adds all errors from \p other, e.g. from validating a range of records
+    // on another thread. Throws if the max number of errors is reached.
+    void Append(ValidationErrors&& other);
+
     bool IsEmpty() const;
     std::size_t MaxNumErrors() const;
+    std::size_t NumErrors() const;
     void ThrowErrors();
 
 private:
@@ -5,17 +5,26 @@
 #include <pbbam/BamFile.h>
 #include <pbbam/BamHeader.h>
 #include <pbbam/BamRecord.h>
+#include <pbbam/BamRecordTag.h>
 #include <pbbam/EntireFileQuery.h>
+#include <pbbam/PbiIndexedBamReader.h>
+#include <pbbam/PbiRawData.h>
 #include <pbbam/ReadGroupInfo.h>
+#include "BamRecordTags.h"
 #include "ValidationErrors.h"
 #include "Version.h"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/core/ignore_unused.hpp>
 
+#include <algorithm>
+#include <array>
+#include <exception>
 #include <map>
+#include <memory>
 #include <set>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <cstddef>
@@ -313,55 +322,45 @@ void ValidateRecordRequiredTags(const BamRecord& b, std::unique_ptr<ValidationEr
 
 void ValidateRecordTagLengths(const BamRecord& b, std::unique_ptr<ValidationErrors>& errors)
 {
-    const auto name = b.FullName();
+    // Compare stored lengths only, without decoding sequence or tag data.
+    const auto& impl = b.Impl();
+    const std::size_t sequenceLength = impl.SequenceLength();
     const std::size_t expectedLength =
-        (IsCcsOrTranscript(b.Type()) ? b.Sequence().size() : (b.QueryEnd() - b.QueryStart()));
+        (IsCcsOrTranscript(b.Type()) ? sequenceLength : (b.QueryEnd() - b.QueryStart()));
 
     // check "per-base"-type data lengths are compatible
-    if (b.Sequence().size() != expectedLength) {
-        errors->AddRecordError(name, "sequence length does not match expected length");
+    if (sequenceLength != expectedLength) {
+        errors->AddRecordError(b.FullName(), "sequence length does not match expected length");
     }
 
-    if (b.HasDeletionQV()) {
-        if (b.DeletionQV().size() != expectedLength) {
-            errors->AddTagLengthError(name, "DeletionQV", "dq", b.DeletionQV().size(),
-                                      expectedLength);
-        }
-    }
-    if (b.HasDeletionTag()) {
-        if (b.DeletionTag().size() != expectedLength) {
-            errors->AddTagLengthError(name, "DeletionTag", "dt", b.DeletionTag().size(),
-                                      expectedLength);
-        }
-    }
-    if (b.HasInsertionQV()) {
-        if (b.InsertionQV().size() != expectedLength) {
-            errors->AddTagLengthError(name, "InsertionQV", "iq", b.InsertionQV().size(),
-                                      expectedLength);
-        }
-    }
-    if (b.HasMergeQV()) {
-        if (b.MergeQV().size() != expectedLength) {
-            errors->AddTagLengthError(name, "MergeQV", "mq", b.MergeQV().size(), expectedLength);
-        }
-    }
-    if (b.HasSubstitutionQV()) {
-        if (b.SubstitutionQV().size() != expectedLength) {
-            errors->AddTagLengthError(name, "SubstitutionQV", "sq", b.SubstitutionQV().size(),
-                                      expectedLength);
+    struct PerBaseTag
+    {
+        BamRecordTag tag;
+        const char* label;
+    };
+    // clang-format off
+    static constexpr std::array<PerBaseTag, 7> PerBaseTags{{
+        {BamRecordTag::DELETION_QV,      "DeletionQV"},
+        {BamRecordTag::DELETION_TAG,     "DeletionTag"},
+        {BamRecordTag::INSERTION_QV,     "InsertionQV"},
+        {BamRecordTag::MERGE_QV,         "MergeQV"},
+        {BamRecordTag::SUBSTITUTION_QV,  "SubstitutionQV"},
+        {BamRecordTag::SUBSTITUTION_TAG, "SubstitutionTag"},
+        {BamRecordTag::IPD,              "IPD"},
+    }};
+    // clang-format on
+
+    for (const auto& perBaseTag : PerBaseTags) {
+        if (!impl.HasTag(perBaseTag.tag)) {
+            continue;
         }
-    }
-    if (b.HasSubstitutionTag()) {
-        if (b.SubstitutionTag().size() != expectedLength) {
-            errors->AddTagLengthError(name, "SubstitutionTag", "st", b.SubstitutionTag().size(),
+        const std::size_t tagLength = impl.TagLength(perBaseTag.tag).value_or(0);
+        if (tagLength != expectedLength) {
+            errors->AddTagLengthError(b.FullName(), perBaseTag.label,
+                                      BamRecordTags::LabelFor(perBaseTag.tag), tagLength,
                                       expectedLength);
         }
     }
-    if (b.HasIPD()) {
-        if (b.IPD().size() != expectedLength) {
-            errors->AddTagLengthError(name, "IPD", "ip", b.IPD().size(), expectedLength);
-        }
-    }
 
     // NOTE: disabling "internal" tag checks for now, only production tags
 }
@@ -478,6 +477,71 @@ void Validator::ValidateEntireFile(const BamFile& file, const std::size_t maxErr
     }
 }
 
+void Validator::ValidateEntireFile(const BamFile& file, const std::size_t maxErrors,
+                                   const std::size_t numThreads)
+{
+    // fall back to serial validation if we cannot split the file by PBI rows
+    if (numThreads < 2 || !file.PacBioIndexExists()) {
+        ValidateEntireFile(file, maxErrors);
+        return;
+    }
+
+    auto errors = std::make_unique<ValidationErrors>(maxErrors);
+    ValidateMetadata(file, errors);
+
+    const auto index = std::make_shared<PbiRawData>(file.PacBioIndexFilename());
+    const std::size_t numReads = index->NumReads();
+    const std::size_t numRanges = std::min(numThreads, std::max<std::size_t>(numReads, 1));
+    const std::size_t rangeSize = (numReads + numRanges - 1) / numRanges;
+    const auto& fileOffsets = index->BasicData().fileOffset_;
+
+    // Validate contiguous PBI row ranges in parallel. Each range collects its
+    // own errors, stopping early once it has reached the max.
+    std::vector<std::unique_ptr<ValidationErrors>> rangeErrors(numRanges);
+    std::vector<std::exception_ptr> rangeExceptions(numRanges);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < numRanges; ++i) {
+        const std::size_t firstRow = i * rangeSize;
+        const std::size_t lastRow = std::min(firstRow + rangeSize, numReads);
+        rangeErrors[i] = std::make_unique<ValidationErrors>(ValidationErrors::MAX);
+        if (firstRow >= lastRow) {
+            continue;
+        }
+
+        threads.emplace_back([&, i, firstRow, lastRow]() {
+            try {
+                IndexResultBlock block{firstRow, lastRow - firstRow};
+                block.virtualOffset_ = fileOffsets.at(firstRow);
+                PbiIndexedBamReader reader{PbiFilter{}, file, index, IndexResultBlocks{block}};
+
+                auto& localErrors = rangeErrors[i];
+                BamRecord record;
+                while (localErrors->NumErrors() < errors->MaxNumErrors() &&
+                       reader.GetNext(record)) {
+                    ValidateRecord(record, localErrors);
+                }
+            } catch (...) {
+                rangeExceptions[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // combine results in file order
+    for (std::size_t i = 0; i < numRanges; ++i) {
+        if (rangeExceptions[i]) {
+            std::rethrow_exception(rangeExceptions[i]);
+        }
+        errors->Append(std::move(*rangeErrors[i]));
+    }
+
+    if (!errors->IsEmpty()) {
+        errors->ThrowErrors();
+    }
+}
+
 void Validator::ValidateFileMetadata(const BamFile& file, const std::size_t maxErrors)
 {
     auto errors = std::make_unique<ValidationErrors>(maxErrors);
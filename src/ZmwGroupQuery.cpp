@@ -9,11 +9,19 @@
 #include <pbbam/PbiFilterTypes.h>
 #include <pbbam/internal/QueryBase.h>
 #include "MemoryUtils.h"
+#include "PbiIndexIO.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 
 namespace PacBio {
@@ -128,44 +136,123 @@ std::unique_ptr<internal::IGroupQuery> MakeWhitelistedQuery(std::vector<std::int
     return std::make_unique<WhitelistedQuery>(std::move(zmwWhitelist), dataset);
 }
 
-class RoundRobinZmwGroupQuery : public internal::IGroupQuery
+///
+/// Queue of per-file readers (& their next records) for ZMW group queries.
+///
+/// If 'maxOpenFiles' is non-zero, readers beyond that limit are closed after
+/// saving their position, and re-opened when they return to the front of the
+/// queue. Readers nearest the back of the queue are parked first.
+///
+class ZmwReaderQueue
 {
 public:
-    RoundRobinZmwGroupQuery(const DataSet& dataset, const PbiFilter& pbiFilter)
+    ZmwReaderQueue(const DataSet& dataset, const PbiFilter& pbiFilter,
+                   const std::size_t maxOpenFiles)
+        : bamFiles_{dataset.BamFiles()}, maxOpenFiles_{maxOpenFiles}
     {
-        const auto bamFilenames = dataset.BamFilenames();
-        for (const auto& fn : bamFilenames) {
+        for (std::size_t i = 0; i < bamFiles_.size(); ++i) {
             // create reader for file
+            const auto& bamFile = bamFiles_[i];
             auto makeReader = [&]() -> std::unique_ptr<BamReader> {
                 if (pbiFilter.IsEmpty()) {
-                    return std::make_unique<BamReader>(fn);
+                    return std::make_unique<BamReader>(bamFile);
                 } else {
-                    return std::make_unique<PbiIndexedBamReader>(pbiFilter, fn);
+                    return std::make_unique<PbiIndexedBamReader>(pbiFilter, bamFile);
                 }
             };
             internal::CompositeMergeItem item{makeReader()};
+            item.fileIndex = i;
 
             // try load first record, ignore file if nothing found
             if (item.reader->GetNext(item.record)) {
-                readerItems_.push_back(std::move(item));
+                ++numOpenFiles_;
+                PushBack(std::move(item));
             }
         }
     }
 
+    bool Empty() const { return items_.empty(); }
+
+    // Removes the first item from the queue, re-opening its reader if needed.
+    internal::CompositeMergeItem PopFront()
+    {
+        internal::CompositeMergeItem item{std::move(items_.front())};
+        items_.pop_front();
+        if (!item.reader) {
+            item.reader = item.reopen();
+            item.reopen = nullptr;
+            ++numOpenFiles_;
+            EnforceOpenFileLimit();
+        }
+        return item;
+    }
+
+    void PushFront(internal::CompositeMergeItem item) { items_.push_front(std::move(item)); }
+
+    void PushBack(internal::CompositeMergeItem item)
+    {
+        items_.push_back(std::move(item));
+        EnforceOpenFileLimit();
+    }
+
+    // Releases an exhausted reader (popped from the queue).
+    void DropReader(internal::CompositeMergeItem item)
+    {
+        item.reader.reset();
+        --numOpenFiles_;
+    }
+
+private:
+    void EnforceOpenFileLimit()
+    {
+        if (maxOpenFiles_ == 0) {
+            return;
+        }
+
+        for (auto iter = items_.rbegin(); numOpenFiles_ > maxOpenFiles_ && iter != items_.rend();
+             ++iter) {
+            if (iter->reader) {
+                Park(*iter);
+            }
+        }
+    }
+
+    void Park(internal::CompositeMergeItem& item)
+    {
+        item.reopen = internal::MakeReaderReopener(*item.reader, bamFiles_.at(*item.fileIndex));
+
+        // leave open if reader cannot be restored
+        if (item.reopen) {
+            item.reader.reset();
+            --numOpenFiles_;
+        }
+    }
+
+    std::vector<BamFile> bamFiles_;
+    std::deque<internal::CompositeMergeItem> items_;
+    std::size_t maxOpenFiles_;
+    std::size_t numOpenFiles_ = 0;
+};
+
+class RoundRobinZmwGroupQuery : public internal::IGroupQuery
+{
+public:
+    RoundRobinZmwGroupQuery(const DataSet& dataset, const PbiFilter& pbiFilter,
+                            const std::size_t maxOpenFiles = 0)
+        : readerItems_{dataset, pbiFilter, maxOpenFiles}
+    {}
+
     bool GetNext(std::vector<BamRecord>& records) override
     {
         records.clear();
 
         // quick exit if nothing left
-        if (readerItems_.empty()) {
+        if (readerItems_.Empty()) {
             return false;
         }
 
         // pop first reader from the queue & store its record
-        auto firstIter = readerItems_.begin();
-        internal::CompositeMergeItem item{std::move(firstIter->reader),
-                                          std::move(firstIter->record)};
-        readerItems_.pop_front();
+        auto item = readerItems_.PopFront();
         auto zmw = item.record.HoleNumber();
         records.push_back(item.record);
 
@@ -178,13 +265,14 @@ public:
                 if (item.record.HoleNumber() == zmw) {
                     records.push_back(item.record);
                 } else {
-                    readerItems_.push_back(std::move(item));
+                    readerItems_.PushBack(std::move(item));
                     break;
                 }
             }
 
             // no data remaining for this reader, let it go
             else {
+                readerItems_.DropReader(std::move(item));
                 break;
             }
         }
@@ -193,47 +281,28 @@ public:
     }
 
 private:
-    std::deque<internal::CompositeMergeItem> readerItems_;
+    ZmwReaderQueue readerItems_;
 };
 
 class SequentialZmwGroupQuery : public internal::IGroupQuery
 {
 public:
-    SequentialZmwGroupQuery(const DataSet& dataset, const PbiFilter& pbiFilter)
-    {
-        const auto bamFilenames = dataset.BamFilenames();
-        for (const auto& fn : bamFilenames) {
-            // create reader for file
-            auto makeReader = [&]() -> std::unique_ptr<BamReader> {
-                if (pbiFilter.IsEmpty()) {
-                    return std::make_unique<BamReader>(fn);
-                } else {
-                    return std::make_unique<PbiIndexedBamReader>(pbiFilter, fn);
-                }
-            };
-            internal::CompositeMergeItem item{makeReader()};
-
-            // try load first record, ignore file if nothing found
-            if (item.reader->GetNext(item.record)) {
-                readerItems_.push_back(std::move(item));
-            }
-        }
-    }
+    SequentialZmwGroupQuery(const DataSet& dataset, const PbiFilter& pbiFilter,
+                            const std::size_t maxOpenFiles = 0)
+        : readerItems_{dataset, pbiFilter, maxOpenFiles}
+    {}
 
     bool GetNext(std::vector<BamRecord>& records) override
     {
         records.clear();
 
         // quick exit if nothing left
-        if (readerItems_.empty()) {
+        if (readerItems_.Empty()) {
             return false;
         }
 
         // pop first reader from the queue & store its record
-        auto firstIter = readerItems_.begin();
-        internal::CompositeMergeItem item{std::move(firstIter->reader),
-                                          std::move(firstIter->record)};
-        readerItems_.pop_front();
+        auto item = readerItems_.PopFront();
         auto zmw = item.record.HoleNumber();
         records.push_back(item.record);
 
@@ -244,13 +313,14 @@ public:
                 if (item.record.HoleNumber() == zmw) {
                     records.push_back(item.record);
                 } else {
-                    readerItems_.push_front(std::move(item));
+                    readerItems_.PushFront(std::move(item));
                     break;
                 }
             }
 
             // no data remaining for this reader, let it go
             else {
+                readerItems_.DropReader(std::move(item));
                 break;
             }
         }
@@ -258,7 +328,216 @@ public:
     }
 
 private:
-    std::deque<internal::CompositeMergeItem> readerItems_;
+    ZmwReaderQueue readerItems_;
+};
+
+///
+/// Splits the input into disjoint ZMW ranges. Each range is read by its own
+/// SequentialZmwGroupQuery, on its own thread, into a bounded queue.
+///
+class ShardedZmwGroupQuery : public internal::IGroupQuery
+{
+public:
+    ShardedZmwGroupQuery(const DataSet& dataset, const PbiFilter& pbiFilter,
+                         const ZmwGroupQuery::Config& config)
+        : prefetchSize_{std::max<std::size_t>(config.prefetchSize, 1)}
+        , deterministicOrder_{config.deterministicOrder}
+        , maxOpenFiles_{config.maxOpenFiles}
+    {
+        const auto shardFilters = MakeShardFilters(dataset, pbiFilter, config.numShards);
+        for (std::size_t i = 0; i < shardFilters.size(); ++i) {
+            shards_.push_back(std::make_unique<Shard>());
+        }
+
+        // destructor does not run if a thread fails to start, so stop any
+        // that already have
+        try {
+            for (std::size_t i = 0; i < shardFilters.size(); ++i) {
+                shards_[i]->thread = std::thread{&ShardedZmwGroupQuery::Produce, this, dataset,
+                                                 shardFilters[i], std::ref(*shards_[i])};
+            }
+        } catch (...) {
+            StopProducers();
+            throw;
+        }
+    }
+
+    ~ShardedZmwGroupQuery() override { StopProducers(); }
+
+    bool GetNext(std::vector<BamRecord>& records) override
+    {
+        records.clear();
+
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true) {
+            if (error_) {
+                std::rethrow_exception(error_);
+            }
+
+            bool allDone = true;
+            for (std::size_t i = nextShard_; i < shards_.size(); ++i) {
+                auto& shard = *shards_[i];
+                if (!shard.groups.empty()) {
+                    records = std::move(shard.groups.front());
+                    shard.groups.pop_front();
+                    spaceReady_.notify_all();
+                    return true;
+                }
+
+                if (!shard.done) {
+                    // in deterministic mode, wait on this shard before moving on
+                    allDone = false;
+                    if (deterministicOrder_) {
+                        break;
+                    }
+                } else if (deterministicOrder_ && i == nextShard_) {
+                    ++nextShard_;
+                }
+            }
+
+            if (allDone) {
+                return false;
+            }
+            dataReady_.wait(lock);
+        }
+    }
+
+private:
+    struct Shard
+    {
+        std::deque<std::vector<BamRecord>> groups;
+        bool done = false;
+        std::thread thread;
+    };
+
+    void StopProducers()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        spaceReady_.notify_all();
+        for (auto& shard : shards_) {
+            if (shard->thread.joinable()) {
+                shard->thread.join();
+            }
+        }
+    }
+
+    // Splits the input into at most 'numShards' ZMW ranges, with roughly equal
+    // record counts. Counts are estimated from each file's PBI hole number
+    // range & read count (assuming reads are spread evenly over the range),
+    // rather than loading the aggregate index.
+    static std::vector<PbiFilter> MakeShardFilters(const DataSet& dataset,
+                                                   const PbiFilter& pbiFilter,
+                                                   const std::size_t numShards)
+    {
+        std::vector<PbiIndexIO::HoleNumberRange> fileRanges;
+        std::vector<std::int64_t> breakpoints;
+        double totalRecords = 0.0;
+        for (const auto& bamFile : dataset.BamFiles()) {
+            const auto range = PbiIndexIO::LoadHoleNumberRange(bamFile.PacBioIndexFilename());
+            if (range.numReads > 0) {
+                fileRanges.push_back(range);
+                breakpoints.push_back(range.first);
+                breakpoints.push_back(std::int64_t{range.last} + 1);
+                totalRecords += range.numReads;
+            }
+        }
+
+        std::vector<PbiFilter> result;
+        if (fileRanges.empty()) {
+            return result;
+        }
+        std::sort(breakpoints.begin(), breakpoints.end());
+        breakpoints.erase(std::unique(breakpoints.begin(), breakpoints.end()), breakpoints.end());
+
+        // Walk the ZMW segments between breakpoints, with a constant estimated
+        // density in each, placing a cut each time a shard's share is reached.
+        const double shardSize = totalRecords / std::max<std::size_t>(numShards, 1);
+        std::vector<std::int32_t> cuts;  // first ZMW of each shard after the first
+        double currentSize = 0.0;
+        for (std::size_t i = 0; i + 1 < breakpoints.size(); ++i) {
+            const std::int64_t begin = breakpoints[i];
+            const std::int64_t end = breakpoints[i + 1];
+
+            double density = 0.0;
+            for (const auto& range : fileRanges) {
+                if (range.first <= begin && end - 1 <= range.last) {
+                    density += range.numReads / (std::int64_t{range.last} - range.first + 1.0);
+                }
+            }
+
+            std::int64_t pos = begin;
+            while (density > 0.0 && cuts.size() + 1 < numShards) {
+                const auto step = static_cast<std::int64_t>(
+                    std::ceil(std::max(shardSize - currentSize, 0.0) / density));
+                if (pos + step >= end) {
+                    break;
+                }
+                pos += step;
+                cuts.push_back(static_cast<std::int32_t>(pos));
+                currentSize = 0.0;
+            }
+            currentSize += density * (end - pos);
+        }
+
+        // first & last shards are open-ended, so together they cover all ZMWs
+        for (std::size_t i = 0; i <= cuts.size(); ++i) {
+            std::vector<PbiFilter> filters;
+            if (i > 0) {
+                filters.push_back(PbiZmwFilter{cuts[i - 1], Compare::GREATER_THAN_EQUAL});
+            }
+            if (i < cuts.size()) {
+                filters.push_back(PbiZmwFilter{cuts[i], Compare::LESS_THAN});
+            }
+            if (!pbiFilter.IsEmpty()) {
+                filters.push_back(pbiFilter);
+            }
+            result.push_back(PbiFilter::Intersection(std::move(filters)));
+        }
+        return result;
+    }
+
+    void Produce(const DataSet dataset, const PbiFilter shardFilter, Shard& shard)
+    {
+        try {
+            SequentialZmwGroupQuery query{dataset, shardFilter, maxOpenFiles_};
+            std::vector<BamRecord> records;
+            while (query.GetNext(records)) {
+                std::unique_lock<std::mutex> lock{mutex_};
+                spaceReady_.wait(lock,
+                                 [&]() { return stop_ || shard.groups.size() < prefetchSize_; });
+                if (stop_) {
+                    break;
+                }
+                shard.groups.push_back(std::move(records));
+                dataReady_.notify_all();
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock{mutex_};
+        shard.done = true;
+        dataReady_.notify_all();
+    }
+
+    std::size_t prefetchSize_;
+    bool deterministicOrder_;
+    std::size_t maxOpenFiles_;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::size_t nextShard_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable dataReady_;
+    std::condition_variable spaceReady_;
+    bool stop_ = false;
+    std::exception_ptr error_;
 };
 
 ZmwGroupQuery::ZmwGroupQuery(const DataSet& dataset, const ZmwFileIterationMode iterationMode,
@@ -281,6 +560,24 @@ ZmwGroupQuery::ZmwGroupQuery(const DataSet& dataset, const PbiFilter& filter)
     : internal::IGroupQuery(), d_{std::make_unique<SequentialZmwGroupQuery>(dataset, filter)}
 {}
 
+ZmwGroupQuery::ZmwGroupQuery(const DataSet& dataset, const Config& config,
+                             const DataSetFilterMode filterMode)
+    : internal::IGroupQuery()
+{
+    PbiFilter filter;
+    if (filterMode == DataSetFilterMode::APPLY) {
+        filter = PbiFilter::FromDataSet(dataset);
+    }
+
+    if (config.numShards > 1) {
+        d_ = std::make_unique<ShardedZmwGroupQuery>(dataset, filter, config);
+    } else if (config.iterationMode == ZmwFileIterationMode::SEQUENTIAL) {
+        d_ = std::make_unique<SequentialZmwGroupQuery>(dataset, filter, config.maxOpenFiles);
+    } else {
+        d_ = std::make_unique<RoundRobinZmwGroupQuery>(dataset, filter, config.maxOpenFiles);
+    }
+}
+
 ZmwGroupQuery::ZmwGroupQuery(std::vector<std::int32_t> zmwWhitelist, const DataSet& dataset)
     : internal::IGroupQuery(), d_{MakeWhitelistedQuery(std::move(zmwWhitelist), dataset)}
 {}
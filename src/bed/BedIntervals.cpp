@@ -0,0 +1,326 @@
+#include "PbbamInternalConfig.h"
+
+#include <pbbam/bed/BedIntervals.h>
+
+#include <pbbam/Deleters.h>
+#include <pbbam/FormatUtils.h>
+#include "../ErrnoReason.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+
+namespace PacBio {
+namespace BED {
+namespace {
+
+// size of each read from the (possibly compressed) file
+constexpr std::size_t READ_SIZE = 1 << 20;
+
+const std::vector<BedIntervals::Range> EmptyRanges;
+
+bool IsHeaderLine(const std::string_view line)
+{
+    return line.starts_with('#') || line.starts_with("track") || line.starts_with("browser");
+}
+
+class BedLineParser
+{
+public:
+    BedLineParser(const std::string& fn, BedIntervals& intervals)
+        : filename_{fn}, intervals_{intervals}
+    {}
+
+    void Parse(std::string_view line)
+    {
+        ++lineNumber_;
+
+        // trim any trailing whitespace (incl. CR)
+        while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) {
+            line.remove_suffix(1);
+        }
+        if (line.empty() || IsHeaderLine(line)) {
+            return;
+        }
+
+        const auto nameEnd = line.find('\t');
+        const auto startEnd =
+            (nameEnd == std::string_view::npos) ? nameEnd : line.find('\t', nameEnd + 1);
+        if (startEnd == std::string_view::npos) {
+            Fail("invalid BED record. Line has fewer than 3 fields", line);
+        }
+        auto stopEnd = line.find('\t', startEnd + 1);
+        if (stopEnd == std::string_view::npos) {
+            stopEnd = line.size();
+        }
+
+        const auto start = ParsePosition(line, nameEnd + 1, startEnd);
+        const auto stop = ParsePosition(line, startEnd + 1, stopEnd);
+        intervals_.Add(line.substr(0, nameEnd), start, stop);
+    }
+
+private:
+    [[noreturn]] void Fail(const std::string& reason, const std::string_view line) const
+    {
+        std::ostringstream msg;
+        msg << "[pbbam] BED reader ERROR: " << reason << ":\n"
+            << "  line " << lineNumber_ << ": '" << line << "'\n"
+            << "  BED file: " << filename_ << '\n';
+        throw std::runtime_error{msg.str()};
+    }
+
+    Data::Position ParsePosition(const std::string_view line, const std::size_t begin,
+                                 const std::size_t end) const
+    {
+        Data::Position value = 0;
+        const char* last = line.data() + end;
+        const auto result = std::from_chars(line.data() + begin, last, value);
+        if (begin == end || result.ec != std::errc{} || result.ptr != last) {
+            Fail("invalid BED record position", line);
+        }
+        return value;
+    }
+
+    const std::string& filename_;
+    BedIntervals& intervals_;
+    std::size_t lineNumber_ = 0;
+};
+
+}  // namespace
+
+BedIntervals::BedIntervals() = default;
+
+void BedIntervals::Add(const std::string_view contig, const Data::Position start,
+                       const Data::Position stop)
+{
+    auto& intervals = contigs_[ContigIndex(contig)];
+    if (!intervals.ranges.empty() && start < intervals.ranges.back().start) {
+        isSorted_ = false;
+    }
+    const auto maxStop =
+        intervals.maxStops.empty() ? stop : std::max(intervals.maxStops.back(), stop);
+    intervals.ranges.push_back(Range{start, stop});
+    intervals.maxStops.push_back(maxStop);
+}
+
+std::size_t BedIntervals::ContigIndex(const std::string_view contig)
+{
+    // BED records are typically grouped by contig, so check the last one
+    // before a (string-constructing) lookup
+    if (!contigNames_.empty() && contigNames_[lastContigIndex_] == contig) {
+        return lastContigIndex_;
+    }
+
+    std::string name{contig};
+    const auto found = contigLookup_.find(name);
+    if (found != contigLookup_.cend()) {
+        lastContigIndex_ = found->second;
+    } else {
+        lastContigIndex_ = contigNames_.size();
+        contigLookup_.emplace(name, lastContigIndex_);
+        contigNames_.push_back(std::move(name));
+        contigs_.emplace_back();
+    }
+    return lastContigIndex_;
+}
+
+const std::vector<std::string>& BedIntervals::Contigs() const { return contigNames_; }
+
+const BedIntervals::ContigIntervals* BedIntervals::Find(const std::string_view contig) const
+{
+    const auto found = contigLookup_.find(std::string{contig});
+    return (found == contigLookup_.cend() ? nullptr : &contigs_[found->second]);
+}
+
+BedIntervals BedIntervals::FromFile(const std::string& fn)
+{
+    // validate extension
+    if (!BAM::FormatUtils::IsBedFilename(fn)) {
+        std::ostringstream msg;
+        msg << "[pbbam] BED reader ERROR: not a recognized BED extension:\n"
+            << "  filename: " << fn << '\n';
+        throw std::runtime_error{msg.str()};
+    }
+
+    // gzread handles plain text as well as gzip/bgzip
+    std::unique_ptr<gzFile_s, BAM::GzFileDeleter> fp{gzopen(fn.c_str(), "rb")};
+    if (!fp) {
+        std::ostringstream msg;
+        msg << "[pbbam] BED reader ERROR: could not open file:\n"
+            << "  BED file: " << fn << '\n';
+        BAM::MaybePrintErrnoReason(msg);
+        throw std::runtime_error{msg.str()};
+    }
+
+    BedIntervals result;
+    BedLineParser parser{fn, result};
+
+    // Parse all complete lines in each buffer, carrying any partial line over
+    // to the front of the next read.
+    std::vector<char> buffer(READ_SIZE);
+    std::size_t carried = 0;
+    while (true) {
+        const int numRead = gzread(fp.get(), buffer.data() + carried,
+                                   static_cast<unsigned>(buffer.size() - carried));
+        if (numRead < 0) {
+            std::ostringstream msg;
+            msg << "[pbbam] BED reader ERROR: could not read from file:\n"
+                << "  BED file: " << fn << '\n';
+            throw std::runtime_error{msg.str()};
+        }
+
+        const std::size_t available = carried + numRead;
+        const std::string_view text{buffer.data(), available};
+        if (numRead == 0) {
+            // EOF, parse final line (if missing its newline)
+            if (available > 0) {
+                parser.Parse(text);
+            }
+            break;
+        }
+
+        const auto lastNewline = text.rfind('\n');
+        if (lastNewline == std::string_view::npos) {
+            // line longer than buffer
+            buffer.resize(buffer.size() * 2);
+            carried = available;
+            continue;
+        }
+
+        std::size_t lineStart = 0;
+        while (lineStart <= lastNewline) {
+            const auto lineEnd = text.find('\n', lineStart);
+            parser.Parse(text.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+        }
+
+        carried = available - lineStart;
+        std::memmove(buffer.data(), buffer.data() + lineStart, carried);
+    }
+
+    result.Sort();
+    return result;
+}
+
+const std::vector<BedIntervals::Range>& BedIntervals::Intervals(
+    const std::string_view contig) const
+{
+    const auto* intervals = Find(contig);
+    return (intervals ? intervals->ranges : EmptyRanges);
+}
+
+std::size_t BedIntervals::NumIntervals() const
+{
+    std::size_t result = 0;
+    for (const auto& intervals : contigs_) {
+        result += intervals.ranges.size();
+    }
+    return result;
+}
+
+std::pair<std::size_t, std::size_t> BedIntervals::OverlapCandidates(
+    const ContigIntervals& intervals, const Data::Position start, const Data::Position stop) const
+{
+    if (!isSorted_) {
+        throw std::runtime_error{
+            "[pbbam] BED intervals ERROR: intervals must be sorted before querying"};
+    }
+
+    // candidates start before 'stop' ...
+    const auto& ranges = intervals.ranges;
+    const auto last = std::lower_bound(ranges.cbegin(), ranges.cend(), stop,
+                                       [](const Range& r, const Data::Position pos) {
+                                           return r.start < pos;
+                                       });
+    const auto lastIndex = static_cast<std::size_t>(std::distance(ranges.cbegin(), last));
+
+    // ... and, using the running max, skip leading ranges that all end at or
+    // before 'start'
+    const auto& maxStops = intervals.maxStops;
+    const auto first = std::upper_bound(maxStops.cbegin(), maxStops.cbegin() + lastIndex, start);
+    const auto firstIndex = static_cast<std::size_t>(std::distance(maxStops.cbegin(), first));
+
+    return {firstIndex, lastIndex};
+}
+
+std::vector<BedIntervals::Range> BedIntervals::Overlapping(const std::string_view contig,
+                                                           const Data::Position start,
+                                                           const Data::Position stop) const
+{
+    std::vector<Range> result;
+    const auto* intervals = Find(contig);
+    if (!intervals || start >= stop) {
+        return result;
+    }
+
+    const auto [first, last] = OverlapCandidates(*intervals, start, stop);
+    for (std::size_t i = first; i < last; ++i) {
+        const auto& range = intervals->ranges[i];
+        if (range.stop > start) {
+            result.push_back(range);
+        }
+    }
+    return result;
+}
+
+bool BedIntervals::Overlaps(const std::string_view contig, const Data::Position start,
+                            const Data::Position stop) const
+{
+    const auto* intervals = Find(contig);
+    if (!intervals || start >= stop) {
+        return false;
+    }
+
+    // first candidate's stop is its running max, so it overlaps if present
+    const auto [first, last] = OverlapCandidates(*intervals, start, stop);
+    return first < last;
+}
+
+void BedIntervals::Sort()
+{
+    if (isSorted_) {
+        return;
+    }
+
+    for (auto& intervals : contigs_) {
+        auto& ranges = intervals.ranges;
+        std::stable_sort(ranges.begin(), ranges.end(), [](const Range& lhs, const Range& rhs) {
+            return std::tie(lhs.start, lhs.stop) < std::tie(rhs.start, rhs.stop);
+        });
+
+        auto& maxStops = intervals.maxStops;
+        maxStops.clear();
+        for (const auto& range : ranges) {
+            maxStops.push_back(maxStops.empty() ? range.stop
+                                                : std::max(maxStops.back(), range.stop));
+        }
+    }
+    isSorted_ = true;
+}
+
+std::vector<Data::GenomicInterval> BedIntervals::ToGenomicIntervals() const
+{
+    std::vector<Data::GenomicInterval> result;
+    result.reserve(NumIntervals());
+    for (std::size_t i = 0; i < contigs_.size(); ++i) {
+        for (const auto& range : contigs_[i].ranges) {
+            result.emplace_back(contigNames_[i], range.start, range.stop);
+        }
+    }
+    return result;
+}
+
+}  // namespace BED
+}  // namespace PacBio
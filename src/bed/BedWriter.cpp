@@ -3,10 +3,11 @@
 #include <pbbam/bed/BedWriter.h>
 
 #include <pbbam/TextFileWriter.h>
+#include "../TextFormat.h"
 
 #include <pbcopper/data/GenomicInterval.h>
 
-#include <sstream>
+#include <string>
 #include <type_traits>
 
 namespace PacBio {
@@ -15,21 +16,31 @@ namespace BED {
 class BedWriter::BedWriterPrivate
 {
 public:
-    explicit BedWriterPrivate(const std::string& filename) : writer_{filename} {}
+    BedWriterPrivate(const std::string& filename, const std::size_t numThreads)
+        : writer_{filename, numThreads}
+    {}
 
     void Write(const Data::GenomicInterval& interval)
     {
-        line_.str("");
-        line_ << interval.Name() << '\t' << interval.Start() << '\t' << interval.Stop();
-        writer_.Write(line_.str());
+        line_.clear();
+        line_.append(interval.Name());
+        line_.push_back('\t');
+        BAM::AppendNumber(line_, interval.Start());
+        line_.push_back('\t');
+        BAM::AppendNumber(line_, interval.Stop());
+        writer_.Write(line_);
     }
 
+    void Close() { writer_.Close(); }
+
 private:
-    std::ostringstream line_;
+    std::string line_;
     BAM::TextFileWriter writer_;
 };
 
-BedWriter::BedWriter(const std::string& fn) : d_{std::make_unique<BedWriterPrivate>(fn)} {}
+BedWriter::BedWriter(const std::string& fn, const std::size_t numThreads)
+    : d_{std::make_unique<BedWriterPrivate>(fn, numThreads)}
+{}
 
 BedWriter::BedWriter(BedWriter&&) noexcept = default;
 
@@ -37,6 +48,8 @@ BedWriter& BedWriter::operator=(BedWriter&&) noexcept = default;
 
 BedWriter::~BedWriter() = default;
 
+void BedWriter::Close() { d_->Close(); }
+
 void BedWriter::Write(const Data::GenomicInterval& interval) { d_->Write(interval); }
 
 }  // namespace BED
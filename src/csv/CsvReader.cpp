@@ -11,12 +11,21 @@
 
 #include <algorithm>
 #include <array>
+#include <charconv>
+#include <future>
+#include <iterator>
 #include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
+#include <cstddef>
+#include <cstdint>
+
 namespace PacBio {
 namespace CSV {
 namespace {
@@ -30,6 +39,72 @@ CsvHeader MakeHeader(const std::string& line, const char delimiter)
     return header;
 }
 
+// Rows per ReadColumns() batch. Batches bound memory use while leaving
+// enough rows per thread to amortize task overhead.
+constexpr std::size_t COLUMN_BATCH_SIZE = 65536;
+
+void SplitFields(const std::string_view line, const char delimiter, CsvRowView& fields)
+{
+    fields.clear();
+    std::size_t start = 0;
+    while (true) {
+        const auto found = line.find(delimiter, start);
+        if (found == std::string_view::npos) {
+            fields.push_back(line.substr(start));
+            return;
+        }
+        fields.push_back(line.substr(start, found - start));
+        start = found + 1;
+    }
+}
+
+CsvColumn MakeColumn(const CsvColumnType type)
+{
+    switch (type) {
+        case CsvColumnType::STRING:
+            return std::vector<std::string>{};
+        case CsvColumnType::INT64:
+            return std::vector<std::int64_t>{};
+        case CsvColumnType::DOUBLE:
+            return std::vector<double>{};
+    }
+    throw std::runtime_error{"[pbbam] CSV reader ERROR: unknown column type"};
+}
+
+template <typename T>
+T ParsedValue(const std::string_view text, const CsvColumnSpec& spec, const int recordNumber,
+              const std::string& filename)
+{
+    T value{};
+    const char* end = text.data() + text.size();
+    const auto result = std::from_chars(text.data(), end, value);
+    if (text.empty() || result.ec != std::errc{} || result.ptr != end) {
+        std::ostringstream s;
+        s << "[pbbam] CSV reader ERROR: could not parse numeric value\n"
+          << "    file : " << filename << '\n'
+          << "  record : " << recordNumber << '\n'
+          << "  column : " << spec.name << '\n'
+          << "   value : " << text << '\n';
+        throw std::runtime_error{s.str()};
+    }
+    return value;
+}
+
+void StoreValue(CsvColumn& column, const std::size_t row, const std::string_view text,
+                const CsvColumnSpec& spec, const int recordNumber, const std::string& filename)
+{
+    std::visit(
+        [&](auto& values) {
+            using T = typename std::decay_t<decltype(values)>::value_type;
+            if constexpr (std::is_same_v<T, std::string>) {
+                values[row].assign(text);
+            } else {
+                values[row] = ParsedValue<T>(text, spec, recordNumber, filename);
+            }
+        },
+        column);
+}
+
 char DetectDelimiter(const std::filesystem::path& filename)
 {
     constexpr std::array<char, 4> CANDIDATES{'\t', ',', ' ', '|'};
@@ -129,7 +204,33 @@ CsvReader::CsvReader(const std::filesystem::path& filename, const char delimiter
 
 const std::vector<std::string>& CsvReader::Comments() const { return comments_; }
 
-bool CsvReader::GetNext(CsvRecord& record)
+void CsvReader::CheckFieldCount(const std::size_t numFields, const int recordNumber) const
+{
+    if (numFields != header_.size()) {
+        std::ostringstream s;
+        s << "[pbbam] CSV reader ERROR: could not parse record, mismatched column/fields:\n"
+          << "      file : " << reader_.Filename() << '\n'
+          << "    record : " << recordNumber << '\n'
+          << "  expected : " << header_.size() << " columns\n"
+          << "  observed : " << numFields << " columns\n";
+        throw std::runtime_error{s.str()};
+    }
+}
+
+std::size_t CsvReader::ColumnIndex(const std::string_view name) const
+{
+    const auto found = std::find(header_.cbegin(), header_.cend(), name);
+    if (found == header_.cend()) {
+        std::ostringstream s;
+        s << "[pbbam] CSV reader ERROR: column not found\n"
+          << "    file : " << reader_.Filename() << '\n'
+          << "  column : " << name << '\n';
+        throw std::runtime_error{s.str()};
+    }
+    return std::distance(header_.cbegin(), found);
+}
+
+bool CsvReader::FetchRecordLine()
 {
     // likely EOF
     if (!reader_.GetNext(line_)) {
@@ -143,20 +244,20 @@ bool CsvReader::GetNext(CsvRecord& record)
         }
     }
     ++lineNumber_;
+    return true;
+}
+
+bool CsvReader::GetNext(CsvRecord& record)
+{
+    if (!FetchRecordLine()) {
+        return false;
+    }
 
     // split & validate
     boost::split(
         buffer_, line_, [this](const char c) { return c == delimiter_; },
         boost::token_compress_off);
-    if (buffer_.size() != header_.size()) {
-        std::ostringstream s;
-        s << "[pbbam] CSV reader ERROR: could not parse record, mismatched column/fields:\n"
-          << "      file : " << reader_.Filename() << '\n'
-          << "    record : " << lineNumber_ << '\n'
-          << "  expected : " << header_.size() << " columns\n"
-          << "  observed : " << buffer_.size() << " columns\n";
-        throw std::runtime_error{s.str()};
-    }
+    CheckFieldCount(buffer_.size(), lineNumber_);
 
     // make record from line
     for (int i = 0; i < Utility::Ssize(header_); ++i) {
@@ -167,8 +268,90 @@ bool CsvReader::GetNext(CsvRecord& record)
     return true;
 }
 
+bool CsvReader::GetNext(CsvRowView& row)
+{
+    if (!FetchRecordLine()) {
+        return false;
+    }
+    SplitFields(line_, delimiter_, row);
+    CheckFieldCount(row.size(), lineNumber_);
+    return true;
+}
+
 const CsvHeader& CsvReader::Header() const { return header_; }
 
+std::vector<CsvColumn> CsvReader::ReadColumns(const std::vector<CsvColumnSpec>& columns,
+                                              std::size_t numThreads)
+{
+    numThreads = std::max<std::size_t>(numThreads, 1);
+
+    std::vector<std::size_t> fieldIndices;
+    std::vector<CsvColumn> result;
+    for (const auto& spec : columns) {
+        fieldIndices.push_back(ColumnIndex(spec.name));
+        result.push_back(MakeColumn(spec.type));
+    }
+
+    // line buffers are reused across batches
+    std::vector<std::string> lines(COLUMN_BATCH_SIZE);
+    std::size_t numRows = 0;
+    while (true) {
+        const int firstRecordNumber = lineNumber_ + 1;
+        std::size_t batchSize = 0;
+        while (batchSize < COLUMN_BATCH_SIZE && FetchRecordLine()) {
+            lines[batchSize].swap(line_);
+            ++batchSize;
+        }
+        if (batchSize == 0) {
+            break;
+        }
+
+        for (auto& column : result) {
+            std::visit([&](auto& values) { values.resize(numRows + batchSize); }, column);
+        }
+
+        // each task writes to its own rows, in pre-sized columns
+        const auto parseRows = [&](const std::size_t begin, const std::size_t end) {
+            CsvRowView fields;
+            for (std::size_t i = begin; i < end; ++i) {
+                const int recordNumber = firstRecordNumber + static_cast<int>(i);
+                SplitFields(lines[i], delimiter_, fields);
+                CheckFieldCount(fields.size(), recordNumber);
+                for (std::size_t c = 0; c < columns.size(); ++c) {
+                    StoreValue(result[c], numRows + i, fields[fieldIndices[c]], columns[c],
+                               recordNumber, reader_.Filename());
+                }
+            }
+        };
+
+        if (numThreads == 1) {
+            parseRows(0, batchSize);
+        } else {
+            const std::size_t rowsPerTask = (batchSize + numThreads - 1) / numThreads;
+            std::vector<std::future<void>> tasks;
+            for (std::size_t begin = 0; begin < batchSize; begin += rowsPerTask) {
+                const std::size_t end = std::min(begin + rowsPerTask, batchSize);
+                tasks.push_back(std::async(std::launch::async, parseRows, begin, end));
+            }
+
+            // wait for all tasks before re-throwing any error
+            for (auto& task : tasks) {
+                task.wait();
+            }
+            for (auto& task : tasks) {
+                task.get();
+            }
+        }
+
+        numRows += batchSize;
+        if (batchSize < COLUMN_BATCH_SIZE) {
+            break;
+        }
+    }
+
+    return result;
+}
+
 void CsvReader::SkipAndStoreLeadingComments()
 {
     while (line_.starts_with("#")) {
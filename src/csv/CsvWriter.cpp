@@ -2,8 +2,6 @@
 
 #include <pbbam/csv/CsvWriter.h>
 
-#include <boost/algorithm/string.hpp>
-
 #include <sstream>
 #include <stdexcept>
 
@@ -11,8 +9,8 @@ namespace PacBio {
 namespace CSV {
 
 CsvWriter::CsvWriter(const std::filesystem::path& filename, CsvHeader header, const char delimiter,
-                     const std::vector<std::string>& comments)
-    : writer_{filename.string()}, header_{std::move(header)}, delimiter_(1, delimiter)
+                     const std::vector<std::string>& comments, const std::size_t numThreads)
+    : writer_{filename.string(), numThreads}, header_{std::move(header)}, delimiter_{delimiter}
 {
     for (const auto& comment : comments) {
         writer_.Write(comment);
@@ -24,21 +22,28 @@ CsvWriter::CsvWriter(const std::filesystem::path& filename, CsvHeader header, co
           << "  file: " << filename;
         throw std::runtime_error{s.str()};
     }
-    const std::string headerText{boost::join(header_, delimiter_)};
-    writer_.Write(headerText);
-
-    fields_.reserve(header_.size());
+    for (std::size_t i = 0; i < header_.size(); ++i) {
+        if (i > 0) {
+            line_.push_back(delimiter_);
+        }
+        line_.append(header_[i]);
+    }
+    writer_.Write(line_);
 }
 
+void CsvWriter::Close() { writer_.Close(); }
+
 void CsvWriter::Write(const CsvRecord& record)
 {
-    fields_.clear();
-    for (const auto& column : header_) {
-        fields_.push_back(record.at(column));
+    // join fields in the reused line buffer
+    line_.clear();
+    for (std::size_t i = 0; i < header_.size(); ++i) {
+        if (i > 0) {
+            line_.push_back(delimiter_);
+        }
+        line_.append(record.at(header_[i]));
     }
-
-    const std::string recordText{boost::join(fields_, delimiter_)};
-    writer_.Write(recordText);
+    writer_.Write(line_);
 }
 
 }  // namespace CSV
@@ -2,20 +2,63 @@
 
 #include <pbbam/vcf/VcfFile.h>
 
+#include <pbbam/Deleters.h>
 #include <pbbam/vcf/VcfFormat.h>
+#include "../FileUtils.h"
 
+#include <htslib/bgzf.h>
+#include <htslib/tbx.h>
+
+#include <memory>
+#include <stdexcept>
 #include <type_traits>
 
 namespace PacBio {
 namespace VCF {
+namespace {
+
+// htslib default min_shift for CSI indices
+constexpr int CsiMinShift = 14;
+
+}  // namespace
 
 VcfFile::VcfFile(std::string fn)
     : filename_{std::move(fn)}, header_{VcfFormat::HeaderFromFile(filename_)}
 {}
 
+void VcfFile::EnsureIndexExists(const VcfIndexType type) const
+{
+    if (IndexExists()) {
+        return;
+    }
+
+    if (!IsCompressed()) {
+        throw std::runtime_error{
+            "[pbbam] VCF file ERROR: cannot index file that is not BGZF-compressed: " +
+            filename_};
+    }
+
+    const int minShift = (type == VcfIndexType::CSI ? CsiMinShift : 0);
+    if (tbx_index_build(filename_.c_str(), minShift, &tbx_conf_vcf) != 0) {
+        throw std::runtime_error{"[pbbam] VCF file ERROR: could not create index for file: " +
+                                 filename_};
+    }
+}
+
 const std::string& VcfFile::Filename() const { return filename_; }
 
 const VcfHeader& VcfFile::Header() const { return header_; }
 
+bool VcfFile::IndexExists() const
+{
+    return BAM::FileUtils::Exists(filename_ + ".tbi") || BAM::FileUtils::Exists(filename_ + ".csi");
+}
+
+bool VcfFile::IsCompressed() const
+{
+    std::unique_ptr<BGZF, BAM::HtslibBgzfDeleter> fp{bgzf_open(filename_.c_str(), "r")};
+    return fp && bgzf_compression(fp.get()) == bgzf;
+}
+
 }  // namespace VCF
 }  // namespace PacBio
@@ -2,20 +2,25 @@
 
 #include <pbbam/vcf/VcfFormat.h>
 
+#include <pbbam/Deleters.h>
 #include <pbbam/StringUtilities.h>
 #include <pbbam/vcf/VcfHeader.h>
 #include "VcfFormatException.h"
 
+#include <htslib/bgzf.h>
+#include <htslib/kstring.h>
 #include <htslib/vcf.h>
 
 #include <fstream>
 #include <istream>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
 
 namespace PacBio {
 namespace VCF {
@@ -410,8 +415,28 @@ VcfHeader VcfFormat::ParsedHeader(const std::string& hdrText)
 
 VcfHeader VcfFormat::HeaderFromFile(const std::string& fn)
 {
-    std::ifstream in(fn);
-    return HeaderFromStream(in);
+    // BGZF reads both plain-text & (b)gzipped input
+    std::unique_ptr<BGZF, BAM::HtslibBgzfDeleter> in{bgzf_open(fn.c_str(), "r")};
+    if (!in) {
+        throw std::runtime_error{"[pbbam] VCF format ERROR: could not open file: " + fn};
+    }
+
+    std::string text;
+    kstring_t line{0, 0, nullptr};
+    while (bgzf_getline(in.get(), '\n', &line) >= 0) {
+        if (line.l == 0) {
+            continue;
+        }
+        if (line.s[0] == '#') {
+            text.append(line.s, line.l);
+            text.push_back('\n');
+        } else {
+            break;
+        }
+    }
+    free(line.s);
+
+    return ParsedHeader(text);
 }
 
 VcfHeader VcfFormat::HeaderFromStream(std::istream& in)
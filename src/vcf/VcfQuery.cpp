@@ -11,6 +11,14 @@ VcfQuery::VcfQuery(std::string fn) : VcfQuery{VcfFile{std::move(fn)}} {}
 
 VcfQuery::VcfQuery(const VcfFile& file) : BAM::internal::QueryBase<VcfVariant>(), reader_{file} {}
 
+VcfQuery::VcfQuery(const VcfFile& file, const Data::GenomicInterval& interval)
+    : BAM::internal::QueryBase<VcfVariant>(), reader_{file, interval}
+{}
+
+VcfQuery::VcfQuery(const VcfFile& file, const std::vector<Data::GenomicInterval>& intervals)
+    : BAM::internal::QueryBase<VcfVariant>(), reader_{file, intervals}
+{}
+
 bool VcfQuery::GetNext(VcfVariant& var) { return reader_.GetNext(var); }
 
 }  // namespace VCF
@@ -2,42 +2,250 @@
 
 #include <pbbam/vcf/VcfReader.h>
 
+#include <pbbam/Deleters.h>
+#include "VcfFormatException.h"
+
+#include <htslib/bgzf.h>
+#include <htslib/hts.h>
+#include <htslib/kstring.h>
+#include <htslib/tbx.h>
+
+#include <algorithm>
+#include <charconv>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
 #include <type_traits>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 
 namespace PacBio {
 namespace VCF {
+namespace {
 
-VcfReader::VcfReader(std::string fn) : VcfReader{VcfFile{std::move(fn)}} {}
+struct TabixIndexDeleter
+{
+    void operator()(tbx_t* tbx) const noexcept
+    {
+        if (tbx) {
+            tbx_destroy(tbx);
+        }
+    }
+};
 
-VcfReader::VcfReader(const VcfFile& file) : in_{file.Filename()}, header_{file.Header()}
+// index-space region, 0-based & half-open
+struct IndexedRegion
 {
-    // skip header lines
-    const auto& header = file.Header();
-    std::string line;
-    for (std::size_t i = header.NumLines(); i > 0; --i) {
-        std::getline(in_, line);
+    int tid;
+    std::int64_t start;
+    std::int64_t stop;
+};
+
+}  // namespace
+
+struct VcfReader::VcfReaderPrivate
+{
+    explicit VcfReaderPrivate(const VcfFile& file)
+        : header_{file.Header()}, in_{bgzf_open(file.Filename().c_str(), "r")}
+    {
+        if (!in_) {
+            throw std::runtime_error{"[pbbam] VCF reader ERROR: could not open file: " +
+                                     file.Filename()};
+        }
+        FetchNext();
     }
 
-    FetchNext();
-}
+    VcfReaderPrivate(const VcfFile& file, const std::vector<Data::GenomicInterval>& intervals)
+        : header_{file.Header()}, in_{bgzf_open(file.Filename().c_str(), "r")}, isIndexed_{true}
+    {
+        if (!in_) {
+            throw std::runtime_error{"[pbbam] VCF reader ERROR: could not open file: " +
+                                     file.Filename()};
+        }
+        if (!file.IsCompressed()) {
+            throw std::runtime_error{
+                "[pbbam] VCF reader ERROR: region queries require a BGZF-compressed file: " +
+                file.Filename()};
+        }
+        index_.reset(tbx_index_load(file.Filename().c_str()));
+        if (!index_) {
+            throw std::runtime_error{"[pbbam] VCF reader ERROR: could not load index for file: " +
+                                     file.Filename()};
+        }
+
+        InitRegions(intervals);
+        FetchNext();
+    }
+
+    VcfReaderPrivate(const VcfReaderPrivate&) = delete;
+    VcfReaderPrivate& operator=(const VcfReaderPrivate&) = delete;
+
+    ~VcfReaderPrivate() { free(buffer_.s); }
+
+    void FetchNext()
+    {
+        line_.clear();
+        while (ReadLine()) {
+            if (buffer_.l == 0 || buffer_.s[0] == '#') {
+                continue;
+            }
+            if (isIndexed_ && ReturnedByPreviousRegion()) {
+                continue;
+            }
+            line_.assign(buffer_.s, buffer_.l);
+            return;
+        }
+    }
+
+    void InitRegions(const std::vector<Data::GenomicInterval>& intervals)
+    {
+        for (const auto& interval : intervals) {
+            const int tid = tbx_name2id(index_.get(), interval.Name().c_str());
+            if (tid < 0 || interval.Stop() <= interval.Start()) {
+                continue;  // contig has no variants
+            }
+            regions_.push_back(IndexedRegion{tid, interval.Start(), interval.Stop()});
+        }
+
+        // visit in file order, merging overlapping regions
+        std::sort(regions_.begin(), regions_.end(),
+                  [](const IndexedRegion& lhs, const IndexedRegion& rhs) {
+                      return std::tie(lhs.tid, lhs.start) < std::tie(rhs.tid, rhs.start);
+                  });
+        std::vector<IndexedRegion> merged;
+        for (const auto& region : regions_) {
+            if (!merged.empty() && merged.back().tid == region.tid &&
+                region.start <= merged.back().stop) {
+                merged.back().stop = std::max(merged.back().stop, region.stop);
+            } else {
+                merged.push_back(region);
+            }
+        }
+        regions_ = std::move(merged);
+    }
+
+    bool ReadLine()
+    {
+        if (!isIndexed_) {
+            const int result = bgzf_getline(in_.get(), '\n', &buffer_);
+            if (result < -1) {
+                throw std::runtime_error{"[pbbam] VCF reader ERROR: could not read from file"};
+            }
+            return result >= 0;
+        }
+
+        while (regionIndex_ < regions_.size()) {
+            if (!iter_) {
+                const auto& region = regions_[regionIndex_];
+                iter_.reset(tbx_itr_queryi(index_.get(), region.tid, region.start, region.stop));
+                if (!iter_) {
+                    throw std::runtime_error{
+                        "[pbbam] VCF reader ERROR: could not create index iterator"};
+                }
+            }
+
+            const int result = tbx_bgzf_itr_next(in_.get(), index_.get(), iter_.get(), &buffer_);
+            if (result >= 0) {
+                return true;
+            }
+            if (result < -1) {
+                throw std::runtime_error{"[pbbam] VCF reader ERROR: could not read from file"};
+            }
 
-void VcfReader::FetchNext()
+            // region exhausted
+            iter_.reset();
+            ++regionIndex_;
+        }
+        return false;
+    }
+
+    // A variant starting before the end of the previous (disjoint) region on
+    // the same contig must also overlap it, so it has already been returned.
+    bool ReturnedByPreviousRegion() const
+    {
+        if (regionIndex_ == 0) {
+            return false;
+        }
+        const auto& previous = regions_[regionIndex_ - 1];
+        if (previous.tid != regions_[regionIndex_].tid) {
+            return false;
+        }
+
+        const std::string_view text{buffer_.s, buffer_.l};
+        const auto chromEnd = text.find('\t');
+        const auto posEnd =
+            (chromEnd == std::string_view::npos) ? chromEnd : text.find('\t', chromEnd + 1);
+        if (posEnd == std::string_view::npos) {
+            throw VcfFormatException{"malformed variant line: " + std::string{text}};
+        }
+
+        std::int64_t pos = 0;
+        const auto result =
+            std::from_chars(text.data() + chromEnd + 1, text.data() + posEnd, pos);
+        if (result.ec != std::errc{}) {
+            throw VcfFormatException{"malformed variant position: " + std::string{text}};
+        }
+        return (pos - 1) < previous.stop;
+    }
+
+    VcfHeader header_;
+    std::unique_ptr<BGZF, BAM::HtslibBgzfDeleter> in_;
+    kstring_t buffer_{0, 0, nullptr};
+    std::string line_;
+
+    // region query state
+    bool isIndexed_ = false;
+    std::unique_ptr<tbx_t, TabixIndexDeleter> index_;
+    std::unique_ptr<hts_itr_t, BAM::HtslibIteratorDeleter> iter_;
+    std::vector<IndexedRegion> regions_;
+    std::size_t regionIndex_ = 0;
+};
+
+VcfReader::VcfReader(std::string fn) : VcfReader{VcfFile{std::move(fn)}} {}
+
+VcfReader::VcfReader(const VcfFile& file) : d_{std::make_unique<VcfReaderPrivate>(file)} {}
+
+VcfReader::VcfReader(const VcfFile& file, const Data::GenomicInterval& interval)
+    : VcfReader{file, std::vector<Data::GenomicInterval>{interval}}
+{}
+
+VcfReader::VcfReader(const VcfFile& file, const std::vector<Data::GenomicInterval>& intervals)
+    : d_{std::make_unique<VcfReaderPrivate>(file, intervals)}
+{}
+
+VcfReader::VcfReader(VcfReader&&) noexcept = default;
+
+VcfReader& VcfReader::operator=(VcfReader&&) noexcept = default;
+
+VcfReader::~VcfReader() = default;
+
+bool VcfReader::GetNext(VcfVariant& var)
 {
-    line_.clear();
-    std::getline(in_, line_);
+    if (d_->line_.empty()) {
+        return false;
+    }
+    var = VcfVariant{d_->line_};
+    d_->FetchNext();
+    return true;
 }
 
-bool VcfReader::GetNext(VcfVariant& var)
+bool VcfReader::GetNext(VcfVariantView& var)
 {
-    if (line_.empty()) {
+    if (d_->line_.empty()) {
         return false;
     }
-    var = VcfVariant{line_};
-    FetchNext();
+    var.SwapText(d_->line_);
+    d_->FetchNext();
     return true;
 }
 
-const VcfHeader& VcfReader::Header() const { return header_; }
+const VcfHeader& VcfReader::Header() const { return d_->header_; }
 
 }  // namespace VCF
 }  // namespace PacBio
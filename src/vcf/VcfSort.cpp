@@ -2,17 +2,350 @@
 
 #include <pbbam/vcf/VcfSort.h>
 
+#include <pbbam/Deleters.h>
+#include <pbbam/vcf/VcfFormat.h>
 #include <pbbam/vcf/VcfQuery.h>
 #include <pbbam/vcf/VcfWriter.h>
+#include "../FileProducer.h"
+#include "VcfFormatException.h"
+
+#include <htslib/bgzf.h>
+#include <htslib/kstring.h>
 
 #include <algorithm>
+#include <charconv>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
 namespace PacBio {
 namespace VCF {
+namespace {
+
+struct SortEntry
+{
+    std::size_t contigIndex;
+    std::int64_t position;
+    std::string line;
+};
+
+bool EntryLess(const SortEntry& lhs, const SortEntry& rhs)
+{
+    return std::tie(lhs.contigIndex, lhs.position) < std::tie(rhs.contigIndex, rhs.position);
+}
+
+void SortEntries(std::vector<SortEntry>& entries)
+{
+    std::stable_sort(entries.begin(), entries.end(), EntryLess);
+}
+
+///
+/// Computes sort keys from raw variant lines, reading only CHROM & POS.
+///
+class VariantKeyParser
+{
+public:
+    explicit VariantKeyParser(const VcfHeader& header)
+    {
+        const auto& contigDefs = header.ContigDefinitions();
+        for (std::size_t i = 0; i < contigDefs.size(); ++i) {
+            contigLookup_.emplace(contigDefs.at(i).Id(), i);
+        }
+    }
+
+    SortEntry MakeEntry(std::string line)
+    {
+        const std::string_view text{line};
+        const auto chromEnd = text.find('\t');
+        const auto posEnd = (chromEnd == std::string_view::npos)
+                                ? std::string_view::npos
+                                : text.find('\t', chromEnd + 1);
+        if (posEnd == std::string_view::npos) {
+            throw VcfFormatException{"malformed variant line: " + line};
+        }
+
+        std::int64_t position = 0;
+        const auto* posBegin = text.data() + chromEnd + 1;
+        const auto* posLast = text.data() + posEnd;
+        const auto result = std::from_chars(posBegin, posLast, position);
+        if (result.ec != std::errc{} || result.ptr != posLast) {
+            throw VcfFormatException{"malformed variant position: " + line};
+        }
+
+        const auto contigIndex = ContigIndex(text.substr(0, chromEnd));
+        return SortEntry{contigIndex, position, std::move(line)};
+    }
+
+private:
+    std::size_t ContigIndex(const std::string_view chrom)
+    {
+        // variants are typically grouped by contig, so skip the lookup (and
+        // its string copy) when the contig repeats
+        if (chrom != lastContig_ || lastContig_.empty()) {
+            lastContig_ = chrom;
+            const auto found = contigLookup_.find(lastContig_);
+            if (found == contigLookup_.cend()) {
+                lastContig_.clear();
+                throw VcfFormatException{"variant contig not found in header: " +
+                                         std::string{chrom}};
+            }
+            lastContigIndex_ = found->second;
+        }
+        return lastContigIndex_;
+    }
+
+    std::unordered_map<std::string, std::size_t> contigLookup_;
+    std::string lastContig_;
+    std::size_t lastContigIndex_ = 0;
+};
+
+///
+/// Temporary files holding sorted chunks of variant lines. Files are removed
+/// on destruction, if not already removed.
+///
+class SortedRuns
+{
+public:
+    SortedRuns(const std::string& outputFilename, const std::string& tempDirectory)
+    {
+        const std::filesystem::path outputPath{outputFilename};
+        std::filesystem::path dir = tempDirectory;
+        if (dir.empty()) {
+            dir = outputPath.parent_path();
+        }
+        prefix_ = (dir / outputPath.filename()).string() + ".sort.";
+    }
+
+    SortedRuns(const SortedRuns&) = delete;
+    SortedRuns& operator=(const SortedRuns&) = delete;
+
+    ~SortedRuns()
+    {
+        for (const auto& fn : filenames_) {
+            std::remove(fn.c_str());
+        }
+    }
+
+    std::string Add()
+    {
+        filenames_.push_back(prefix_ + std::to_string(numAdded_++) + ".tmp");
+        return filenames_.back();
+    }
+
+    void Remove(const std::string& fn)
+    {
+        std::remove(fn.c_str());
+        filenames_.erase(std::find(filenames_.begin(), filenames_.end(), fn));
+    }
+
+private:
+    std::string prefix_;
+    std::vector<std::string> filenames_;
+    std::size_t numAdded_ = 0;
+};
+
+///
+/// Reads variant lines from plain-text or BGZF-compressed input, skipping
+/// header & blank lines.
+///
+class VariantLineReader
+{
+public:
+    explicit VariantLineReader(std::string fn)
+        : fn_{std::move(fn)}, in_{bgzf_open(fn_.c_str(), "r")}
+    {
+        if (!in_) {
+            throw std::runtime_error{"[pbbam] VCF sort ERROR: could not open file: " + fn_};
+        }
+    }
+
+    VariantLineReader(const VariantLineReader&) = delete;
+    VariantLineReader& operator=(const VariantLineReader&) = delete;
+
+    ~VariantLineReader() { free(buffer_.s); }
+
+    bool GetNext(std::string& line)
+    {
+        while (true) {
+            const int result = bgzf_getline(in_.get(), '\n', &buffer_);
+            if (result < -1) {
+                throw std::runtime_error{"[pbbam] VCF sort ERROR: could not read from file: " +
+                                         fn_};
+            }
+            if (result == -1) {
+                return false;
+            }
+            if (buffer_.l == 0 || buffer_.s[0] == '#') {
+                continue;
+            }
+            line.assign(buffer_.s, buffer_.l);
+            return true;
+        }
+    }
+
+private:
+    std::string fn_;
+    std::unique_ptr<BGZF, BAM::HtslibBgzfDeleter> in_;
+    kstring_t buffer_{0, 0, nullptr};
+};
+
+void WriteRun(const std::string& fn, std::vector<SortEntry> entries)
+{
+    SortEntries(entries);
+
+    std::ofstream out{fn};
+    for (const auto& entry : entries) {
+        out << entry.line << '\n';
+    }
+    out.close();
+    if (!out) {
+        throw std::runtime_error{"[pbbam] VCF sort ERROR: could not write temp file: " + fn};
+    }
+}
+
+///
+/// Writes header & (unmodified) variant lines to the sorted output.
+///
+struct SortedVcfWriter : public BAM::FileProducer
+{
+    SortedVcfWriter(std::string fn, const VcfHeader& header)
+        : BAM::FileProducer{std::move(fn)}, out_{TempFilename()}
+    {
+        if (!out_) {
+            throw std::runtime_error{"[pbbam] VCF sort ERROR: could not open file: " +
+                                     TempFilename()};
+        }
+        out_ << VcfFormat::FormattedHeader(header) << '\n';
+    }
+
+    void Write(const std::string& line) { out_ << line << '\n'; }
+
+    // Calls 'writeLines', then flushes output, throwing if any write failed.
+    // On failure, the partial output is removed rather than renamed to the
+    // target file.
+    template <typename WriteLines>
+    void WriteAndClose(WriteLines&& writeLines)
+    {
+        try {
+            writeLines();
+            out_.close();
+            if (!out_) {
+                throw std::runtime_error{"[pbbam] VCF sort ERROR: could not write to file: " +
+                                         TempFilename()};
+            }
+        } catch (...) {
+            DiscardTempFile();
+            throw;
+        }
+    }
+
+    std::ofstream out_;
+};
+
+template <typename WriteLine>
+void MergeRuns(const std::vector<std::string>& runFilenames, VariantKeyParser& parser,
+               WriteLine&& writeLine)
+{
+    struct RunReader
+    {
+        std::ifstream in;
+        SortEntry current;
+    };
+
+    std::vector<RunReader> readers(runFilenames.size());
+    const auto fetchNext = [&](const std::size_t i) {
+        std::string line;
+        if (!std::getline(readers[i].in, line)) {
+            if (readers[i].in.bad()) {
+                throw std::runtime_error{"[pbbam] VCF sort ERROR: could not read temp file: " +
+                                         runFilenames[i]};
+            }
+            return false;
+        }
+        readers[i].current = parser.MakeEntry(std::move(line));
+        return true;
+    };
+
+    // min-heap on (key, run index), so equal keys keep their input order
+    const auto heapGreater = [&readers](const std::size_t lhs, const std::size_t rhs) {
+        const auto& l = readers[lhs].current;
+        const auto& r = readers[rhs].current;
+        return std::tie(l.contigIndex, l.position, lhs) > std::tie(r.contigIndex, r.position, rhs);
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(heapGreater)> heap{
+        heapGreater};
+
+    for (std::size_t i = 0; i < runFilenames.size(); ++i) {
+        readers[i].in.open(runFilenames[i]);
+        if (!readers[i].in) {
+            throw std::runtime_error{"[pbbam] VCF sort ERROR: could not read temp file: " +
+                                     runFilenames[i]};
+        }
+        if (fetchNext(i)) {
+            heap.push(i);
+        }
+    }
+
+    while (!heap.empty()) {
+        const auto i = heap.top();
+        heap.pop();
+        writeLine(readers[i].current.line);
+        if (fetchNext(i)) {
+            heap.push(i);
+        }
+    }
+}
+
+// Merges consecutive groups of at most 'maxFiles' runs, until no more than
+// 'maxFiles' remain. Grouping consecutive runs keeps equal keys in input order.
+std::vector<std::string> ReduceRuns(std::vector<std::string> runFilenames,
+                                    const std::size_t maxFiles, VariantKeyParser& parser,
+                                    SortedRuns& runs)
+{
+    while (runFilenames.size() > maxFiles) {
+        std::vector<std::string> merged;
+        for (std::size_t first = 0; first < runFilenames.size(); first += maxFiles) {
+            const auto last = std::min(first + maxFiles, runFilenames.size());
+            if (last - first == 1) {
+                merged.push_back(runFilenames[first]);
+                continue;
+            }
+
+            const std::vector<std::string> group{runFilenames.begin() + first,
+                                                 runFilenames.begin() + last};
+            merged.push_back(runs.Add());
+            std::ofstream out{merged.back()};
+            MergeRuns(group, parser, [&out](const std::string& line) { out << line << '\n'; });
+            out.close();
+            if (!out) {
+                throw std::runtime_error{"[pbbam] VCF sort ERROR: could not write temp file: " +
+                                         merged.back()};
+            }
+            for (const auto& fn : group) {
+                runs.Remove(fn);
+            }
+        }
+        runFilenames = std::move(merged);
+    }
+    return runFilenames;
+}
+
+}  // namespace
 
 void SortFile(const VcfFile& file, const std::string& outputFilename)
 {
@@ -54,5 +387,81 @@ void SortFile(const std::string& inputFilename, const std::string& outputFilenam
     SortFile(VcfFile{inputFilename}, outputFilename);
 }
 
+void SortFile(const VcfFile& file, const std::string& outputFilename, const SortConfig& config)
+{
+    const auto& header = file.Header();
+    VariantKeyParser parser{header};
+
+    VariantLineReader in{file.Filename()};
+    std::string line;
+
+    // The chunk being read and up to 'numThreads' chunks being sorted share
+    // the memory budget.
+    const std::size_t numThreads = std::max<std::size_t>(config.numThreads, 1);
+    const std::size_t chunkBudget = std::max<std::size_t>(config.maxMemory / (numThreads + 1), 1);
+
+    SortedRuns runs{outputFilename, config.tempDirectory};
+    std::vector<std::string> runFilenames;
+    std::deque<std::future<void>> pendingRuns;
+    std::vector<SortEntry> chunk;
+    std::size_t chunkBytes = 0;
+
+    const auto spillChunk = [&]() {
+        if (pendingRuns.size() >= numThreads) {
+            pendingRuns.front().get();
+            pendingRuns.pop_front();
+        }
+        runFilenames.push_back(runs.Add());
+        pendingRuns.push_back(
+            std::async(std::launch::async, WriteRun, runFilenames.back(), std::move(chunk)));
+        chunk = std::vector<SortEntry>{};
+        chunkBytes = 0;
+    };
+
+    // read input in chunks, sorting & spilling each full chunk to a temp file
+    while (in.GetNext(line)) {
+        chunkBytes += sizeof(SortEntry) + line.size();
+        chunk.push_back(parser.MakeEntry(std::move(line)));
+        if (chunkBytes >= chunkBudget) {
+            spillChunk();
+        }
+    }
+
+    // input fit in memory, no merge needed
+    if (runFilenames.empty()) {
+        SortEntries(chunk);
+        SortedVcfWriter writer{outputFilename, header};
+        writer.WriteAndClose([&]() {
+            for (const auto& entry : chunk) {
+                writer.Write(entry.line);
+            }
+        });
+        return;
+    }
+
+    // otherwise, finish remaining runs and merge
+    if (!chunk.empty()) {
+        spillChunk();
+    }
+    while (!pendingRuns.empty()) {
+        pendingRuns.front().get();
+        pendingRuns.pop_front();
+    }
+
+    const std::size_t maxFiles = std::max<std::size_t>(config.maxMergeFiles, 2);
+    runFilenames = ReduceRuns(std::move(runFilenames), maxFiles, parser, runs);
+
+    SortedVcfWriter writer{outputFilename, header};
+    writer.WriteAndClose([&]() {
+        MergeRuns(runFilenames, parser, [&writer](const std::string& line) { writer.Write(line); });
+    });
+}
+
+void SortFile(const std::string& inputFilename, const std::string& outputFilename,
+              const SortConfig& config)
+{
+    SortFile(VcfFile{inputFilename}, outputFilename, config);
+}
+
 }  // namespace VCF
 }  // namespace PacBio
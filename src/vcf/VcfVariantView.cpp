@@ -0,0 +1,301 @@
+#include "../PbbamInternalConfig.h"
+
+#include <pbbam/vcf/VcfVariantView.h>
+
+#include <pbbam/vcf/VcfFormat.h>
+#include "VcfFormatException.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+#include <cmath>
+#include <cstdlib>
+
+namespace PacBio {
+namespace VCF {
+namespace {
+
+// fixed column indices
+constexpr std::size_t CHROM = 0;
+constexpr std::size_t POS = 1;
+constexpr std::size_t ID = 2;
+constexpr std::size_t REF = 3;
+constexpr std::size_t ALT = 4;
+constexpr std::size_t QUAL = 5;
+constexpr std::size_t FILTER = 6;
+constexpr std::size_t INFO = 7;
+constexpr std::size_t NumFixedColumns = 8;
+
+}  // namespace
+
+VcfVariantView::VcfVariantView()
+    : genotypesOffset_{std::string::npos}, pos_{Data::UNMAPPED_POSITION}
+{}
+
+VcfVariantView::VcfVariantView(std::string text) : VcfVariantView{}
+{
+    SwapText(text);
+}
+
+std::string_view VcfVariantView::AltAllele() const
+{
+    return columns_.size() > ALT ? View(columns_[ALT]) : std::string_view{};
+}
+
+std::string_view VcfVariantView::Chrom() const
+{
+    return columns_.size() > CHROM ? View(columns_[CHROM]) : std::string_view{};
+}
+
+std::string_view VcfVariantView::Filter() const
+{
+    return columns_.size() > FILTER ? View(columns_[FILTER]) : std::string_view{};
+}
+
+std::vector<std::string_view> VcfVariantView::GenotypeIds() const
+{
+    ParseGenotypes();
+    std::vector<std::string_view> result;
+    result.reserve(format_.size());
+    for (const auto& span : format_) {
+        result.push_back(View(span));
+    }
+    return result;
+}
+
+std::optional<std::string_view> VcfVariantView::GenotypeValue(const std::size_t sampleIndex,
+                                                              const std::string_view id) const
+{
+    ParseGenotypes();
+
+    // find field index from FORMAT
+    const auto found = std::find_if(format_.cbegin(), format_.cend(),
+                                    [&](const Span& span) { return View(span) == id; });
+    if (found == format_.cend()) {
+        return std::nullopt;
+    }
+    auto fieldIndex = std::distance(format_.cbegin(), found);
+
+    // scan sample column for that field
+    std::string_view sample = View(samples_.at(sampleIndex));
+    while (fieldIndex > 0) {
+        const auto colon = sample.find(':');
+        if (colon == std::string_view::npos) {
+            return std::nullopt;  // trailing fields may be dropped
+        }
+        sample.remove_prefix(colon + 1);
+        --fieldIndex;
+    }
+    return sample.substr(0, sample.find(':'));
+}
+
+bool VcfVariantView::HasInfoField(const std::string_view id) const
+{
+    ParseInfo();
+    return std::any_of(info_.cbegin(), info_.cend(),
+                       [&](const auto& field) { return View(field.first) == id; });
+}
+
+std::string_view VcfVariantView::Id() const
+{
+    return columns_.size() > ID ? View(columns_[ID]) : std::string_view{};
+}
+
+std::string_view VcfVariantView::InfoText() const
+{
+    return columns_.size() > INFO ? View(columns_[INFO]) : std::string_view{};
+}
+
+std::optional<std::string_view> VcfVariantView::InfoValue(const std::string_view id) const
+{
+    ParseInfo();
+    for (const auto& [key, value] : info_) {
+        if (View(key) == id) {
+            if (value) {
+                return View(*value);
+            }
+            return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+bool VcfVariantView::IsDeletion() const { return RefAllele().size() > AltAllele().size(); }
+
+bool VcfVariantView::IsInsertion() const { return RefAllele().size() < AltAllele().size(); }
+
+bool VcfVariantView::IsQualityMissing() const { return std::isnan(Quality()); }
+
+bool VcfVariantView::IsSnp() const
+{
+    const auto ref = RefAllele();
+    const auto alt = AltAllele();
+    return ref.size() == 1 && alt.size() == 1 && ref[0] != alt[0];
+}
+
+std::size_t VcfVariantView::NumSamples() const
+{
+    ParseGenotypes();
+    return samples_.size();
+}
+
+void VcfVariantView::ParseFixedColumns()
+{
+    columns_.clear();
+    genotypesOffset_ = std::string::npos;
+    pos_ = Data::UNMAPPED_POSITION;
+    infoParsed_ = false;
+    genotypesParsed_ = false;
+
+    if (text_.empty()) {
+        return;
+    }
+
+    // only split CHROM - INFO here, genotype columns are split on demand
+    std::size_t start = 0;
+    while (columns_.size() < NumFixedColumns) {
+        const auto tab = text_.find('\t', start);
+        if (tab == std::string::npos) {
+            columns_.emplace_back(start, text_.size() - start);
+            break;
+        }
+        columns_.emplace_back(start, tab - start);
+        start = tab + 1;
+        if (columns_.size() == NumFixedColumns) {
+            genotypesOffset_ = start;
+        }
+    }
+
+    if (columns_.size() < 7) {
+        throw VcfFormatException{"record is missing required fields: " + text_};
+    }
+
+    const auto posText = View(columns_[POS]);
+    const auto result = std::from_chars(posText.data(), posText.data() + posText.size(), pos_);
+    if (result.ec != std::errc{}) {
+        throw VcfFormatException{"malformed variant position: " + text_};
+    }
+}
+
+void VcfVariantView::ParseGenotypes() const
+{
+    if (genotypesParsed_) {
+        return;
+    }
+    genotypesParsed_ = true;
+    format_.clear();
+    samples_.clear();
+
+    if (genotypesOffset_ == std::string::npos) {
+        return;
+    }
+
+    // split FORMAT & sample columns
+    std::vector<Span> columns;
+    std::size_t start = genotypesOffset_;
+    while (true) {
+        const auto tab = text_.find('\t', start);
+        if (tab == std::string::npos) {
+            columns.emplace_back(start, text_.size() - start);
+            break;
+        }
+        columns.emplace_back(start, tab - start);
+        start = tab + 1;
+    }
+
+    // FORMAT is only meaningful with samples
+    if (columns.size() < 2) {
+        return;
+    }
+
+    const std::size_t formatOffset = columns.front().first;
+    const std::string_view format = View(columns.front());
+    std::size_t fieldStart = 0;
+    while (true) {
+        const auto colon = format.find(':', fieldStart);
+        if (colon == std::string_view::npos) {
+            format_.emplace_back(formatOffset + fieldStart, format.size() - fieldStart);
+            break;
+        }
+        format_.emplace_back(formatOffset + fieldStart, colon - fieldStart);
+        fieldStart = colon + 1;
+    }
+
+    samples_.assign(columns.cbegin() + 1, columns.cend());
+}
+
+void VcfVariantView::ParseInfo() const
+{
+    if (infoParsed_) {
+        return;
+    }
+    infoParsed_ = true;
+    info_.clear();
+
+    if (columns_.size() <= INFO) {
+        return;
+    }
+
+    // split on ';' & '=', searching only within the INFO column
+    const std::size_t infoOffset = columns_[INFO].first;
+    const std::string_view info = View(columns_[INFO]);
+    std::size_t fieldStart = 0;
+    while (fieldStart <= info.size()) {
+        auto fieldEnd = info.find(';', fieldStart);
+        if (fieldEnd == std::string_view::npos) {
+            fieldEnd = info.size();
+        }
+
+        const auto equals = info.find('=', fieldStart);
+        if (equals != std::string_view::npos && equals < fieldEnd) {
+            info_.emplace_back(Span{infoOffset + fieldStart, equals - fieldStart},
+                               Span{infoOffset + equals + 1, fieldEnd - equals - 1});
+        } else {
+            info_.emplace_back(Span{infoOffset + fieldStart, fieldEnd - fieldStart},
+                               std::nullopt);
+        }
+        fieldStart = fieldEnd + 1;
+    }
+}
+
+Data::Position VcfVariantView::Position() const { return pos_; }
+
+float VcfVariantView::Quality() const
+{
+    if (columns_.size() <= QUAL) {
+        return NAN;
+    }
+    const auto qual = View(columns_[QUAL]);
+    if (qual == ".") {
+        return NAN;
+    }
+
+    // strtof stops at the following tab
+    return std::strtof(text_.data() + columns_[QUAL].first, nullptr);
+}
+
+std::string_view VcfVariantView::RefAllele() const
+{
+    return columns_.size() > REF ? View(columns_[REF]) : std::string_view{};
+}
+
+void VcfVariantView::SwapText(std::string& text)
+{
+    text_.swap(text);
+    ParseFixedColumns();
+}
+
+const std::string& VcfVariantView::Text() const { return text_; }
+
+VcfVariant VcfVariantView::ToVariant() const { return VcfFormat::ParsedVariant(text_); }
+
+std::string_view VcfVariantView::View(const Span& span) const
+{
+    return std::string_view{text_}.substr(span.first, span.second);
+}
+
+}  // namespace VCF
+}  // namespace PacBio
@@ -1,5 +1,7 @@
 #include <pbbam/BamReader.h>
 
+#include <pbbam/BamRecord.h>
+
 #include <sstream>
 
 #include <gtest/gtest.h>
@@ -19,3 +21,45 @@ TEST(BAM_BamReader, handles_zero_byte_file)
                     std::string::npos);
     }
 }
+
+TEST(BAM_BamReader, raw_passthrough_matches_normal_read)
+{
+    const std::string fn{BAM::PbbamTestsConfig::Data_Dir + "/aligned.bam"};
+    BAM::BamReader reader{fn};
+    BAM::BamReader rawReader{fn};
+
+    BAM::BamRecord record;
+    BAM::BamRecord rawRecord;
+    int count = 0;
+    while (reader.GetNext(record)) {
+        ASSERT_TRUE(rawReader.GetNextRaw(rawRecord));
+        EXPECT_EQ(record.FullName(), rawRecord.FullName());
+        EXPECT_EQ(record.ReferenceStart(), rawRecord.ReferenceStart());
+        EXPECT_EQ(record.ReadGroupId(), rawRecord.ReadGroupId());
+        EXPECT_EQ(record.Impl().Tags().size(), rawRecord.Impl().Tags().size());
+        ++count;
+    }
+    EXPECT_FALSE(rawReader.GetNextRaw(rawRecord));
+    EXPECT_EQ(4, count);
+}
+
+TEST(BAM_BamReader, reused_record_follows_current_reader_header)
+{
+    const std::string alignedFn{BAM::PbbamTestsConfig::Data_Dir + "/aligned.bam"};
+    const std::string phi29Fn{BAM::PbbamTestsConfig::Data_Dir + "/phi29.bam"};
+    BAM::BamReader alignedReader{alignedFn};
+    BAM::BamReader phi29Reader{phi29Fn};
+
+    BAM::BamRecord record;
+    ASSERT_TRUE(alignedReader.GetNext(record));
+    EXPECT_EQ(alignedReader.Header().ToSam(), record.Header().ToSam());
+    ASSERT_TRUE(alignedReader.GetNext(record));
+    EXPECT_EQ(alignedReader.Header().ToSam(), record.Header().ToSam());
+
+    ASSERT_TRUE(phi29Reader.GetNext(record));
+    EXPECT_EQ(phi29Reader.Header().ToSam(), record.Header().ToSam());
+    EXPECT_NE(alignedReader.Header().ToSam(), record.Header().ToSam());
+
+    ASSERT_TRUE(alignedReader.GetNext(record));
+    EXPECT_EQ(alignedReader.Header().ToSam(), record.Header().ToSam());
+}
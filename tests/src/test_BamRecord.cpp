@@ -1,6 +1,7 @@
 #include <pbbam/BamRecord.h>
 
 #include <pbbam/BamReader.h>
+#include <pbbam/BamRecordEditor.h>
 #include <pbbam/BamTagCodec.h>
 #include <pbbam/RecordType.h>
 #include "../src/MemoryUtils.h"
@@ -10,6 +11,8 @@
 
 #include <gtest/gtest.h>
 
+#include <htslib/sam.h>
+
 #include <array>
 #include <exception>
 #include <initializer_list>
@@ -20,6 +23,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 // clang-format off
 
@@ -2663,6 +2667,38 @@ TEST(BAM_BamRecord, correctly_describes_pulse_exclusion_tag)
 
 }
 
+TEST(BAM_BamRecord, pulse_call_edit_resets_pulse_to_base_mapping)
+{
+    BamRecord bam;
+    bam.PulseCall("ACccTT");
+    EXPECT_EQ("ACTT", bam.PulseCall(Data::Orientation::NATIVE, false, false,
+                                    PulseBehavior::BASECALLS_ONLY));
+
+    bam.PulseCall("aaGGtT");
+    EXPECT_EQ("GGT", bam.PulseCall(Data::Orientation::NATIVE, false, false,
+                                   PulseBehavior::BASECALLS_ONLY));
+}
+
+TEST(BAM_BamRecord, const_reset_clears_pulse_to_base_mapping)
+{
+    BamRecord bam;
+    bam.PulseCall("ACccTT");
+    EXPECT_EQ("ACTT", bam.PulseCall(Data::Orientation::NATIVE, false, false,
+                                    PulseBehavior::BASECALLS_ONLY));
+
+    // overwrite raw tag data in place, as a reader filling the record would,
+    // bypassing BamRecord's & BamRecordImpl's cache handling
+    bam1_t* b = BamRecordMemory::GetRawData(bam).get();
+    std::uint8_t* pulseCalls = bam_aux_get(b, "pc");
+    ASSERT_NE(nullptr, pulseCalls);
+    std::memcpy(pulseCalls + 1, "aaGGtT", 6);
+
+    const BamRecord& constBam = bam;
+    constBam.ResetCachedPositions();
+    EXPECT_EQ("GGT", bam.PulseCall(Data::Orientation::NATIVE, false, false,
+                                   PulseBehavior::BASECALLS_ONLY));
+}
+
 TEST(BAM_BamRecord, correctly_describes_transcript_record)
 {
     const std::string readTypeStr{"TRANSCRIPT"};
@@ -2897,6 +2933,73 @@ TEST(BAM_BamRecord, can_determine_num_deletion_operations)
     }
 }
 
+TEST(BAM_BamRecord, can_determine_cigar_statistics)
+{
+    const auto record = BamRecordTests::MakeCigaredRecord(
+        "GATTACAGATTACAG",
+        "2S4=3I4D1X2I2=1S",
+        Data::Strand::FORWARD
+    );
+
+    const auto& stats = record.CigarStatistics();
+    EXPECT_EQ(6, stats.numMatches);
+    EXPECT_EQ(1, stats.numMismatches);
+    EXPECT_EQ(5, stats.numInsertedBases);
+    EXPECT_EQ(4, stats.numDeletedBases);
+    EXPECT_EQ(2, stats.numInsertionOperations);
+    EXPECT_EQ(1, stats.numDeletionOperations);
+    EXPECT_EQ(11, stats.referenceSpan);
+    EXPECT_EQ(2, stats.alignedStartOffset);
+    EXPECT_EQ(14, stats.alignedEndOffset);
+
+    EXPECT_EQ(6, record.NumMatches());
+    EXPECT_EQ(1, record.NumMismatches());
+    EXPECT_EQ(11, record.ReferenceEnd());
+}
+
+TEST(BAM_BamRecord, cigar_statistics_are_updated_after_edits)
+{
+    auto record = BamRecordTests::MakeCigaredRecord(
+        "GATTACAGATTACA",
+        "14=",
+        Data::Strand::FORWARD
+    );
+    EXPECT_EQ(14, record.NumMatches());
+    EXPECT_EQ(14, record.ReferenceEnd());
+
+    record.Impl().CigarData("4=3I4D1=2I4=");
+    EXPECT_EQ(9, record.NumMatches());
+    EXPECT_EQ(5, record.NumInsertedBases());
+    EXPECT_EQ(13, record.ReferenceEnd());
+
+    record.Map(0, 100, Data::Strand::FORWARD, Data::Cigar::FromStdString("10=4S"), 60);
+    EXPECT_EQ(10, record.NumMatches());
+    EXPECT_EQ(0, record.NumInsertedBases());
+    EXPECT_EQ(110, record.ReferenceEnd());
+    EXPECT_EQ(10, record.CigarStatistics().alignedEndOffset);
+}
+
+TEST(BAM_BamRecord, cigar_statistics_follow_edits_through_held_impl_reference)
+{
+    auto record = BamRecordTests::MakeCigaredRecord(
+        "GATTACAGATTACA",
+        "14=",
+        Data::Strand::FORWARD
+    );
+    auto& impl = record.Impl();
+    EXPECT_EQ(14, record.NumMatches());
+
+    // edited after stats were computed
+    impl.CigarData("4=3I4D1=2I4=");
+    EXPECT_EQ(9, record.NumMatches());
+    EXPECT_EQ(13, record.ReferenceEnd());
+
+    BamRecordEditor{impl}.CigarData(Data::Cigar::FromStdString("2S12=")).Commit();
+    EXPECT_EQ(12, record.NumMatches());
+    EXPECT_EQ(12, record.ReferenceEnd());
+    EXPECT_EQ(2, record.CigarStatistics().alignedStartOffset);
+}
+
 TEST(BAM_BamRecord, throws_on_null_tags)
 {
     {
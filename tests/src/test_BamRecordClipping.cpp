@@ -3230,3 +3230,41 @@ TEST(BAM_BamRecordClipping, clips_subread_pileup_tags)
         EXPECT_EQ(record.Impl().TagValue("sx").ToUInt8Array(), result.RetainedMismatches);
     }
 }
+
+TEST(BAM_BamRecordClipping, clips_lossy_kinetics_with_matching_codecs)
+{
+    // IPD & pulse width use different V2 codecs
+    const Data::V2FrameEncoder ipdEncoder{2, 6};
+    const Data::V2FrameEncoder pwEncoder{3, 5};
+    ReadGroupInfo rg{"movie", "SUBREAD"};
+    rg.IpdCodec(Data::FrameCodec::V2);
+    rg.IpdFrameEncoder(ipdEncoder);
+    rg.PulseWidthCodec(Data::FrameCodec::V2);
+    rg.PulseWidthFrameEncoder(pwEncoder);
+
+    // stored as raw frames, so clipping must encode them with the read group's codecs
+    const f_data frames{1, 30, 70, 150, 300, 700, 1500, 3000, 6000, 9000};
+    BamRecordImpl impl;
+    impl.SetSequenceAndQualities("AACCGTTAGC", "?]?]?]?]?*");
+    TagCollection tags;
+    tags["qs"] = std::int32_t{500};
+    tags["qe"] = std::int32_t{510};
+    tags["ip"] = frames;
+    tags["pw"] = frames;
+    impl.Tags(tags);
+
+    BamRecord record{std::move(impl)};
+    record.header_.AddReadGroup(rg);
+    record.ReadGroup(rg);
+    record.Clip(ClipType::CLIP_TO_QUERY, 502, 509);
+
+    const f_data clipped{frames.begin() + 2, frames.begin() + 9};
+    EXPECT_EQ(ipdEncoder.Decode(ipdEncoder.Encode(clipped)).Data(), record.IPD().Data());
+    EXPECT_EQ(pwEncoder.Decode(pwEncoder.Encode(clipped)).Data(), record.PulseWidth().Data());
+    EXPECT_EQ(pwEncoder.Encode(clipped), record.Impl().TagValue("pw").ToUInt8Array());
+
+    // stored codes are clipped as-is
+    record.Clip(ClipType::CLIP_TO_QUERY, 503, 508);
+    const f_data reclipped{clipped.begin() + 1, clipped.begin() + 6};
+    EXPECT_EQ(pwEncoder.Encode(reclipped), record.Impl().TagValue("pw").ToUInt8Array());
+}
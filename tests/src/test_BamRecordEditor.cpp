@@ -0,0 +1,173 @@
+#include <pbbam/BamRecordEditor.h>
+
+#include <cstdint>
+#include <cstring>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbbam/BamRecord.h>
+#include <pbbam/BamRecordImpl.h>
+
+#include "../src/MemoryUtils.h"
+
+using namespace PacBio;
+using namespace PacBio::BAM;
+
+namespace BamRecordEditorTests {
+
+BamRecordImpl MakeRecord()
+{
+    TagCollection tags;
+    tags["XY"] = std::int32_t{-42};
+    tags["CA"] = std::vector<std::uint8_t>({34, 5, 125});
+    tags["HX"] = std::string("1abc75");
+    tags["HX"].Modifier(TagModifier::HEX_STRING);
+
+    BamRecordImpl bam;
+    bam.Name("movie/1/0_4");
+    bam.SetSequenceAndQualities("ACGT", "?]?]");
+    bam.CigarData(Data::Cigar::FromStdString("4="));
+    bam.Tags(tags);
+    return bam;
+}
+
+void CheckSameData(const BamRecordImpl& expected, const BamRecordImpl& observed)
+{
+    EXPECT_EQ(expected.Name(), observed.Name());
+    EXPECT_EQ(expected.Sequence(), observed.Sequence());
+    EXPECT_EQ(expected.Qualities().Fastq(), observed.Qualities().Fastq());
+    EXPECT_EQ(expected.CigarData().ToStdString(), observed.CigarData().ToStdString());
+
+    // byte-for-byte, so that tag order is checked as well
+    const auto& expectedData = BamRecordMemory::GetRawData(expected);
+    const auto& observedData = BamRecordMemory::GetRawData(observed);
+    EXPECT_EQ(expectedData->core.l_qname, observedData->core.l_qname);
+    EXPECT_EQ(expectedData->core.l_extranul, observedData->core.l_extranul);
+    EXPECT_EQ(expectedData->core.n_cigar, observedData->core.n_cigar);
+    EXPECT_EQ(expectedData->core.l_qseq, observedData->core.l_qseq);
+    ASSERT_EQ(expectedData->l_data, observedData->l_data);
+    EXPECT_EQ(0, std::memcmp(expectedData->data, observedData->data, expectedData->l_data));
+}
+
+}  // namespace BamRecordEditorTests
+
+TEST(BAM_BamRecordEditor, edits_are_not_applied_before_commit)
+{
+    BamRecordImpl bam = BamRecordEditorTests::MakeRecord();
+    {
+        BamRecordEditor editor{bam};
+        editor.Name("other").RemoveTag("XY");
+    }
+    EXPECT_EQ("movie/1/0_4", bam.Name());
+    EXPECT_TRUE(bam.HasTag("XY"));
+}
+
+TEST(BAM_BamRecordEditor, matches_individual_setters)
+{
+    BamRecordImpl expected = BamRecordEditorTests::MakeRecord();
+    expected.Name("movie/1/ccs");
+    expected.SetSequenceAndQualities("ACGTACGT", "IIIIHHHH");
+    expected.CigarData(Data::Cigar::FromStdString("4=2I2="));
+    expected.EditTag("XY", std::int32_t{7});
+    expected.RemoveTag("CA");
+    expected.AddTag("np", std::int32_t{10});
+    expected.AddTag("zm", std::int32_t{42});
+
+    BamRecordImpl observed = BamRecordEditorTests::MakeRecord();
+    BamRecordEditor{observed}
+        .Name("movie/1/ccs")
+        .SequenceAndQualities("ACGTACGT", "IIIIHHHH")
+        .CigarData(Data::Cigar::FromStdString("4=2I2="))
+        .SetTag("XY", std::int32_t{7})
+        .RemoveTag("CA")
+        .SetTag("np", std::int32_t{10})
+        .SetTag(BamRecordTag::HOLE_NUMBER, std::int32_t{42})
+        .Commit();
+
+    BamRecordEditorTests::CheckSameData(expected, observed);
+}
+
+TEST(BAM_BamRecordEditor, can_set_sequence_without_qualities)
+{
+    BamRecordImpl bam = BamRecordEditorTests::MakeRecord();
+    BamRecordEditor{bam}.SequenceAndQualities("ACGTAC").Commit();
+
+    EXPECT_EQ("ACGTAC", bam.Sequence());
+    EXPECT_TRUE(bam.Qualities().empty());
+    EXPECT_EQ(-42, bam.TagValue("XY").ToInt32());
+}
+
+TEST(BAM_BamRecordEditor, replaced_tags_keep_their_position)
+{
+    BamRecordImpl expected = BamRecordEditorTests::MakeRecord();
+    expected.EditTag("CA", std::string{"replaced"});
+    expected.AddTag("aa", std::string{"new"});
+
+    BamRecordImpl observed = BamRecordEditorTests::MakeRecord();
+    BamRecordEditor{observed}
+        .SetTag("aa", std::string{"new"})
+        .SetTag("CA", std::string{"replaced"})
+        .Commit();
+
+    BamRecordEditorTests::CheckSameData(expected, observed);
+    EXPECT_EQ("replaced", observed.TagValue("CA").ToString());
+    EXPECT_EQ("new", observed.TagValue("aa").ToString());
+}
+
+TEST(BAM_BamRecordEditor, can_clear_tags)
+{
+    BamRecordImpl bam = BamRecordEditorTests::MakeRecord();
+    BamRecordEditor{bam}
+        .SetTag("XY", std::int32_t{1})
+        .ClearTags()
+        .SetTag("zz", std::string{"x"})
+        .Commit();
+
+    const TagCollection tags = bam.Tags();
+    ASSERT_EQ(1, tags.size());
+    EXPECT_TRUE(bam.HasTag("zz"));
+    EXPECT_FALSE(bam.HasTag("XY"));
+    EXPECT_EQ("ACGT", bam.Sequence());
+}
+
+TEST(BAM_BamRecordEditor, can_be_reused_after_commit)
+{
+    BamRecordImpl bam = BamRecordEditorTests::MakeRecord();
+    BamRecordEditor editor{bam};
+
+    editor.SetTag("np", std::int32_t{1}).Commit();
+    EXPECT_EQ(1, bam.TagValue("np").ToInt32());
+
+    editor.SetTag("np", std::int32_t{2}).RemoveTag("XY").Commit();
+    EXPECT_EQ(2, bam.TagValue("np").ToInt32());
+    EXPECT_FALSE(bam.HasTag("XY"));
+    EXPECT_TRUE(bam.HasTag("CA"));
+
+    // tag map is kept up to date, for record edits that follow
+    bam.EditTag("np", std::int32_t{3});
+    EXPECT_EQ(3, bam.TagValue("np").ToInt32());
+}
+
+TEST(BAM_BamRecordEditor, edits_bam_record)
+{
+    BamRecord record{BamRecordEditorTests::MakeRecord()};
+    BamRecordEditor{record}.SetTag(BamRecordTag::NUM_PASSES, std::int32_t{5}).Commit();
+
+    EXPECT_EQ(5, record.NumPasses());
+    EXPECT_EQ(-42, record.Impl().TagValue("XY").ToInt32());
+}
+
+TEST(BAM_BamRecordEditor, throws_on_invalid_input)
+{
+    BamRecordImpl bam;
+    BamRecordEditor editor{bam};
+
+    EXPECT_THROW(editor.SetTag("XYZ", std::int32_t{1}), std::runtime_error);
+    EXPECT_THROW(editor.RemoveTag("X"), std::runtime_error);
+    EXPECT_THROW(editor.SetTag("XY", Tag{}), std::runtime_error);
+    EXPECT_THROW(editor.SequenceAndQualities("ACGT", "II"), std::runtime_error);
+}
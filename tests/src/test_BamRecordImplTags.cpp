@@ -1,5 +1,6 @@
 #include <pbbam/BamRecordImpl.h>
 
+#include <cstddef>
 #include <cstdint>
 
 #include <string>
@@ -211,3 +212,50 @@ TEST(BAM_BamRecordImplTags, can_query_array_or_string_tag_length)
     // does not exist
     EXPECT_FALSE(bam.TagLength("dd").has_value());
 }
+
+TEST(BAM_BamRecordImplTags, tag_edits_keep_other_tags_intact)
+{
+    // more tags than the initial lookup table holds
+    BamRecordImpl bam;
+    std::vector<std::string> names;
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        for (const char d : {'0', '1'}) {
+            names.push_back(std::string{c, d});
+        }
+    }
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        EXPECT_TRUE(bam.AddTag(names[i], std::vector<std::uint16_t>(i % 5, i)));
+    }
+
+    // grow, shrink, and same-size edits, then removals
+    EXPECT_TRUE(bam.EditTag("C0", std::vector<std::uint16_t>(100, 7)));
+    EXPECT_TRUE(bam.EditTag("D1", std::string{"x"}));
+    EXPECT_TRUE(bam.EditTag("E0", std::vector<std::uint16_t>(3, 9)));
+    EXPECT_TRUE(bam.RemoveTag("A0"));
+    EXPECT_TRUE(bam.RemoveTag("M1"));
+    EXPECT_FALSE(bam.RemoveTag("M1"));
+    EXPECT_TRUE(bam.AddTag("M1", std::int32_t{-5}));
+
+    for (std::size_t i = 0; i < names.size(); ++i) {
+        const auto& name = names[i];
+        if (name == "A0") {
+            EXPECT_FALSE(bam.HasTag(name));
+        } else if (name == "C0") {
+            EXPECT_EQ(std::vector<std::uint16_t>(100, 7), bam.TagValue(name).ToUInt16Array());
+        } else if (name == "D1") {
+            EXPECT_EQ("x", bam.TagValue(name).ToString());
+        } else if (name == "E0") {
+            EXPECT_EQ(std::vector<std::uint16_t>(3, 9), bam.TagValue(name).ToUInt16Array());
+        } else if (name == "M1") {
+            EXPECT_EQ(-5, bam.TagValue(name).ToInt32());
+        } else {
+            EXPECT_EQ(std::vector<std::uint16_t>(i % 5, i), bam.TagValue(name).ToUInt16Array());
+        }
+    }
+    EXPECT_EQ(names.size() - 1, bam.Tags().size());
+
+    // copies share the same lookups
+    const BamRecordImpl copy{bam};
+    EXPECT_EQ(-5, copy.TagValue("M1").ToInt32());
+    EXPECT_EQ("x", copy.TagValue("D1").ToString());
+}
@@ -0,0 +1,181 @@
+#include <pbbam/BamRecordPool.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbbam/BamRecord.h>
+#include <pbbam/BamRecordImpl.h>
+
+using namespace PacBio;
+using namespace PacBio::BAM;
+
+namespace BamRecordPoolTests {
+
+// restores default (disabled) pool on scope exit
+class PoolGuard
+{
+public:
+    explicit PoolGuard(const BamRecordPool::Config& config) { BamRecordPool::Configure(config); }
+    ~PoolGuard()
+    {
+        BamRecordPool::Configure(BamRecordPool::Config{});
+        BamRecordPool::ClearThreadCache();
+    }
+};
+
+BamRecordPool::Config MakeConfig(const std::size_t maxRecordsPerThread,
+                                 const std::size_t maxSharedRecords = 0)
+{
+    BamRecordPool::Config config;
+    config.maxRecordsPerThread = maxRecordsPerThread;
+    config.maxSharedRecords = maxSharedRecords;
+    return config;
+}
+
+BamRecordImpl MakeRecord(const std::string& name, const std::string& seq)
+{
+    BamRecordImpl bam;
+    bam.Name(name);
+    bam.SetSequenceAndQualities(seq, std::string(seq.size(), 'I'));
+    bam.CigarData(std::to_string(seq.size()) + "=");
+    bam.Position(100);
+    bam.AddTag("zm", std::int32_t{42});
+    return bam;
+}
+
+}  // namespace BamRecordPoolTests
+
+TEST(BAM_BamRecordPool, is_disabled_by_default)
+{
+    EXPECT_EQ(0, BamRecordPool::CurrentConfig().maxRecordsPerThread);
+
+    {
+        BamRecordImpl bam = BamRecordPoolTests::MakeRecord("movie/1/0_4", "ACGT");
+    }
+    EXPECT_EQ(0, BamRecordPool::NumThreadCachedRecords());
+}
+
+TEST(BAM_BamRecordPool, reuses_released_records)
+{
+    const BamRecordPoolTests::PoolGuard guard{BamRecordPoolTests::MakeConfig(4)};
+
+    bam1_t* first = BamRecordPool::Acquire();
+    BamRecordPool::Release(first);
+    EXPECT_EQ(1, BamRecordPool::NumThreadCachedRecords());
+
+    bam1_t* second = BamRecordPool::Acquire();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(0, BamRecordPool::NumThreadCachedRecords());
+    BamRecordPool::Release(second);
+
+    // pool is bounded
+    std::vector<bam1_t*> records;
+    for (int i = 0; i < 8; ++i) {
+        records.push_back(BamRecordPool::Acquire());
+    }
+    for (bam1_t* b : records) {
+        BamRecordPool::Release(b);
+    }
+    EXPECT_EQ(4, BamRecordPool::NumThreadCachedRecords());
+
+    BamRecordPool::ClearThreadCache();
+    EXPECT_EQ(0, BamRecordPool::NumThreadCachedRecords());
+}
+
+TEST(BAM_BamRecordPool, recycled_records_are_reset)
+{
+    const BamRecordPoolTests::PoolGuard guard{BamRecordPoolTests::MakeConfig(4)};
+
+    {
+        BamRecordImpl bam = BamRecordPoolTests::MakeRecord("movie/1/0_8", "ACGTACGT");
+        bam.SetMapped(true);
+        bam.MapQuality(10);
+    }
+    ASSERT_EQ(1, BamRecordPool::NumThreadCachedRecords());
+
+    const BamRecordImpl bam;
+    EXPECT_EQ(0, BamRecordPool::NumThreadCachedRecords());
+    EXPECT_EQ("", bam.Name());
+    EXPECT_TRUE(bam.Sequence().empty());
+    EXPECT_TRUE(bam.CigarData().empty());
+    EXPECT_TRUE(bam.Tags().empty());
+    EXPECT_FALSE(bam.IsMapped());
+    EXPECT_EQ(255, bam.MapQuality());
+    EXPECT_EQ(-1, bam.Position());
+}
+
+TEST(BAM_BamRecordPool, copied_records_match_source)
+{
+    const BamRecordPoolTests::PoolGuard guard{BamRecordPoolTests::MakeConfig(4)};
+
+    const BamRecordImpl source = BamRecordPoolTests::MakeRecord("movie/2/0_12", "ACGTACGTACGT");
+    {
+        // recycle a record with a smaller data block
+        BamRecordImpl small = BamRecordPoolTests::MakeRecord("m/1/0_1", "A");
+    }
+
+    const BamRecordImpl copy{source};
+    EXPECT_EQ(source.Name(), copy.Name());
+    EXPECT_EQ(source.Sequence(), copy.Sequence());
+    EXPECT_EQ(source.Qualities(), copy.Qualities());
+    EXPECT_EQ(source.CigarData().ToStdString(), copy.CigarData().ToStdString());
+    EXPECT_EQ(source.Position(), copy.Position());
+    EXPECT_EQ(42, copy.TagValue("zm").ToInt32());
+
+    // vector of records, as built by ZmwGroupQuery
+    std::vector<BamRecord> records;
+    for (int i = 0; i < 3; ++i) {
+        records.clear();
+        for (int j = 0; j < 3; ++j) {
+            records.emplace_back(BamRecordImpl{source});
+        }
+        for (const auto& record : records) {
+            EXPECT_EQ(source.Name(), record.FullName());
+            EXPECT_EQ(source.Sequence(), record.Impl().Sequence());
+        }
+    }
+}
+
+TEST(BAM_BamRecordPool, skips_records_with_large_data)
+{
+    auto config = BamRecordPoolTests::MakeConfig(4);
+    config.maxRecordBytes = 16;
+    const BamRecordPoolTests::PoolGuard guard{config};
+
+    {
+        BamRecordImpl bam = BamRecordPoolTests::MakeRecord("movie/1/0_40", std::string(40, 'A'));
+    }
+    EXPECT_EQ(0, BamRecordPool::NumThreadCachedRecords());
+}
+
+TEST(BAM_BamRecordPool, shares_records_between_threads)
+{
+    const BamRecordPoolTests::PoolGuard guard{BamRecordPoolTests::MakeConfig(2, 8)};
+
+    // release more records than this thread keeps, spilling the last one to
+    // the shared list
+    std::vector<bam1_t*> records;
+    for (int i = 0; i < 3; ++i) {
+        records.push_back(BamRecordPool::Acquire());
+    }
+    for (bam1_t* b : records) {
+        BamRecordPool::Release(b);
+    }
+    EXPECT_EQ(2, BamRecordPool::NumThreadCachedRecords());
+
+    bam1_t* acquiredOnWorker = nullptr;
+    std::thread worker{[&]() {
+        acquiredOnWorker = BamRecordPool::Acquire();
+        BamRecordPool::Release(acquiredOnWorker);
+    }};
+    worker.join();
+
+    EXPECT_EQ(records.back(), acquiredOnWorker);
+    EXPECT_EQ(2, BamRecordPool::NumThreadCachedRecords());
+}
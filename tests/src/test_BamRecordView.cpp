@@ -0,0 +1,162 @@
+#include <pbbam/BamRecordView.h>
+
+#include <cstdint>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbbam/BamRecord.h>
+#include <pbbam/BamTagCodec.h>
+
+using namespace PacBio;
+using namespace PacBio::BAM;
+
+namespace BamRecordViewTests {
+
+BamRecord MakeRecord(const std::string& cigar, const Data::Strand strand,
+                     const bool lossyFrames = false)
+{
+    BamRecordImpl impl;
+    impl.SetSequenceAndQualities("AACCGTTAGC", "?]?]?]?]?*");
+
+    TagCollection tags;
+    tags["qs"] = std::int32_t{500};
+    tags["qe"] = std::int32_t{510};
+    if (lossyFrames) {
+        tags["ip"] = std::vector<std::uint8_t>{10, 10, 20, 20, 30, 40, 40, 10, 30, 200};
+        tags["pw"] = std::vector<std::uint8_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 250};
+    } else {
+        tags["ip"] = std::vector<std::uint16_t>{10, 10, 20, 20, 30, 40, 40, 10, 30, 20};
+        tags["pw"] = std::vector<std::uint16_t>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    }
+    tags["dt"] = std::string{"ACGTNACGTA"};
+    tags["st"] = std::string{"TTGCANNACG"};
+    tags["dq"] = std::string{"0123456789"};
+    tags["iq"] = std::string{"?]?]?]?]?*"};
+    tags["mq"] = std::string{"!!##$$%%&&"};
+    tags["sq"] = std::string{"ABCDEFGHIJ"};
+    impl.Tags(tags);
+
+    BamRecord record{std::move(impl)};
+    if (!cigar.empty()) {
+        record.Map(0, 100, strand, cigar, 60);
+    }
+    return record;
+}
+
+void CheckFetchMatchesAccessors(const BamRecord& record)
+{
+    for (const auto orientation : {Data::Orientation::NATIVE, Data::Orientation::GENOMIC}) {
+        for (const bool aligned : {false, true}) {
+            for (const bool exciseSoftClips : {false, true}) {
+                SCOPED_TRACE("aligned=" + std::to_string(aligned) +
+                             ", exciseSoftClips=" + std::to_string(exciseSoftClips) +
+                             ", native=" +
+                             std::to_string(orientation == Data::Orientation::NATIVE));
+
+                const BamRecordView view{record, orientation, aligned, exciseSoftClips};
+
+                std::string seq;
+                std::string deletionTags;
+                std::string substitutionTags;
+                Data::QualityValues quals;
+                Data::QualityValues deletionQVs;
+                Data::QualityValues insertionQVs;
+                Data::QualityValues mergeQVs;
+                Data::QualityValues substitutionQVs;
+                Data::Frames ipd;
+                Data::Frames pulseWidths;
+
+                BamRecordView::Fields fields;
+                fields.sequence = &seq;
+                fields.qualities = &quals;
+                fields.deletionQVs = &deletionQVs;
+                fields.deletionTags = &deletionTags;
+                fields.insertionQVs = &insertionQVs;
+                fields.mergeQVs = &mergeQVs;
+                fields.substitutionQVs = &substitutionQVs;
+                fields.substitutionTags = &substitutionTags;
+                fields.ipd = &ipd;
+                fields.pulseWidths = &pulseWidths;
+                view.Fetch(fields);
+
+                EXPECT_EQ(view.Sequence(), seq);
+                EXPECT_EQ(view.Qualities(), quals);
+                EXPECT_EQ(view.DeletionQVs(), deletionQVs);
+                EXPECT_EQ(view.DeletionTags(), deletionTags);
+                EXPECT_EQ(view.InsertionQVs(), insertionQVs);
+                EXPECT_EQ(view.MergeQVs(), mergeQVs);
+                EXPECT_EQ(view.SubstitutionQVs(), substitutionQVs);
+                EXPECT_EQ(view.SubstitutionTags(), substitutionTags);
+                EXPECT_EQ(view.IPD().Data(), ipd.Data());
+                EXPECT_EQ(view.PulseWidths().Data(), pulseWidths.Data());
+            }
+        }
+    }
+}
+
+}  // namespace BamRecordViewTests
+
+TEST(BAM_BamRecordView, fetch_matches_accessors_for_unmapped_record)
+{
+    const auto record = BamRecordViewTests::MakeRecord("", Data::Strand::FORWARD);
+    BamRecordViewTests::CheckFetchMatchesAccessors(record);
+}
+
+TEST(BAM_BamRecordView, fetch_matches_accessors_for_mapped_records)
+{
+    const std::vector<std::string> cigars{"10=", "5=3D5=", "4=1D2I2D4=", "2S4=1D2I2D2S",
+                                          "2H3S5=3D2=4H", "1S2=1P1=1I2X1N3S"};
+    for (const auto& cigar : cigars) {
+        for (const auto strand : {Data::Strand::FORWARD, Data::Strand::REVERSE}) {
+            SCOPED_TRACE(cigar + (strand == Data::Strand::FORWARD ? " (+)" : " (-)"));
+            const auto record = BamRecordViewTests::MakeRecord(cigar, strand);
+            BamRecordViewTests::CheckFetchMatchesAccessors(record);
+        }
+    }
+}
+
+TEST(BAM_BamRecordView, fetch_decodes_lossy_frames)
+{
+    for (const auto strand : {Data::Strand::FORWARD, Data::Strand::REVERSE}) {
+        const auto record =
+            BamRecordViewTests::MakeRecord("2S4=1D2I2D2S", strand, /*lossyFrames=*/true);
+        BamRecordViewTests::CheckFetchMatchesAccessors(record);
+    }
+}
+
+TEST(BAM_BamRecordView, fetch_only_fills_requested_fields_and_reuses_buffers)
+{
+    const auto record = BamRecordViewTests::MakeRecord("5=3D5=", Data::Strand::REVERSE);
+    const BamRecordView view{record, Data::Orientation::GENOMIC, true, false};
+
+    std::string seq{"previous contents, to be overwritten"};
+    Data::Frames ipd;
+    BamRecordView::Fields fields;
+    fields.sequence = &seq;
+    fields.ipd = &ipd;
+    view.Fetch(fields);
+
+    EXPECT_EQ("GCTAA---CGGTT", seq);
+    EXPECT_EQ(view.IPD().Data(), ipd.Data());
+
+    // fetching again gives the same result
+    view.Fetch(fields);
+    EXPECT_EQ("GCTAA---CGGTT", seq);
+}
+
+TEST(BAM_BamRecordView, fetch_throws_on_missing_tag)
+{
+    BamRecordImpl impl;
+    impl.SetSequenceAndQualities("ACGT", "????");
+    const BamRecord record{std::move(impl)};
+    const BamRecordView view{record, Data::Orientation::NATIVE, false, false};
+
+    Data::QualityValues deletionQVs;
+    BamRecordView::Fields fields;
+    fields.deletionQVs = &deletionQVs;
+    EXPECT_THROW(view.Fetch(fields), std::runtime_error);
+}
@@ -0,0 +1,104 @@
+#include <pbbam/bed/BedIntervals.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbbam/bed/BedReader.h>
+#include <pbcopper/data/GenomicInterval.h>
+
+#include "PbbamTestData.h"
+
+using BedIntervals = PacBio::BED::BedIntervals;
+using BedReader = PacBio::BED::BedReader;
+
+namespace BedIntervalsTests {
+
+const std::string BedFn = PacBio::BAM::PbbamTestsConfig::Data_Dir + "/bed/test.bed";
+const std::string GzipBedFn = PacBio::BAM::PbbamTestsConfig::Data_Dir + "/bed/test.bed.gz";
+
+void CheckMatchesReadAll(const std::string& fn)
+{
+    const auto intervals = BedIntervals::FromFile(fn);
+    const std::vector<std::string> expectedContigs{"chr1", "chr2", "chr3"};
+    EXPECT_EQ(expectedContigs, intervals.Contigs());
+    EXPECT_EQ(9, intervals.NumIntervals());
+    EXPECT_EQ(BedReader::ReadAll(fn), intervals.ToGenomicIntervals());
+}
+
+}  // namespace BedIntervalsTests
+
+TEST(BAM_BedIntervals, loads_same_intervals_as_read_all_from_text_bed)
+{
+    BedIntervalsTests::CheckMatchesReadAll(BedIntervalsTests::BedFn);
+}
+
+TEST(BAM_BedIntervals, loads_same_intervals_as_read_all_from_gzip_bed)
+{
+    BedIntervalsTests::CheckMatchesReadAll(BedIntervalsTests::GzipBedFn);
+}
+
+TEST(BAM_BedIntervals, throws_on_invalid_extension)
+{
+    EXPECT_THROW(BedIntervals::FromFile("wrong.ext"), std::runtime_error);
+}
+
+TEST(BAM_BedIntervals, skips_header_lines_and_throws_on_malformed_records)
+{
+    const std::string goodFn{PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir +
+                             "/intervals_good.bed"};
+    {
+        std::ofstream out{goodFn};
+        out << "track name=test\n"
+            << "# comment\n"
+            << "chr1\t100\t200\tname\t0\t+\r\n"
+            << "\n"
+            << "chr1\t50\t60";  // no trailing newline
+    }
+    const auto intervals = BedIntervals::FromFile(goodFn);
+    ASSERT_EQ(2, intervals.NumIntervals());
+    EXPECT_EQ(50, intervals.Intervals("chr1").front().start);
+    EXPECT_EQ(200, intervals.Intervals("chr1").back().stop);
+
+    const std::string badFn{PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir +
+                            "/intervals_bad.bed"};
+    {
+        std::ofstream out{badFn};
+        out << "chr1\t100\tnot_a_number\n";
+    }
+    EXPECT_THROW(BedIntervals::FromFile(badFn), std::runtime_error);
+}
+
+TEST(BAM_BedIntervals, can_query_overlaps)
+{
+    BedIntervals intervals;
+    intervals.Add("chr1", 500, 600);
+    intervals.Add("chr1", 100, 1000);  // out of order, spans others
+    intervals.Add("chr1", 200, 300);
+    intervals.Add("chr2", 0, 10);
+    EXPECT_THROW(intervals.Overlaps("chr1", 0, 1), std::runtime_error);
+
+    intervals.Sort();
+    EXPECT_EQ(4, intervals.NumIntervals());
+
+    EXPECT_FALSE(intervals.Overlaps("chr1", 0, 100));
+    EXPECT_TRUE(intervals.Overlaps("chr1", 0, 101));
+    EXPECT_TRUE(intervals.Overlaps("chr1", 999, 2000));
+    EXPECT_FALSE(intervals.Overlaps("chr1", 1000, 2000));
+    EXPECT_FALSE(intervals.Overlaps("chrUnknown", 0, 2000));
+    EXPECT_TRUE(intervals.Overlaps("chr2", 5, 6));
+
+    // covered by the spanning interval only
+    const auto inner = intervals.Overlapping("chr1", 350, 400);
+    ASSERT_EQ(1, inner.size());
+    EXPECT_EQ(100, inner[0].start);
+
+    const auto all = intervals.Overlapping("chr1", 250, 550);
+    ASSERT_EQ(3, all.size());
+    EXPECT_EQ(100, all[0].start);
+    EXPECT_EQ(200, all[1].start);
+    EXPECT_EQ(500, all[2].start);
+}
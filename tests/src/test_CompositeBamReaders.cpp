@@ -1,9 +1,16 @@
 #include <pbbam/CompositeBamReader.h>
 
+#include <cstdio>
+
 #include <iterator>
+#include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include <pbbam/BaiIndexedBamReader.h>
+#include <pbbam/BamWriter.h>
+
 #include "PbbamTestData.h"
 
 using namespace PacBio::BAM;
@@ -14,6 +21,37 @@ const std::string alignedBamFn = PbbamTestsConfig::Data_Dir + "/aligned.bam";
 const std::string aligned2BamFn = PbbamTestsConfig::Data_Dir + "/aligned2.bam";
 const std::string phi29BamFn = PbbamTestsConfig::Data_Dir + "/phi29.bam";
 
+// reference name with ':', as in HLA & alt contigs
+const std::string colonRefName{"HLA-A*01:01:01:01"};
+
+// writes & indexes a BAM with 100bp reads at 0, 1000, 2000 on each of
+// colonRefName & "chr1"
+BamFile MakeColonContigBam(const std::string& fn)
+{
+    const BamHeader header{"@HD\tVN:1.6\tSO:coordinate\tpb:3.0.1\n@SQ\tSN:" + colonRefName +
+                           "\tLN:5000\n@SQ\tSN:chr1\tLN:5000\n"};
+    {
+        BamWriter writer{fn, header};
+        for (std::int32_t refId = 0; refId < 2; ++refId) {
+            for (std::int32_t pos = 0; pos < 3000; pos += 1000) {
+                BamRecordImpl impl;
+                impl.Name("movie/" + std::to_string(refId) + "/" + std::to_string(pos));
+                impl.SetSequenceAndQualities(std::string(100, 'A'), std::string(100, 'I'));
+                impl.CigarData(PacBio::Data::Cigar{"100="});
+                impl.ReferenceId(refId);
+                impl.Position(pos);
+                impl.MapQuality(60);
+                impl.SetMapped(true);
+                writer.Write(impl);
+            }
+        }
+    }
+
+    const BamFile file{fn};
+    file.CreateStandardIndex();
+    return file;
+}
+
 }  // namespace CompositeBamReaderTests
 
 TEST(BAM_GenomicIntervalCompositeBamReader, can_be_reused)
@@ -96,6 +134,64 @@ TEST(BAM_GenomicIntervalCompositeBamReader, can_be_intialized_without_an_interva
     EXPECT_EQ(4, std::distance(reader.begin(), reader.end()));
 }
 
+TEST(BAM_GenomicIntervalCompositeBamReader, can_query_multiple_intervals)
+{
+    const std::string refName{"lambda_NEB3011"};
+    const std::vector<BamFile> bamFiles{BamFile{CompositeBamReaderTests::alignedBamFn},
+                                        BamFile{CompositeBamReaderTests::alignedBamFn}};
+    GenomicIntervalCompositeBamReader reader{bamFiles};
+
+    // disjoint intervals
+    reader.Intervals({PacBio::Data::GenomicInterval{refName, 5000, 6000},
+                      PacBio::Data::GenomicInterval{refName, 9300, 9400}});
+    EXPECT_EQ(8, std::distance(reader.begin(), reader.end()));
+
+    // overlapping intervals, records are returned only once
+    reader.Intervals({PacBio::Data::GenomicInterval{refName, 5000, 6000},
+                      PacBio::Data::GenomicInterval{refName, 5000, 6000}});
+    EXPECT_EQ(4, std::distance(reader.begin(), reader.end()));
+
+    // no intervals
+    reader.Intervals({});
+    EXPECT_EQ(0, std::distance(reader.begin(), reader.end()));
+
+    // single interval still works on same readers
+    reader.Interval(PacBio::Data::GenomicInterval{refName, 9300, 9400});
+    EXPECT_EQ(4, std::distance(reader.begin(), reader.end()));
+
+    // unknown ref
+    EXPECT_THROW(reader.Intervals({PacBio::Data::GenomicInterval{"does not exist", 0, 100}}),
+                 std::runtime_error);
+    EXPECT_EQ(0, std::distance(reader.begin(), reader.end()));
+}
+
+TEST(BAM_GenomicIntervalCompositeBamReader, can_query_multiple_intervals_on_contig_names_with_colons)
+{
+    const std::string fn = PbbamTestsConfig::GeneratedData_Dir + "/colon_contig.bam";
+    const auto file = CompositeBamReaderTests::MakeColonContigBam(fn);
+    const auto& refName = CompositeBamReaderTests::colonRefName;
+
+    {
+        BaiIndexedBamReader reader{file};
+        reader.Intervals({PacBio::Data::GenomicInterval{refName, 0, 50},
+                          PacBio::Data::GenomicInterval{refName, 1950, 2050},
+                          PacBio::Data::GenomicInterval{"chr1", 1000, 1100}});
+        EXPECT_EQ(3, std::distance(reader.begin(), reader.end()));
+    }
+
+    const std::vector<BamFile> bamFiles{file, file};
+    GenomicIntervalCompositeBamReader reader{bamFiles};
+    reader.Intervals({PacBio::Data::GenomicInterval{refName, 0, 5000}});
+    for (const auto& record : reader) {
+        EXPECT_EQ(refName, record.ReferenceName());
+    }
+    reader.Intervals({PacBio::Data::GenomicInterval{refName, 0, 5000}});
+    EXPECT_EQ(6, std::distance(reader.begin(), reader.end()));
+
+    std::remove(fn.c_str());
+    std::remove((fn + ".bai").c_str());
+}
+
 // clang-format off
 TEST(BAM_PbiFilterCompositeBamReader, can_handle_normal_filters)
 {
@@ -184,6 +280,67 @@ TEST(BAM_PbiFilterCompositeBamReader, can_handle_normal_filters)
 }
 // clang-format on
 
+TEST(BAM_PbiFilterCompositeBamReader, only_opens_files_with_matching_reads)
+{
+    const std::vector<BamFile> bamFiles{BamFile{PbbamTestsConfig::Data_Dir + "/group/test2.bam"},
+                                        BamFile{PbbamTestsConfig::Data_Dir + "/group/test2.bam"}};
+
+    // no matching reads in any file
+    PbiFilterCompositeBamReader<> reader{PbiReadGroupFilter{"00000000"}, bamFiles};
+    EXPECT_EQ(0, reader.NumReads());
+    EXPECT_EQ(0, std::distance(reader.begin(), reader.end()));
+
+    // re-filter, all files now have matching reads
+    reader.Filter(PbiQueryLengthFilter{500, Compare::GREATER_THAN_EQUAL});
+    EXPECT_EQ(6, reader.NumReads());
+    EXPECT_EQ(6, std::distance(reader.begin(), reader.end()));
+}
+
+TEST(BAM_PbiFilterCompositeBamReader, max_open_files_returns_same_records_as_unlimited)
+{
+    const std::vector<BamFile> bamFiles{BamFile{PbbamTestsConfig::Data_Dir + "/group/test1.bam"},
+                                        BamFile{PbbamTestsConfig::Data_Dir + "/group/test2.bam"}};
+    const PbiFilter filter{PbiQueryLengthFilter{500, Compare::GREATER_THAN_EQUAL}};
+
+    std::vector<std::string> expected;
+    PbiFilterCompositeBamReader<Compare::Zmw> unlimited{filter, bamFiles};
+    for (const auto& record : unlimited) {
+        expected.push_back(record.FullName());
+    }
+
+    PbiFilterCompositeBamReader<Compare::Zmw> limited{filter, bamFiles,
+                                                      MakePbiIndexCache(bamFiles), 1};
+    EXPECT_EQ(unlimited.NumReads(), limited.NumReads());
+    std::vector<std::string> observed;
+    for (const auto& record : limited) {
+        observed.push_back(record.FullName());
+    }
+    EXPECT_FALSE(observed.empty());
+    EXPECT_EQ(expected, observed);
+}
+
+TEST(BAM_SortedCompositeBamReader, max_open_files_returns_same_records_as_unlimited)
+{
+    const std::vector<BamFile> bamFiles{BamFile{CompositeBamReaderTests::alignedBamFn},
+                                        BamFile{CompositeBamReaderTests::aligned2BamFn},
+                                        BamFile{CompositeBamReaderTests::alignedBamFn}};
+
+    SortedCompositeBamReader<Compare::AlignmentPosition> unlimited{bamFiles};
+    SortedCompositeBamReader<Compare::AlignmentPosition> limited{bamFiles, 1};
+
+    BamRecord expected;
+    BamRecord observed;
+    int count = 0;
+    while (unlimited.GetNext(expected)) {
+        ASSERT_TRUE(limited.GetNext(observed));
+        EXPECT_EQ(expected.FullName(), observed.FullName());
+        EXPECT_EQ(expected.ReferenceStart(), observed.ReferenceStart());
+        ++count;
+    }
+    EXPECT_FALSE(limited.GetNext(observed));
+    EXPECT_LT(0, count);
+}
+
 TEST(BAM_SequentialCompositeBamReader, expected_record_count_across_files)
 {
     const std::vector<BamFile> bamFiles{BamFile{CompositeBamReaderTests::alignedBamFn},
@@ -194,3 +351,37 @@ TEST(BAM_SequentialCompositeBamReader, expected_record_count_across_files)
         EXPECT_EQ(8, std::distance(reader.begin(), reader.end()));
     });
 }
+
+TEST(BAM_SequentialCompositeBamReader, raw_passthrough_visits_all_records)
+{
+    const std::vector<BamFile> bamFiles{BamFile{CompositeBamReaderTests::alignedBamFn},
+                                        BamFile{CompositeBamReaderTests::alignedBamFn}};
+
+    SequentialCompositeBamReader reader{bamFiles};
+    BamRecord record;
+    int count = 0;
+    while (reader.GetNextRaw(record)) {
+        EXPECT_FALSE(record.ReadGroupId().empty());  // tags found lazily
+        ++count;
+    }
+    EXPECT_EQ(8, count);
+}
+
+TEST(BAM_SortedCompositeBamReader, raw_passthrough_keeps_alignment_order)
+{
+    const std::vector<BamFile> bamFiles{BamFile{CompositeBamReaderTests::alignedBamFn},
+                                        BamFile{CompositeBamReaderTests::aligned2BamFn}};
+
+    SortedCompositeBamReader<Compare::AlignmentPosition> reader{bamFiles};
+    SortedCompositeBamReader<Compare::AlignmentPosition> rawReader{bamFiles};
+
+    BamRecord record;
+    BamRecord rawRecord;
+    while (reader.GetNext(record)) {
+        ASSERT_TRUE(rawReader.GetNextRaw(rawRecord));
+        EXPECT_EQ(record.FullName(), rawRecord.FullName());
+        EXPECT_EQ(record.ReferenceId(), rawRecord.ReferenceId());
+        EXPECT_EQ(record.ReferenceStart(), rawRecord.ReferenceStart());
+    }
+    EXPECT_FALSE(rawReader.GetNextRaw(rawRecord));
+}
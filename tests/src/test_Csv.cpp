@@ -8,8 +8,14 @@
 #include <filesystem>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 #include <tuple>
+#include <variant>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
 
 using namespace PacBio;
 
@@ -182,6 +188,87 @@ TEST(CSV_CsvReader, can_autodetect_delimiter)
     }
 }
 
+TEST(CSV_CsvReader, can_read_row_views_by_column_index)
+{
+    const std::filesystem::path fn{BAM::PbbamTestsConfig::Data_Dir + "/csv/comma_separated.csv"};
+    CSV::CsvReader reader{fn, ','};
+    const std::size_t fruitIdx = reader.ColumnIndex("fruit");
+    const std::size_t triforceIdx = reader.ColumnIndex("triforce");
+    EXPECT_THROW(reader.ColumnIndex("not_a_column"), std::runtime_error);
+
+    std::vector<std::string> fruits;
+    std::vector<std::string> triforces;
+    CSV::CsvRowView row;
+    while (reader.GetNext(row)) {
+        fruits.emplace_back(row[fruitIdx]);
+        triforces.emplace_back(row[triforceIdx]);
+    }
+    EXPECT_EQ((std::vector<std::string>{"apple", "banana", "orange"}), fruits);
+    EXPECT_EQ((std::vector<std::string>{"power", "wisdom", "courage"}), triforces);
+}
+
+TEST(CSV_CsvReader, row_views_throw_if_missing_fields)
+{
+    const std::filesystem::path fn{BAM::PbbamTestsConfig::Data_Dir + "/csv/missing_fields.csv"};
+    CSV::CsvReader reader{fn, ','};
+    CSV::CsvRowView row;
+    EXPECT_THROW(
+        {
+            while (reader.GetNext(row)) {
+            }
+        },
+        std::runtime_error);
+}
+
+TEST(CSV_CsvReader, can_read_typed_columns)
+{
+    // enough rows to span multiple parse batches
+    constexpr int NUM_ROWS = 100000;
+    const std::filesystem::path fn{BAM::PbbamTestsConfig::GeneratedData_Dir +
+                                   "/typed_columns.csv"};
+    {
+        CSV::CsvWriter writer{fn, CSV::CsvHeader{"zmw", "name", "accuracy"}, ','};
+        CSV::CsvRecord record;
+        for (int i = 0; i < NUM_ROWS; ++i) {
+            record["zmw"] = std::to_string(i);
+            record["name"] = "m/" + std::to_string(i);
+            record["accuracy"] = std::to_string(i / 4.0);
+            writer.Write(record);
+        }
+    }
+
+    for (const std::size_t numThreads : {1, 4}) {
+        CSV::CsvReader reader{fn, ','};
+        const auto columns =
+            reader.ReadColumns({{"accuracy", CSV::CsvColumnType::DOUBLE},
+                                {"zmw", CSV::CsvColumnType::INT64},
+                                {"name", CSV::CsvColumnType::STRING}},
+                               numThreads);
+        ASSERT_EQ(3, columns.size());
+
+        const auto& accuracies = std::get<std::vector<double>>(columns[0]);
+        const auto& zmws = std::get<std::vector<std::int64_t>>(columns[1]);
+        const auto& names = std::get<std::vector<std::string>>(columns[2]);
+        ASSERT_EQ(NUM_ROWS, zmws.size());
+        ASSERT_EQ(NUM_ROWS, accuracies.size());
+        ASSERT_EQ(NUM_ROWS, names.size());
+        for (int i = 0; i < NUM_ROWS; i += 997) {
+            EXPECT_EQ(i, zmws[i]);
+            EXPECT_DOUBLE_EQ(i / 4.0, accuracies[i]);
+            EXPECT_EQ("m/" + std::to_string(i), names[i]);
+        }
+        EXPECT_EQ(NUM_ROWS - 1, zmws.back());
+    }
+}
+
+TEST(CSV_CsvReader, typed_columns_throw_on_non_numeric_value)
+{
+    const std::filesystem::path fn{BAM::PbbamTestsConfig::Data_Dir + "/csv/comma_separated.csv"};
+    CSV::CsvReader reader{fn, ','};
+    EXPECT_THROW(reader.ReadColumns({{"fruit", CSV::CsvColumnType::INT64}}, 2),
+                 std::runtime_error);
+}
+
 TEST(CSV_CsvWriter, can_roundtrip_comma_separated)
 {
     const std::filesystem::path inputFn{BAM::PbbamTestsConfig::Data_Dir +
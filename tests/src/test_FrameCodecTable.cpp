@@ -0,0 +1,168 @@
+#include "../../src/FrameCodecTable.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbbam/BamHeader.h>
+#include <pbbam/BamRecord.h>
+#include <pbbam/ReadGroupInfo.h>
+#include <pbcopper/data/FrameEncoders.h>
+
+using namespace PacBio;
+using namespace PacBio::BAM;
+
+namespace FrameCodecTableTests {
+
+const std::vector<SimdLevel> AllLevels{SimdLevel::SCALAR, SimdLevel::SSE4, SimdLevel::AVX2};
+
+// includes lengths around the AVX2 kernel's block size, & odd lengths
+const std::vector<std::size_t> Lengths{0, 1, 15, 16, 17, 31, 32, 33, 1001};
+
+std::vector<std::uint16_t> AllFrameValues()
+{
+    std::vector<std::uint16_t> frames(1 << 16);
+    std::iota(frames.begin(), frames.end(), 0);
+    return frames;
+}
+
+std::vector<std::uint8_t> AllCodes()
+{
+    std::vector<std::uint8_t> codes(256);
+    std::iota(codes.begin(), codes.end(), 0);
+    return codes;
+}
+
+void CheckMatchesEncoder(const Data::FrameEncoder& encoder)
+{
+    const auto& table = FrameCodecTable::For(encoder);
+
+    const auto codes = AllCodes();
+    EXPECT_EQ(encoder.Decode(codes).Data(), table.Decode(codes));
+
+    const auto frames = AllFrameValues();
+    EXPECT_EQ(encoder.Encode(frames), table.Encode(frames));
+}
+
+}  // namespace FrameCodecTableTests
+
+TEST(BAM_FrameCodecTable, v1_table_matches_encoder)
+{
+    FrameCodecTableTests::CheckMatchesEncoder(Data::V1FrameEncoder{});
+}
+
+TEST(BAM_FrameCodecTable, v2_table_matches_encoder)
+{
+    FrameCodecTableTests::CheckMatchesEncoder(Data::V2FrameEncoder{2, 6});
+    FrameCodecTableTests::CheckMatchesEncoder(Data::V2FrameEncoder{3, 5});
+}
+
+TEST(BAM_FrameCodecTable, all_levels_decode_identically)
+{
+    const auto& table = FrameCodecTable::For(Data::V2FrameEncoder{2, 6});
+
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> pick{0, 255};
+    for (const auto length : FrameCodecTableTests::Lengths) {
+        std::vector<std::uint8_t> codes(length);
+        for (auto& c : codes) {
+            c = static_cast<std::uint8_t>(pick(rng));
+        }
+
+        std::vector<std::uint16_t> expected(length);
+        for (std::size_t i = 0; i < length; ++i) {
+            expected[i] = table.Decode(codes[i]);
+        }
+
+        for (const auto level : FrameCodecTableTests::AllLevels) {
+            std::vector<std::uint16_t> frames(length);
+            table.Decode(codes.data(), length, frames.data(), level);
+            EXPECT_EQ(expected, frames) << "length: " << length;
+        }
+    }
+}
+
+TEST(BAM_FrameCodecTable, equivalent_encoders_share_table)
+{
+    const auto& first = FrameCodecTable::For(Data::V1FrameEncoder{});
+    const auto& second = FrameCodecTable::For(Data::V1FrameEncoder{});
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(&first, &FrameCodecTable::V1());
+
+    const auto& v2 = FrameCodecTable::For(Data::V2FrameEncoder{2, 6});
+    EXPECT_NE(&first, &v2);
+}
+
+TEST(BAM_FrameCodecTable, reports_whether_codes_survive_roundtrip)
+{
+    EXPECT_TRUE(FrameCodecTable::V1().PreservesCodes());
+
+    const Data::V2FrameEncoder encoder{2, 6};
+    const auto codes = FrameCodecTableTests::AllCodes();
+    const bool expected = (encoder.Encode(encoder.Decode(codes).Data()) == codes);
+    EXPECT_EQ(expected, FrameCodecTable::For(encoder).PreservesCodes());
+}
+
+TEST(BAM_FrameCodecTable, record_without_read_group_uses_v1)
+{
+    const Data::Frames frames{std::vector<std::uint16_t>{0, 1, 63, 64, 65, 200, 1000, 9000}};
+
+    BamRecord record;
+    record.IPD(frames, Data::FrameCodec::V1);
+    record.PulseWidth(frames, Data::FrameCodec::V1);
+
+    const Data::V1FrameEncoder encoder;
+    const auto expected = encoder.Decode(encoder.Encode(frames.Data())).Data();
+    EXPECT_EQ(expected, record.IPD().Data());
+    EXPECT_EQ(expected, record.PulseWidth().Data());
+
+    const auto codecs = ReadGroupFrameCodecs(record);
+    EXPECT_EQ(&FrameCodecTable::V1(), codecs.ipd);
+    EXPECT_EQ(&FrameCodecTable::V1(), codecs.pulseWidth);
+}
+
+TEST(BAM_FrameCodecTable, read_group_codecs_follow_header_changes)
+{
+    const ReadGroupInfo v1ReadGroup{"movie", "SUBREAD"};
+    ReadGroupInfo v2ReadGroup{"movie", "SUBREAD"};
+    v2ReadGroup.IpdFrameEncoder(Data::V2FrameEncoder{2, 6});
+    v2ReadGroup.PulseWidthFrameEncoder(Data::V2FrameEncoder{3, 5});
+    const auto& v2Ipd = FrameCodecTable::For(Data::V2FrameEncoder{2, 6});
+    const auto& v2PulseWidth = FrameCodecTable::For(Data::V2FrameEncoder{3, 5});
+
+    BamRecord record;
+    record.header_.AddReadGroup(v1ReadGroup);
+    record.ReadGroup(v1ReadGroup);
+    auto codecs = ReadGroupFrameCodecs(record);
+    EXPECT_EQ(&FrameCodecTable::V1(), codecs.ipd);
+    EXPECT_EQ(&FrameCodecTable::V1(), codecs.pulseWidth);
+
+    // same read group ID, new codecs
+    record.header_.ReadGroups({v2ReadGroup});
+    codecs = ReadGroupFrameCodecs(record);
+    EXPECT_EQ(&v2Ipd, codecs.ipd);
+    EXPECT_EQ(&v2PulseWidth, codecs.pulseWidth);
+
+    // read group missing from header
+    record.header_.ClearReadGroups();
+    codecs = ReadGroupFrameCodecs(record);
+    EXPECT_EQ(&FrameCodecTable::V1(), codecs.ipd);
+    EXPECT_EQ(&FrameCodecTable::V1(), codecs.pulseWidth);
+
+    record.header_.AddReadGroup(v2ReadGroup);
+    codecs = ReadGroupFrameCodecs(record);
+    EXPECT_EQ(&v2Ipd, codecs.ipd);
+    EXPECT_EQ(&v2PulseWidth, codecs.pulseWidth);
+
+    // headers don't share cached codecs
+    BamRecord other;
+    other.header_.AddReadGroup(v1ReadGroup);
+    other.ReadGroup(v1ReadGroup);
+    EXPECT_EQ(&FrameCodecTable::V1(), ReadGroupFrameCodecs(other).ipd);
+    EXPECT_EQ(&v2Ipd, ReadGroupFrameCodecs(record).ipd);
+}
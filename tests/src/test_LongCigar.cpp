@@ -1,10 +1,17 @@
+#include <cstdio>
+
+#include <memory>
 #include <string>
 #include <tuple>
 
 #include <gtest/gtest.h>
 
+#include <htslib/bgzf.h>
+#include <htslib/sam.h>
+
 #include <pbbam/BamReader.h>
 #include <pbbam/BamWriter.h>
+#include <pbbam/Deleters.h>
 #include <pbbam/StringUtilities.h>
 
 #include "../../src/MemoryUtils.h"
@@ -77,3 +84,28 @@ TEST(BAM_LongCigar, can_write_long_cigar)
         EXPECT_FALSE(b.Impl().HasTag("CG"));
     }
 }
+
+TEST(BAM_LongCigar, encoded_length_matches_bytes_written)
+{
+    const std::string fn =
+        PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/long-cigar-encoded-length.bam";
+    std::unique_ptr<BGZF, PacBio::BAM::HtslibBgzfDeleter> fp{bgzf_open(fn.c_str(), "wu")};
+    ASSERT_TRUE(fp);
+
+    // long CIGAR, written as placeholder + 'CG' tag
+    auto b = LongCigarTests::ReadLongCigarRecord(LongCigarTests::LongCigarBam);
+    const auto& longRaw = PacBio::BAM::BamRecordMemory::GetRawData(b);
+    ASSERT_GT(longRaw->core.n_cigar, 0xffffU);
+    EXPECT_EQ(bam_write1(fp.get(), longRaw.get()),
+              PacBio::BAM::BamRecordMemory::EncodedLength(longRaw.get()));
+
+    // short CIGAR
+    b.Impl().CigarData(Cigar{"10="});
+    b.Impl().SetSequenceAndQualities("ACGTACGTAC", "IIIIIIIIII");
+    const auto& shortRaw = PacBio::BAM::BamRecordMemory::GetRawData(b);
+    EXPECT_EQ(bam_write1(fp.get(), shortRaw.get()),
+              PacBio::BAM::BamRecordMemory::EncodedLength(shortRaw.get()));
+
+    fp.reset();
+    std::remove(fn.c_str());
+}
@@ -1,11 +1,13 @@
 #include <pbbam/EntireFileQuery.h>
 #include <pbbam/PbiBuilder.h>
 #include <pbbam/PbiRawData.h>
+#include "../../src/PbiIndexIO.h"
 
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 
+#include <algorithm>
 #include <string>
 #include <tuple>
 
@@ -333,6 +335,21 @@ TEST(BAM_PacBioIndex, loads_offsets_from_pbi_file)
     EXPECT_EQ(expectedOffsets, index.BasicData().fileOffset_);
 }
 
+TEST(BAM_PacBioIndex, can_load_hole_number_range_without_full_index)
+{
+    for (const auto& fn : {PacBioIndexTests::test2BamFn, PacBioIndexTests::phi29BamFn}) {
+        const BamFile bamFile{fn};
+        const PbiRawData index{bamFile.PacBioIndexFilename()};
+        const auto& holeNumbers = index.BasicData().holeNumber_;
+        const auto [first, last] = std::minmax_element(holeNumbers.cbegin(), holeNumbers.cend());
+
+        const auto range = PbiIndexIO::LoadHoleNumberRange(bamFile.PacBioIndexFilename());
+        EXPECT_EQ(index.NumReads(), range.numReads);
+        EXPECT_EQ(*first, range.first);
+        EXPECT_EQ(*last, range.last);
+    }
+}
+
 TEST(BAM_PacBioIndex, throws_on_nonexistent_pbi_file)
 {
     EXPECT_THROW(PbiRawData("does_not_exist.pbi"), std::exception);
@@ -1,5 +1,14 @@
 #include <pbbam/../../src/Pulse2BaseCache.h>
 
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+
 #include <gtest/gtest.h>
 
 TEST(BAM_Pulse2BaseCache, can_determine_pulse_counts)
@@ -33,3 +42,97 @@ TEST(BAM_Pulse2BaseCache, can_remove_squashed_pulses_from_integer_vector)
     const PacBio::BAM::Pulse2BaseCache cache{pulseCalls};
     EXPECT_EQ(trimmedPkmean, cache.RemoveSquashedPulses(pkMean));
 }
+
+TEST(BAM_Pulse2BaseCache, can_find_basecalls_by_position_and_index)
+{
+    const std::string pulseCalls{"acCcTTAGtTCAtg"};
+    const PacBio::BAM::Pulse2BaseCache cache{pulseCalls};
+
+    EXPECT_EQ(2, cache.FindFirst());
+    EXPECT_EQ(4, cache.FindNext(2));
+    EXPECT_EQ(10, cache.FindNext(9));
+    EXPECT_EQ(PacBio::BAM::Pulse2BaseCache::npos, cache.FindNext(11));
+
+    EXPECT_EQ(0, cache.Rank(0));
+    EXPECT_EQ(1, cache.Rank(3));
+    EXPECT_EQ(8, cache.Rank(pulseCalls.size()));
+
+    EXPECT_EQ(2, cache.Select(0));
+    EXPECT_EQ(9, cache.Select(5));
+    EXPECT_EQ(11, cache.Select(7));
+}
+
+TEST(BAM_Pulse2BaseCache, handles_pulse_calls_without_basecalls)
+{
+    const PacBio::BAM::Pulse2BaseCache empty{""};
+    EXPECT_EQ(0, empty.NumPulses());
+    EXPECT_EQ(0, empty.NumBases());
+    EXPECT_EQ(PacBio::BAM::Pulse2BaseCache::npos, empty.FindFirst());
+    EXPECT_TRUE(empty.RemoveSquashedPulses(std::string{}).empty());
+
+    const std::string squashed{"acgtacgtacgt"};
+    const PacBio::BAM::Pulse2BaseCache cache{squashed};
+    EXPECT_EQ(squashed.size(), cache.NumPulses());
+    EXPECT_EQ(0, cache.NumBases());
+    EXPECT_EQ(PacBio::BAM::Pulse2BaseCache::npos, cache.FindFirst());
+    EXPECT_TRUE(cache.RemoveSquashedPulses(squashed).empty());
+}
+
+TEST(BAM_Pulse2BaseCache, long_pulse_calls_match_per_pulse_results)
+{
+    // covers whole & partial 64-pulse words, long basecall/squashed runs,
+    // and non-letter bytes
+    const std::string alphabet{"ACGTacgtZz@[`{-*"};
+    std::mt19937 gen{42};
+
+    for (const std::size_t length : {1, 15, 63, 64, 65, 127, 128, 200, 1000, 4099}) {
+        std::string pulseCalls;
+        std::uniform_int_distribution<std::size_t> pick{0, alphabet.size() - 1};
+        for (std::size_t i = 0; i < length; ++i) {
+            if (i >= 128 && i < 320) {
+                pulseCalls.push_back('A');  // whole words of basecalls
+            } else if (i >= 320 && i < 450) {
+                pulseCalls.push_back('c');  // whole words of squashed pulses
+            } else {
+                pulseCalls.push_back(alphabet[pick(gen)]);
+            }
+        }
+
+        std::vector<std::uint16_t> pulseData(length);
+        std::iota(pulseData.begin(), pulseData.end(), 0);
+
+        std::vector<std::size_t> basecallPositions;
+        std::vector<std::uint16_t> expectedData;
+        std::string expectedCalls;
+        for (std::size_t i = 0; i < length; ++i) {
+            if (std::isupper(static_cast<unsigned char>(pulseCalls[i]))) {
+                basecallPositions.push_back(i);
+                expectedData.push_back(pulseData[i]);
+                expectedCalls.push_back(pulseCalls[i]);
+            }
+        }
+
+        const PacBio::BAM::Pulse2BaseCache cache{pulseCalls};
+        EXPECT_EQ(length, cache.NumPulses());
+        EXPECT_EQ(basecallPositions.size(), cache.NumBases());
+        EXPECT_EQ(expectedCalls, cache.RemoveSquashedPulses(pulseCalls));
+        EXPECT_EQ(expectedData, cache.RemoveSquashedPulses(pulseData));
+
+        std::size_t rank = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            EXPECT_EQ(rank, cache.Rank(i));
+            const bool isBasecall = std::isupper(static_cast<unsigned char>(pulseCalls[i]));
+            EXPECT_EQ(isBasecall, cache.IsBasecallAt(i));
+            rank += isBasecall;
+        }
+        EXPECT_EQ(rank, cache.Rank(length));
+
+        std::size_t pos = cache.FindFirst();
+        for (std::size_t k = 0; k < basecallPositions.size(); ++k) {
+            EXPECT_EQ(basecallPositions[k], cache.Select(k));
+            EXPECT_EQ(basecallPositions[k], pos);
+            pos = cache.FindNext(pos);
+        }
+        EXPECT_EQ(PacBio::BAM::Pulse2BaseCache::npos, pos);
+    }
+}
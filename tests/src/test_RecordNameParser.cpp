@@ -0,0 +1,293 @@
+#include "../../src/RecordNameParser.h"
+
+#include <cstdint>
+
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PacBio;
+using namespace PacBio::BAM;
+
+namespace RecordNameParserTests {
+
+// Straightforward, allocating version of the name spec, for comparison.
+struct ExpectedParts
+{
+    std::string movieName;
+    std::string holeNumberText;
+    std::optional<std::int32_t> holeNumber;
+    std::optional<std::pair<Data::Position, Data::Position>> queryInterval;
+    std::string strand;
+    RecordNameType type = RecordNameType::UNKNOWN;
+};
+
+std::vector<std::string> SplitKeepEmpty(const std::string& text, const char delim)
+{
+    std::vector<std::string> result;
+    std::size_t start = 0;
+    while (true) {
+        const auto found = text.find(delim, start);
+        if (found == std::string::npos) {
+            result.push_back(text.substr(start));
+            return result;
+        }
+        result.push_back(text.substr(start, found - start));
+        start = found + 1;
+    }
+}
+
+std::optional<std::int32_t> ExpectedNumber(const std::string& text)
+{
+    const bool isNegative = (!text.empty() && text[0] == '-');
+    const std::size_t digitsStart = isNegative ? 1 : 0;
+    if (text.size() == digitsStart) {
+        return std::nullopt;
+    }
+
+    constexpr std::int64_t limit = std::int64_t{1} << 31;
+    std::int64_t value = 0;
+    for (std::size_t i = digitsStart; i < text.size(); ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return std::nullopt;
+        }
+        value = (value * 10) + (text[i] - '0');
+        if (value > limit) {
+            return std::nullopt;
+        }
+    }
+    if (isNegative) {
+        value = -value;
+    }
+    if (value >= limit) {
+        return std::nullopt;
+    }
+    return static_cast<std::int32_t>(value);
+}
+
+ExpectedParts ExpectedParse(const std::string& name)
+{
+    ExpectedParts result;
+    const auto tokens = SplitKeepEmpty(name, '/');
+    result.movieName = tokens[0];
+    if (tokens.size() < 2) {
+        return result;
+    }
+
+    result.holeNumberText = tokens[1];
+    result.holeNumber = ExpectedNumber(tokens[1]);
+    if (result.movieName == "transcript") {
+        result.type = RecordNameType::TRANSCRIPT;
+        return result;
+    }
+
+    bool isCcs = false;
+    for (std::size_t i = 2; i < tokens.size(); ++i) {
+        if (tokens[i] == "ccs") {
+            isCcs = true;
+        } else if (isCcs && (tokens[i] == "fwd" || tokens[i] == "rev")) {
+            result.strand = tokens[i];
+        }
+    }
+
+    if (tokens.size() > 2) {
+        const auto& last = tokens.back();
+        const auto underscore = last.find('_');
+        if (underscore != std::string::npos) {
+            const auto qStart = ExpectedNumber(last.substr(0, underscore));
+            const auto qEnd = ExpectedNumber(last.substr(underscore + 1));
+            if (qStart && qEnd) {
+                result.queryInterval = std::make_pair(*qStart, *qEnd);
+            }
+        }
+    }
+
+    if (isCcs) {
+        result.type = result.queryInterval ? RecordNameType::SEGMENT : RecordNameType::CCS;
+    } else if (result.queryInterval) {
+        result.type = RecordNameType::QUERY;
+    }
+    return result;
+}
+
+void CheckMatchesExpected(const std::string& name)
+{
+    SCOPED_TRACE("name: '" + name + "'");
+    const auto expected = ExpectedParse(name);
+    const auto parts = ParseRecordName(name);
+
+    EXPECT_EQ(name, parts.name);
+    EXPECT_EQ(expected.movieName, parts.movieName);
+    EXPECT_EQ(expected.holeNumberText, parts.holeNumberText);
+    EXPECT_EQ(expected.holeNumber, parts.holeNumber);
+    EXPECT_EQ(expected.queryInterval, parts.queryInterval);
+    EXPECT_EQ(expected.strand, parts.strand);
+    EXPECT_EQ(expected.type, parts.type);
+}
+
+}  // namespace RecordNameParserTests
+
+TEST(BAM_RecordNameParser, can_parse_subread_name)
+{
+    const auto parts = ParseRecordName("m64011_190228_190319/7/100_2000");
+    EXPECT_EQ("m64011_190228_190319", parts.movieName);
+    EXPECT_EQ(7, parts.holeNumber.value());
+    ASSERT_TRUE(parts.queryInterval);
+    EXPECT_EQ(100, parts.queryInterval->first);
+    EXPECT_EQ(2000, parts.queryInterval->second);
+    EXPECT_TRUE(parts.strand.empty());
+    EXPECT_EQ(RecordNameType::QUERY, parts.type);
+}
+
+TEST(BAM_RecordNameParser, can_parse_ccs_names)
+{
+    {
+        const auto parts = ParseRecordName("movie/42/ccs");
+        EXPECT_EQ("movie", parts.movieName);
+        EXPECT_EQ(42, parts.holeNumber.value());
+        EXPECT_FALSE(parts.queryInterval);
+        EXPECT_TRUE(parts.strand.empty());
+        EXPECT_EQ(RecordNameType::CCS, parts.type);
+    }
+    {
+        const auto parts = ParseRecordName("movie/42/ccs/rev");
+        EXPECT_EQ(42, parts.holeNumber.value());
+        EXPECT_EQ("rev", parts.strand);
+        EXPECT_EQ(RecordNameType::CCS, parts.type);
+    }
+}
+
+TEST(BAM_RecordNameParser, can_parse_segment_name)
+{
+    const auto parts = ParseRecordName("movie/42/ccs/fwd/10_250");
+    EXPECT_EQ(42, parts.holeNumber.value());
+    EXPECT_EQ("fwd", parts.strand);
+    ASSERT_TRUE(parts.queryInterval);
+    EXPECT_EQ(10, parts.queryInterval->first);
+    EXPECT_EQ(250, parts.queryInterval->second);
+    EXPECT_EQ(RecordNameType::SEGMENT, parts.type);
+}
+
+TEST(BAM_RecordNameParser, can_parse_transcript_name)
+{
+    const auto parts = ParseRecordName("transcript/18");
+    EXPECT_EQ("transcript", parts.movieName);
+    EXPECT_EQ(18, parts.holeNumber.value());
+    EXPECT_FALSE(parts.queryInterval);
+    EXPECT_EQ(RecordNameType::TRANSCRIPT, parts.type);
+}
+
+TEST(BAM_RecordNameParser, leaves_malformed_components_empty)
+{
+    {
+        const auto parts = ParseRecordName("");
+        EXPECT_TRUE(parts.movieName.empty());
+        EXPECT_FALSE(parts.holeNumber);
+    }
+    {
+        const auto parts = ParseRecordName("movie");
+        EXPECT_EQ("movie", parts.movieName);
+        EXPECT_TRUE(parts.holeNumberText.empty());
+        EXPECT_FALSE(parts.holeNumber);
+        EXPECT_EQ(RecordNameType::UNKNOWN, parts.type);
+    }
+    {
+        const auto parts = ParseRecordName("movie/12x/0_10");
+        EXPECT_EQ("12x", parts.holeNumberText);
+        EXPECT_FALSE(parts.holeNumber);
+        EXPECT_TRUE(parts.queryInterval);
+    }
+    {
+        const auto parts = ParseRecordName("movie/12/0_10_20");
+        EXPECT_EQ(12, parts.holeNumber.value());
+        EXPECT_FALSE(parts.queryInterval);
+        EXPECT_EQ(RecordNameType::UNKNOWN, parts.type);
+    }
+    {
+        const auto parts = ParseRecordName("movie/12/99999999999_10");
+        EXPECT_FALSE(parts.queryInterval);
+    }
+}
+
+TEST(BAM_RecordNameParser, generated_valid_names_round_trip)
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<std::int32_t> number{0, 100000000};
+    std::uniform_int_distribution<int> layout{0, 4};
+
+    for (int i = 0; i < 2000; ++i) {
+        const std::string movie = "m" + std::to_string(number(rng));
+        const std::int32_t zmw = number(rng);
+        const Data::Position qStart = number(rng);
+        const Data::Position qEnd = number(rng);
+        const std::string interval = std::to_string(qStart) + '_' + std::to_string(qEnd);
+
+        const int nameLayout = layout(rng);
+        std::string name = movie + '/' + std::to_string(zmw);
+        RecordNameType expectedType = RecordNameType::QUERY;
+        switch (nameLayout) {
+            case 0:
+                name += '/' + interval;
+                break;
+            case 1:
+                name += "/ccs";
+                expectedType = RecordNameType::CCS;
+                break;
+            case 2:
+                name += "/ccs/rev";
+                expectedType = RecordNameType::CCS;
+                break;
+            case 3:
+                name += "/ccs/fwd/" + interval;
+                expectedType = RecordNameType::SEGMENT;
+                break;
+            default:
+                name = "transcript/" + std::to_string(zmw);
+                expectedType = RecordNameType::TRANSCRIPT;
+                break;
+        }
+
+        SCOPED_TRACE("name: '" + name + "'");
+        const auto parts = ParseRecordName(name);
+        EXPECT_EQ(expectedType, parts.type);
+        EXPECT_EQ(zmw, parts.holeNumber.value());
+        if (nameLayout == 0 || nameLayout == 3) {
+            ASSERT_TRUE(parts.queryInterval);
+            EXPECT_EQ(qStart, parts.queryInterval->first);
+            EXPECT_EQ(qEnd, parts.queryInterval->second);
+        } else {
+            EXPECT_FALSE(parts.queryInterval);
+        }
+        if (nameLayout != 4) {
+            EXPECT_EQ(movie, parts.movieName);
+        }
+    }
+}
+
+TEST(BAM_RecordNameParser, random_names_match_reference_parse)
+{
+    // bias the alphabet toward name syntax, so that near-valid names are common
+    const std::vector<std::string> pieces{"/",   "/",   "_",   "0",   "7",   "42",  "-",
+                                          "ccs", "fwd", "rev", "m",   "x",   " ",   "transcript",
+                                          "+1",  "",    "//",  "9_9", "/ccs"};
+    std::mt19937 rng{2024};
+    std::uniform_int_distribution<std::size_t> pickPiece{0, pieces.size() - 1};
+    std::uniform_int_distribution<int> nameLength{0, 10};
+
+    for (int i = 0; i < 20000; ++i) {
+        std::string name;
+        const int numPieces = nameLength(rng);
+        for (int j = 0; j < numPieces; ++j) {
+            name += pieces[pickPiece(rng)];
+        }
+        RecordNameParserTests::CheckMatchesExpected(name);
+        if (HasFailure()) {
+            break;
+        }
+    }
+}
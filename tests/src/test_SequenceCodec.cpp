@@ -0,0 +1,100 @@
+#include "../../src/SequenceCodec.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbbam/BamRecordImpl.h>
+#include <pbcopper/data/QualityValues.h>
+
+#include "../../src/SequenceUtils.h"
+
+using SimdLevel = PacBio::BAM::SimdLevel;
+
+namespace SequenceCodecTests {
+
+const std::vector<SimdLevel> AllLevels{SimdLevel::SCALAR, SimdLevel::SSE4, SimdLevel::AVX2};
+
+// includes lengths around each kernel's block size, & odd lengths
+const std::vector<std::size_t> Lengths{0, 1, 2, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 1001};
+
+std::string RandomSequence(const std::size_t length, const std::string& alphabet,
+                           std::mt19937& rng)
+{
+    std::uniform_int_distribution<std::size_t> pick{0, alphabet.size() - 1};
+    std::string result(length, '\0');
+    for (auto& c : result) {
+        c = alphabet[pick(rng)];
+    }
+    return result;
+}
+
+}  // namespace SequenceCodecTests
+
+TEST(BAM_SequenceCodec, all_levels_roundtrip_acgtn)
+{
+    std::mt19937 rng{42};
+    for (const auto length : SequenceCodecTests::Lengths) {
+        const auto seq = SequenceCodecTests::RandomSequence(length, "ACGTN", rng);
+        for (const auto level : SequenceCodecTests::AllLevels) {
+            std::vector<std::uint8_t> encoded((length + 1) / 2);
+            PacBio::BAM::EncodeSequence(seq.data(), length, encoded.data(), level);
+
+            std::string decoded(length, '\0');
+            PacBio::BAM::DecodeSequence(encoded.data(), length, decoded.data(), level);
+            EXPECT_EQ(seq, decoded) << "length: " << length;
+
+            std::string rc(length, '\0');
+            PacBio::BAM::DecodeReverseComplementSequence(encoded.data(), length, rc.data(),
+                                                         level);
+            EXPECT_EQ(PacBio::BAM::ReverseComplemented(seq), rc) << "length: " << length;
+        }
+    }
+}
+
+TEST(BAM_SequenceCodec, all_levels_encode_lower_case_and_ambiguity_codes)
+{
+    std::mt19937 rng{7};
+    for (const auto length : SequenceCodecTests::Lengths) {
+        const auto seq = SequenceCodecTests::RandomSequence(length, "acgtnACGTMRWSYKVHDB=", rng);
+
+        std::vector<std::uint8_t> expected((length + 1) / 2);
+        PacBio::BAM::EncodeSequence(seq.data(), length, expected.data(), SimdLevel::SCALAR);
+        for (const auto level : SequenceCodecTests::AllLevels) {
+            std::vector<std::uint8_t> encoded((length + 1) / 2);
+            PacBio::BAM::EncodeSequence(seq.data(), length, encoded.data(), level);
+            EXPECT_EQ(expected, encoded) << "length: " << length;
+        }
+    }
+}
+
+TEST(BAM_SequenceCodec, record_impl_decodes_into_reused_buffers)
+{
+    const std::string seq{"ACGTTTGCANNACGTACGTACGTACGTACGTACGTACGTAC"};
+    const std::string quals{"!!#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHI"};
+    ASSERT_EQ(seq.size(), quals.size());
+
+    PacBio::BAM::BamRecordImpl impl;
+    impl.SetSequenceAndQualities(seq, quals);
+
+    std::string decoded{"some previous, longer contents"};
+    decoded.append(100, 'x');
+    impl.SequenceInto(decoded);
+    EXPECT_EQ(seq, decoded);
+
+    impl.SequenceInto(decoded, true);
+    EXPECT_EQ(PacBio::BAM::ReverseComplemented(seq), decoded);
+
+    PacBio::Data::QualityValues qvs{PacBio::Data::QualityValues::FromFastq("!!!")};
+    impl.QualitiesInto(qvs);
+    EXPECT_EQ(quals, qvs.Fastq());
+
+    impl.SetSequenceAndQualities(seq);
+    impl.QualitiesInto(qvs);
+    EXPECT_TRUE(qvs.empty());
+}
@@ -1,8 +1,11 @@
 #include <pbbam/TextFileWriter.h>
 
+#include <cstddef>
 #include <cstdio>
 
 #include <algorithm>
+#include <filesystem>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -37,6 +40,29 @@ void CheckRoundTrip(const std::string& outFn, const PacBio::BAM::HtslibCompressi
     std::remove(outFn.c_str());
 }
 
+// enough lines to fill the output buffer several times over
+void CheckLargeRoundTrip(const std::string& outFn, const std::size_t numThreads,
+                         const PacBio::BAM::HtslibCompression compressionType)
+{
+    constexpr int NUM_LINES = 200000;
+    {
+        TextFileWriter writer{outFn, numThreads};
+        for (int i = 0; i < NUM_LINES; ++i) {
+            writer.Write("line_" + std::to_string(i));
+        }
+    }
+    EXPECT_EQ(compressionType, PacBio::BAM::FormatUtils::CompressionType(outFn));
+
+    const auto contents = TextFileReader::ReadAll(outFn);
+    ASSERT_EQ(NUM_LINES, contents.size());
+    for (int i = 0; i < NUM_LINES; i += 1009) {
+        EXPECT_EQ("line_" + std::to_string(i), contents[i]);
+    }
+    EXPECT_EQ("line_" + std::to_string(NUM_LINES - 1), contents.back());
+
+    std::remove(outFn.c_str());
+}
+
 }  // namespace TextFileWriterTests
 
 TEST(BAM_TextFileWriter, throws_on_empty_filename)
@@ -57,3 +83,67 @@ TEST(BAM_TextFileWriter, can_write_gzipped_text)
         PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/out.txt.gz",
         PacBio::BAM::HtslibCompression::GZIP);
 }
+
+TEST(BAM_TextFileWriter, can_write_large_plain_text)
+{
+    TextFileWriterTests::CheckLargeRoundTrip(
+        PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/out_large.txt", 1,
+        PacBio::BAM::HtslibCompression::NONE);
+}
+
+TEST(BAM_TextFileWriter, can_write_large_gzipped_text)
+{
+    TextFileWriterTests::CheckLargeRoundTrip(
+        PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/out_large.txt.gz", 1,
+        PacBio::BAM::HtslibCompression::GZIP);
+}
+
+TEST(BAM_TextFileWriter, can_write_multithreaded_gzipped_text_as_bgzf)
+{
+    TextFileWriterTests::CheckLargeRoundTrip(
+        PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/out_large_mt.txt.gz", 4,
+        PacBio::BAM::HtslibCompression::BGZIP);
+}
+
+TEST(BAM_TextFileWriter, close_flushes_output_before_destruction)
+{
+    const std::string outFn{PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/out_closed.txt"};
+
+    {
+        TextFileWriter writer{outFn};
+        for (const auto& line : TextFileWriterTests::Lines) {
+            writer.Write(line);
+        }
+        writer.Close();
+        EXPECT_THROW(writer.Write("qux"), std::runtime_error);
+
+        // contents are complete, though the target is only renamed on destruction
+        EXPECT_EQ(TextFileWriterTests::Lines, TextFileReader::ReadAll(outFn + ".tmp"));
+    }
+    EXPECT_EQ(TextFileWriterTests::Lines, TextFileReader::ReadAll(outFn));
+
+    std::remove(outFn.c_str());
+}
+
+TEST(BAM_TextFileWriter, failed_close_throws_and_skips_target_file)
+{
+    namespace fs = std::filesystem;
+    if (!fs::exists("/dev/full")) {
+        GTEST_SKIP() << "requires /dev/full";
+    }
+
+    // temp file writes go to /dev/full, which fails with ENOSPC
+    const std::string outFn{PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/out_full.txt"};
+    const std::string tempFn{outFn + ".tmp"};
+    fs::remove(outFn);
+    fs::remove(tempFn);
+    fs::create_symlink("/dev/full", tempFn);
+
+    {
+        TextFileWriter writer{outFn};
+        writer.Write("foo");
+        EXPECT_THROW(writer.Close(), std::runtime_error);
+    }
+    EXPECT_FALSE(fs::exists(outFn));
+    EXPECT_FALSE(fs::is_symlink(tempFn));
+}
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -14,6 +15,7 @@
 #include <pbcopper/data/Cigar.h>
 
 #include "../src/ValidationErrors.h"
+#include "PbbamTestData.h"
 
 using namespace PacBio;
 using namespace PacBio::BAM;
@@ -183,6 +185,22 @@ TEST(ValidatorErrorsTest, constructs_expected_validation_exception)
     }
 }
 
+TEST(ValidatorErrorsTest, append_adds_errors_and_honors_max)
+{
+    ValidationErrors errors(3);
+    errors.AddFileError("foo", "you");
+
+    ValidationErrors other;
+    other.AddRecordError("bar", "me");
+    errors.Append(std::move(other));
+    EXPECT_EQ(2, errors.NumErrors());
+    EXPECT_TRUE(other.IsEmpty());
+
+    ValidationErrors another;
+    another.AddRecordError("baz", "us");
+    EXPECT_THROW(errors.Append(std::move(another)), ValidationException);
+}
+
 TEST(BAM_Validator, success_on_valid_read_group)
 {
     ASSERT_NO_THROW(Validator::Validate(ValidatorTests::validReadGroup));
@@ -632,3 +650,21 @@ TEST(BAM_Validator, optional_fields_settable)
     EXPECT_EQ(icsVersion, rg.IcsVersion());
     EXPECT_EQ(movieLength, rg.MovieLength());
 }
+
+TEST(BAM_Validator, multithreaded_entire_file_validation_matches_serial)
+{
+    const BamFile file{PbbamTestsConfig::Data_Dir + "/group/test2.bam"};
+
+    const auto validate = [&file](const std::size_t numThreads) {
+        try {
+            Validator::ValidateEntireFile(file, ValidationErrors::MAX, numThreads);
+        } catch (const ValidationException& e) {
+            return std::make_pair(e.FileErrors(), e.RecordErrors());
+        }
+        return std::make_pair(ValidationException::ErrorMap{}, ValidationException::ErrorMap{});
+    };
+
+    const auto expected = validate(1);
+    EXPECT_EQ(expected, validate(2));
+    EXPECT_EQ(expected, validate(8));
+}
@@ -1,17 +1,23 @@
 #include <pbbam/vcf/VcfQuery.h>
 
 #include <cstddef>
+#include <cstdio>
 
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include <pbbam/BgzipWriter.h>
 #include <pbbam/vcf/VcfFile.h>
 
 #include "PbbamTestData.h"
 
+using GenomicInterval = PacBio::Data::GenomicInterval;
 using VcfFile = PacBio::VCF::VcfFile;
 using VcfQuery = PacBio::VCF::VcfQuery;
 using VcfVariant = PacBio::VCF::VcfVariant;
@@ -26,6 +32,32 @@ const std::vector<std::string> ExpectedIds{
 
 const std::string VcfFn{PacBio::BAM::PbbamTestsConfig::Data_Dir + "/vcf/structural_variants.vcf"};
 
+const std::string CompressedVcfFn{PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir +
+                                  "/structural_variants.vcf.gz"};
+
+// writes a fresh, unindexed BGZF copy of the test VCF
+void MakeCompressedVcf()
+{
+    std::remove((CompressedVcfFn + ".tbi").c_str());
+    std::remove((CompressedVcfFn + ".csi").c_str());
+
+    std::ifstream in{VcfFn};
+    std::ostringstream text;
+    text << in.rdbuf();
+
+    PacBio::BAM::BgzipWriter writer{CompressedVcfFn};
+    writer.Write(text.str());
+}
+
+std::vector<std::string> QueryIds(VcfQuery& query)
+{
+    std::vector<std::string> result;
+    for (const auto& var : query) {
+        result.push_back(var.Id());
+    }
+    return result;
+}
+
 }  // namespace VcfQueryTests
 
 TEST(VCF_VcfQuery, can_use_range_over_input_filename)
@@ -49,3 +81,58 @@ TEST(VCF_VcfQuery, can_use_range_over_input_file_object)
         ++i;
     }
 }
+
+TEST(VCF_VcfQuery, can_read_bgzf_compressed_file)
+{
+    VcfQueryTests::MakeCompressedVcf();
+    const VcfFile file{VcfQueryTests::CompressedVcfFn};
+    EXPECT_TRUE(file.IsCompressed());
+    EXPECT_EQ(VcfFile{VcfQueryTests::VcfFn}.Header().NumLines(), file.Header().NumLines());
+
+    VcfQuery query{file};
+    EXPECT_EQ(VcfQueryTests::ExpectedIds, VcfQueryTests::QueryIds(query));
+}
+
+TEST(VCF_VcfQuery, can_create_tabix_index)
+{
+    VcfQueryTests::MakeCompressedVcf();
+    const VcfFile file{VcfQueryTests::CompressedVcfFn};
+    EXPECT_FALSE(file.IndexExists());
+
+    file.EnsureIndexExists();
+    EXPECT_TRUE(file.IndexExists());
+}
+
+TEST(VCF_VcfQuery, can_query_single_interval)
+{
+    VcfQueryTests::MakeCompressedVcf();
+    const VcfFile file{VcfQueryTests::CompressedVcfFn};
+    file.EnsureIndexExists();
+
+    const std::vector<std::string> expected{"pbsv.DEL.2", "pbsv.INS.3", "pbsv.INS.4"};
+    VcfQuery query{file, GenomicInterval{"chrIII", 91000, 170000}};
+    EXPECT_EQ(expected, VcfQueryTests::QueryIds(query));
+}
+
+TEST(VCF_VcfQuery, can_query_multiple_intervals_in_file_order_without_duplicates)
+{
+    VcfQueryTests::MakeCompressedVcf();
+    const VcfFile file{VcfQueryTests::CompressedVcfFn};
+    file.EnsureIndexExists(PacBio::VCF::VcfIndexType::CSI);
+
+    const std::vector<GenomicInterval> intervals{
+        GenomicInterval{"chrXIII", 908000, 909000}, GenomicInterval{"chrIII", 169000, 169300},
+        GenomicInterval{"chrIII", 169200, 169600}, GenomicInterval{"chrUnknown", 0, 100}};
+    const std::vector<std::string> expected{"pbsv.INS.3", "pbsv.INS.4", "pbsv.INS.17",
+                                            "pbsv.INS.18"};
+    VcfQuery query{file, intervals};
+    EXPECT_EQ(expected, VcfQueryTests::QueryIds(query));
+}
+
+TEST(VCF_VcfQuery, interval_query_throws_on_uncompressed_file)
+{
+    const VcfFile file{VcfQueryTests::VcfFn};
+    EXPECT_FALSE(file.IsCompressed());
+    EXPECT_THROW(file.EnsureIndexExists(), std::runtime_error);
+    EXPECT_THROW(VcfQuery(file, GenomicInterval{"chrIII", 0, 1000}), std::runtime_error);
+}
@@ -2,8 +2,15 @@
 
 #include <cstdio>
 
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include <pbbam/BgzipWriter.h>
 #include <pbbam/vcf/VcfQuery.h>
 
 #include "PbbamTestData.h"
@@ -16,6 +23,36 @@ namespace VcfSortTests {
 const std::string inputFn = PacBio::BAM::PbbamTestsConfig::Data_Dir + "/vcf/unsorted.vcf";
 const std::string outputFn = PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/sorted.vcf";
 
+const std::vector<std::string> ExpectedIds{"variant0", "variant5", "variant1",
+                                           "variant3", "variant4", "variant2"};
+
+std::string InputText()
+{
+    std::ifstream in{inputFn};
+    std::ostringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+std::vector<std::string> OutputIds()
+{
+    std::vector<std::string> result;
+    VcfQuery query{outputFn};
+    for (const auto& var : query) {
+        result.push_back(var.Id());
+    }
+    return result;
+}
+
+PacBio::VCF::SortConfig TinyMemoryConfig()
+{
+    // every variant is spilled to its own temp file
+    PacBio::VCF::SortConfig config;
+    config.maxMemory = 1;
+    config.numThreads = 2;
+    return config;
+}
+
 }  // namespace VcfSortTests
 
 TEST(VCF_VcfSort, sorts_input_file)
@@ -36,3 +73,112 @@ TEST(VCF_VcfSort, sorts_input_file)
     // remove temp file
     std::remove(VcfSortTests::outputFn.c_str());
 }
+
+TEST(VCF_VcfSort, external_merge_sort_matches_in_memory_sort)
+{
+    // tiny memory budget: every variant is spilled to its own temp file
+    PacBio::VCF::SortConfig config;
+    config.maxMemory = 1;
+    config.numThreads = 2;
+    PacBio::VCF::SortFile(VcfSortTests::inputFn, VcfSortTests::outputFn, config);
+
+    const std::vector<std::string> expectedIds{"variant0", "variant5", "variant1",
+                                               "variant3", "variant4", "variant2"};
+
+    std::size_t i = 0;
+    VcfQuery query{VcfSortTests::outputFn};
+    for (const auto& var : query) {
+        EXPECT_EQ(expectedIds.at(i), var.Id());
+        ++i;
+    }
+    EXPECT_EQ(expectedIds.size(), i);
+
+    // remove temp file
+    std::remove(VcfSortTests::outputFn.c_str());
+}
+
+TEST(VCF_VcfSort, external_sort_reads_bgzf_compressed_input)
+{
+    const std::string compressedFn =
+        PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/unsorted.vcf.gz";
+    {
+        PacBio::BAM::BgzipWriter writer{compressedFn};
+        writer.Write(VcfSortTests::InputText());
+    }
+
+    PacBio::VCF::SortFile(compressedFn, VcfSortTests::outputFn, PacBio::VCF::SortConfig{});
+    EXPECT_EQ(VcfSortTests::ExpectedIds, VcfSortTests::OutputIds());
+
+    PacBio::VCF::SortFile(compressedFn, VcfSortTests::outputFn, VcfSortTests::TinyMemoryConfig());
+    EXPECT_EQ(VcfSortTests::ExpectedIds, VcfSortTests::OutputIds());
+
+    // remove temp files
+    std::remove(compressedFn.c_str());
+    std::remove(VcfSortTests::outputFn.c_str());
+}
+
+TEST(VCF_VcfSort, external_sort_skips_blank_lines)
+{
+    // blank line between variants should not end input
+    auto text = VcfSortTests::InputText();
+    const auto secondVariant = text.find("ctg1\t10\t");
+    ASSERT_NE(std::string::npos, secondVariant);
+    text.insert(secondVariant, "\n");
+
+    const std::string inputFn =
+        PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/unsorted_blank_line.vcf";
+    {
+        std::ofstream out{inputFn};
+        out << text;
+    }
+
+    PacBio::VCF::SortFile(inputFn, VcfSortTests::outputFn, PacBio::VCF::SortConfig{});
+    EXPECT_EQ(VcfSortTests::ExpectedIds, VcfSortTests::OutputIds());
+
+    // remove temp files
+    std::remove(inputFn.c_str());
+    std::remove(VcfSortTests::outputFn.c_str());
+}
+
+TEST(VCF_VcfSort, external_sort_merges_in_multiple_passes)
+{
+    // 6 single-variant runs, merged 2 at a time
+    auto config = VcfSortTests::TinyMemoryConfig();
+    config.maxMergeFiles = 2;
+    PacBio::VCF::SortFile(VcfSortTests::inputFn, VcfSortTests::outputFn, config);
+    EXPECT_EQ(VcfSortTests::ExpectedIds, VcfSortTests::OutputIds());
+
+    // remove temp file
+    std::remove(VcfSortTests::outputFn.c_str());
+}
+
+TEST(VCF_VcfSort, failed_external_sort_leaves_existing_output_untouched)
+{
+    namespace fs = std::filesystem;
+    if (!fs::exists("/dev/full")) {
+        GTEST_SKIP() << "requires /dev/full";
+    }
+
+    const std::string outFn{PacBio::BAM::PbbamTestsConfig::GeneratedData_Dir + "/sorted_full.vcf"};
+    const std::string tempFn{outFn + ".tmp"};
+    {
+        std::ofstream out{outFn};
+        out << "original\n";
+    }
+
+    // merged output goes to /dev/full, which fails with ENOSPC
+    fs::remove(tempFn);
+    fs::create_symlink("/dev/full", tempFn);
+    EXPECT_THROW(PacBio::VCF::SortFile(VcfSortTests::inputFn, outFn,
+                                       VcfSortTests::TinyMemoryConfig()),
+                 std::runtime_error);
+
+    std::ifstream in{outFn};
+    std::ostringstream text;
+    text << in.rdbuf();
+    EXPECT_EQ("original\n", text.str());
+    EXPECT_FALSE(fs::is_symlink(tempFn));
+
+    // remove temp file
+    std::remove(outFn.c_str());
+}
@@ -0,0 +1,119 @@
+#include <pbbam/vcf/VcfVariantView.h>
+
+#include <cstddef>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <pbbam/vcf/VcfReader.h>
+
+#include "PbbamTestData.h"
+
+using VcfReader = PacBio::VCF::VcfReader;
+using VcfVariant = PacBio::VCF::VcfVariant;
+using VcfVariantView = PacBio::VCF::VcfVariantView;
+
+namespace VcfVariantViewTests {
+
+const std::string BasicVariantText{
+    "chrXVI\t660831\tpbsv.INS.21\tC\tCAAAGGAATGGTAAAGATGGGGGGTCAACGGACAAGGGAAAGGATCCATGGGGGCA\t."
+    "\tPASS"
+    "\tIMPRECISE;SVTYPE=INS;END=660831;SVLEN=55;MULTI=1,2,3\tGT:AD:DP:AC\t0/1:2:5:1,2"};
+
+}  // namespace VcfVariantViewTests
+
+TEST(VCF_VcfVariantView, default_ctor_provides_empty_values)
+{
+    const VcfVariantView v;
+
+    EXPECT_TRUE(v.Chrom().empty());
+    EXPECT_EQ(PacBio::Data::UNMAPPED_POSITION, v.Position());
+    EXPECT_TRUE(v.Id().empty());
+    EXPECT_TRUE(v.IsQualityMissing());
+    EXPECT_FALSE(v.HasInfoField("SVTYPE"));
+    EXPECT_EQ(0, v.NumSamples());
+}
+
+TEST(VCF_VcfVariantView, can_read_fixed_columns)
+{
+    const VcfVariantView v{VcfVariantViewTests::BasicVariantText};
+
+    EXPECT_EQ("chrXVI", v.Chrom());
+    EXPECT_EQ(660831, v.Position());
+    EXPECT_EQ("pbsv.INS.21", v.Id());
+    EXPECT_EQ("C", v.RefAllele());
+    EXPECT_EQ("CAAAGGAATGGTAAAGATGGGGGGTCAACGGACAAGGGAAAGGATCCATGGGGGCA", v.AltAllele());
+    EXPECT_TRUE(v.IsQualityMissing());
+    EXPECT_EQ("PASS", v.Filter());
+    EXPECT_TRUE(v.IsInsertion());
+    EXPECT_FALSE(v.IsDeletion());
+    EXPECT_FALSE(v.IsSnp());
+}
+
+TEST(VCF_VcfVariantView, can_read_info_fields)
+{
+    const VcfVariantView v{VcfVariantViewTests::BasicVariantText};
+
+    EXPECT_TRUE(v.HasInfoField("IMPRECISE"));
+    EXPECT_FALSE(v.InfoValue("IMPRECISE"));
+    EXPECT_EQ("INS", v.InfoValue("SVTYPE").value());
+    EXPECT_EQ("55", v.InfoValue("SVLEN").value());
+    EXPECT_EQ("1,2,3", v.InfoValue("MULTI").value());
+    EXPECT_FALSE(v.HasInfoField("NOT_PRESENT"));
+}
+
+TEST(VCF_VcfVariantView, can_read_genotype_fields)
+{
+    const VcfVariantView v{VcfVariantViewTests::BasicVariantText};
+
+    EXPECT_EQ(1, v.NumSamples());
+    const std::vector<std::string_view> expectedIds{"GT", "AD", "DP", "AC"};
+    EXPECT_EQ(expectedIds, v.GenotypeIds());
+
+    EXPECT_EQ("0/1", v.GenotypeValue(0, "GT").value());
+    EXPECT_EQ("5", v.GenotypeValue(0, "DP").value());
+    EXPECT_EQ("1,2", v.GenotypeValue(0, "AC").value());
+    EXPECT_FALSE(v.GenotypeValue(0, "NOT_PRESENT"));
+}
+
+TEST(VCF_VcfVariantView, converts_to_variant)
+{
+    const VcfVariantView view{VcfVariantViewTests::BasicVariantText};
+    const VcfVariant var = view.ToVariant();
+
+    EXPECT_EQ(view.Chrom(), var.Chrom());
+    EXPECT_EQ(view.Position(), var.Position());
+    EXPECT_EQ(view.Id(), var.Id());
+    EXPECT_EQ("INS", var.InfoValue("SVTYPE").value());
+}
+
+TEST(VCF_VcfVariantView, reader_fetches_same_variants_as_full_parse)
+{
+    const std::string fn{PacBio::BAM::PbbamTestsConfig::Data_Dir + "/vcf/structural_variants.vcf"};
+
+    std::vector<VcfVariant> expected;
+    {
+        VcfReader reader{fn};
+        VcfVariant var;
+        while (reader.GetNext(var)) {
+            expected.push_back(var);
+        }
+    }
+
+    std::size_t i = 0;
+    VcfReader reader{fn};
+    VcfVariantView view;
+    while (reader.GetNext(view)) {
+        const auto& var = expected.at(i);
+        EXPECT_EQ(var.Chrom(), view.Chrom());
+        EXPECT_EQ(var.Position(), view.Position());
+        EXPECT_EQ(var.Id(), view.Id());
+        EXPECT_EQ(var.InfoValue("SVTYPE").value(), view.InfoValue("SVTYPE").value());
+        EXPECT_EQ(var.GenotypeValue(0, "GT").value(), view.GenotypeValue(0, "GT").value());
+        ++i;
+    }
+    EXPECT_EQ(expected.size(), i);
+}
@@ -2,7 +2,11 @@
 
 #include <algorithm>
 #include <iterator>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -173,3 +177,116 @@ TEST(BAM_ZmwGroupQuery, can_apply_custom_pbi_filter)
     const std::vector<std::int32_t> expectedHoleNumbers{1603, 1638, 1640};
     EXPECT_TRUE(std::equal(holeNumbers.cbegin(), holeNumbers.cend(), expectedHoleNumbers.cbegin()));
 }
+
+TEST(BAM_ZmwGroupQuery, round_robin_query_with_max_open_files_matches_unlimited_query)
+{
+    using Group = std::pair<std::int32_t, std::size_t>;  // hole number, num records
+
+    std::vector<Group> expected;
+    PacBio::BAM::ZmwGroupQuery unlimitedQuery{ZmwQueryTests::input,
+                                              PacBio::BAM::ZmwFileIterationMode::ROUND_ROBIN,
+                                              PacBio::BAM::DataSetFilterMode::IGNORE};
+    for (const auto& zmw : unlimitedQuery) {
+        ASSERT_FALSE(zmw.empty());
+        expected.emplace_back(zmw.front().HoleNumber(), zmw.size());
+    }
+
+    PacBio::BAM::ZmwGroupQuery::Config config;
+    config.iterationMode = PacBio::BAM::ZmwFileIterationMode::ROUND_ROBIN;
+    config.maxOpenFiles = 1;
+
+    std::vector<Group> observed;
+    PacBio::BAM::ZmwGroupQuery limitedQuery{ZmwQueryTests::input, config,
+                                            PacBio::BAM::DataSetFilterMode::IGNORE};
+    for (const auto& zmw : limitedQuery) {
+        ASSERT_FALSE(zmw.empty());
+        observed.emplace_back(zmw.front().HoleNumber(), zmw.size());
+    }
+
+    EXPECT_EQ(90, observed.size());
+    EXPECT_EQ(expected, observed);
+}
+
+TEST(BAM_ZmwGroupQuery, sharded_query_with_deterministic_order_matches_sequential_query)
+{
+    using Group = std::pair<std::int32_t, std::size_t>;  // hole number, num records
+
+    std::vector<Group> expected;
+    PacBio::BAM::ZmwGroupQuery sequentialQuery{ZmwQueryTests::input,
+                                               PacBio::BAM::ZmwFileIterationMode::SEQUENTIAL,
+                                               PacBio::BAM::DataSetFilterMode::IGNORE};
+    for (const auto& zmw : sequentialQuery) {
+        ASSERT_FALSE(zmw.empty());
+        expected.emplace_back(zmw.front().HoleNumber(), zmw.size());
+    }
+
+    PacBio::BAM::ZmwGroupQuery::Config config;
+    config.numShards = 4;
+    config.prefetchSize = 2;
+    config.deterministicOrder = true;
+
+    std::vector<Group> observed;
+    PacBio::BAM::ZmwGroupQuery shardedQuery{ZmwQueryTests::input, config,
+                                            PacBio::BAM::DataSetFilterMode::IGNORE};
+    for (const auto& zmw : shardedQuery) {
+        ASSERT_FALSE(zmw.empty());
+        observed.emplace_back(zmw.front().HoleNumber(), zmw.size());
+    }
+
+    EXPECT_EQ(90, observed.size());
+    EXPECT_EQ(expected, observed);
+}
+
+TEST(BAM_ZmwGroupQuery, sharded_query_can_apply_dataset_filter)
+{
+    PacBio::BAM::ZmwGroupQuery::Config config;
+    config.numShards = 3;
+
+    std::size_t zmwCount = 0;
+    std::size_t recordCount = 0;
+    PacBio::BAM::ZmwGroupQuery query{ZmwQueryTests::input, config,
+                                     PacBio::BAM::DataSetFilterMode::APPLY};
+    for (const auto& zmw : query) {
+        ++zmwCount;
+        recordCount += zmw.size();
+        for (const auto& record : zmw) {
+            EXPECT_LT(record.HoleNumber(), 1816);
+        }
+    }
+    EXPECT_EQ(15, zmwCount);
+    EXPECT_EQ(150, recordCount);
+}
+
+TEST(BAM_ZmwGroupQuery, sharded_query_can_be_consumed_by_multiple_workers)
+{
+    PacBio::BAM::ZmwGroupQuery::Config config;
+    config.numShards = 4;
+    config.deterministicOrder = false;
+    PacBio::BAM::ZmwGroupQuery query{ZmwQueryTests::input, config,
+                                     PacBio::BAM::DataSetFilterMode::IGNORE};
+
+    std::mutex resultsMutex;
+    std::set<std::int32_t> holeNumbers;
+    std::size_t zmwCount = 0;
+    std::size_t recordCount = 0;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 4; ++i) {
+        workers.emplace_back([&]() {
+            std::vector<PacBio::BAM::BamRecord> zmw;
+            while (query.GetNext(zmw)) {
+                std::lock_guard<std::mutex> lock{resultsMutex};
+                ++zmwCount;
+                recordCount += zmw.size();
+                holeNumbers.insert(zmw.front().HoleNumber());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(90, zmwCount);
+    EXPECT_EQ(90, holeNumbers.size());
+    EXPECT_EQ(1220, recordCount);
+}
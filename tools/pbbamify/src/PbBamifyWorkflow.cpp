@@ -8,6 +8,7 @@
 
 #include <pbbam/BamReader.h>
 #include <pbbam/BamRecord.h>
+#include <pbbam/BamRecordEditor.h>
 #include <pbbam/BamWriter.h>
 #include <pbbam/DataSet.h>
 #include <pbbam/FastaReader.h>
@@ -368,13 +369,11 @@ bool Workflow::AugmentAlignment(const std::shared_ptr<QueryLookup> queryLookup,
     // dataset to be the correct answer to any of these. The rest are
     // produced by a mapper.
     // For example, BLASR will generate a RG tag even if the input was FASTA.
-    for (auto& tag : datasetRecord.Impl().Tags()) {
-        if (record.Impl().Tags().Contains(tag.first)) {
-            record.Impl().EditTag(tag.first, tag.second);
-        } else {
-            record.Impl().AddTag(tag.first, tag.second);
-        }
+    BAM::BamRecordEditor editor{record};
+    for (const auto& tag : datasetRecord.Impl().Tags()) {
+        editor.SetTag(tag.first, tag.second);
     }
+    editor.Commit();
 
     // Some downstream tools might not work well with the
     // "undefined" mapping quality value of 255. Here
@@ -3,7 +3,6 @@
 #include <cstdint>
 
 #include <iostream>
-#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -11,83 +10,59 @@
 #include <pbbam/PbiFile.h>
 #include <pbbam/PbiRawData.h>
 
+#include "PbiColumnReader.h"
+
 namespace PacBio {
 namespace PbIndexDump {
 namespace {
 
-std::string printReferenceData(const BAM::PbiRawReferenceData& referenceData)
+void printReferenceData(const std::vector<BAM::PbiReferenceEntry>& entries, std::ostream& out)
 {
-    std::ostringstream out;
-    for (const auto& entry : referenceData.entries_) {
-        if (!out.str().empty()) {
+    bool first = true;
+    for (const auto& entry : entries) {
+        if (!first) {
             out << ",\n";
         }
+        first = false;
 
         out << "    PbiReferenceEntry{" << entry.tId_ << "," << entry.beginRow_ << ","
             << entry.endRow_ << "}";
     }
-    if (!out.str().empty()) {
+    if (!first) {
         out << '\n';
     }
-    return out.str();
 }
 
+// Streams a column's values, without loading the entire column into memory.
 template <typename T>
-std::string printField(const std::vector<T>& c)
+void printField(const PbiColumnReader& index, const PbiColumnId id, std::ostream& out)
 {
-    std::ostringstream out;
-    for (const auto& e : c) {
-        out << e << ",";
-    }
-    auto result = out.str();
-    if (!result.empty()) {
-        result.pop_back();  // remove final comma
-    }
-    return result;
-}
-
-template <>
-std::string printField(const std::vector<uint8_t>& c)
-{
-    std::ostringstream out;
-    for (const auto& e : c) {
-        out << static_cast<uint16_t>(e)
-            << ",";  // cast to larger uint, force print as number not character
-    }
-    auto result = out.str();
-    if (!result.empty()) {
-        result.pop_back();  // remove final comma
-    }
-    return result;
-}
-
-template <>
-std::string printField(const std::vector<int8_t>& c)
-{
-    std::ostringstream out;
-    for (const auto& e : c) {
-        out << static_cast<int16_t>(e)
-            << ",";  // cast to larger int, force print as number not character
-    }
-    auto result = out.str();
-    if (!result.empty()) {
-        result.pop_back();  // remove final comma
+    out << '{';
+    if (index.NumReads() > 0) {
+        auto column = index.Column<T>(id);
+        for (std::uint32_t i = 0; i < index.NumReads(); ++i) {
+            if (i > 0) {
+                out << ',';
+            }
+            if constexpr (sizeof(T) == 1) {
+                // cast to larger int, force print as number not character
+                out << static_cast<std::int16_t>(column.Next());
+            } else {
+                out << column.Next();
+            }
+        }
     }
-    return result;
+    out << "};\n";
 }
 
 }  // namespace
 
 void CppFormatter::Run(const Settings& settings)
 {
-    const BAM::PbiRawData rawData{settings.InputFile};
-    const auto& barcodeData = rawData.BarcodeData();
-    const auto& basicData = rawData.BasicData();
-    const auto& mappedData = rawData.MappedData();
-    const auto& referenceData = rawData.ReferenceData();
+    const PbiColumnReader index{settings.InputFile};
 
     std::string version;
-    switch (rawData.Version()) {
+    switch (index.Version()) {
         case BAM::PbiFile::Version_3_0_0:
             version = "PbiFile::Version_3_0_0";
             break;
@@ -104,66 +79,88 @@ void CppFormatter::Run(const Settings& settings)
             throw std::runtime_error("unsupported PBI version encountered");
     }
 
+    const bool hasBarcodeData = index.HasSection(BAM::PbiFile::BARCODE);
+    const bool hasMappedData = index.HasSection(BAM::PbiFile::MAPPED);
+    const bool hasReferenceData = index.HasSection(BAM::PbiFile::REFERENCE);
+
     std::string fileSections{"PbiFile::BASIC"};
-    if (rawData.HasBarcodeData()) {
+    if (hasBarcodeData) {
         fileSections += std::string{" | PbiFile::BARCODE"};
     }
-    if (rawData.HasMappedData()) {
+    if (hasMappedData) {
         fileSections += std::string{" | PbiFile::MAPPED"};
     }
-    if (rawData.HasReferenceData()) {
+    if (hasReferenceData) {
         fileSections += std::string{" | PbiFile::REFERENCE"};
     }
 
-    std::ostringstream s;
+    std::ostream& s = std::cout;
     s << "PbiRawData rawData;\n"
       << "rawData.Version(" << version << ");\n"
       << "rawData.FileSections(" << fileSections << ");\n"
-      << "rawData.NumReads(" << rawData.NumReads() << ");\n"
+      << "rawData.NumReads(" << index.NumReads() << ");\n"
       << '\n'
-      << "PbiRawBasicData& basicData = rawData.BasicData();\n"
-      << "basicData.rgId_       = {" << printField(basicData.rgId_) << "};\n"
-      << "basicData.qStart_     = {" << printField(basicData.qStart_) << "};\n"
-      << "basicData.qEnd_       = {" << printField(basicData.qEnd_) << "};\n"
-      << "basicData.holeNumber_ = {" << printField(basicData.holeNumber_) << "};\n"
-      << "basicData.readQual_   = {" << printField(basicData.readQual_) << "};\n"
-      << "basicData.ctxtFlag_   = {" << printField(basicData.ctxtFlag_) << "};\n"
-      << "basicData.fileOffset_ = {" << printField(basicData.fileOffset_) << "};\n";
-
-    if (rawData.HasBarcodeData()) {
-        s << '\n'
-          << "PbiRawBarcodeData& barcodeData = rawData.BarcodeData();\n"
-          << "barcodeData.bcForward_ = {" << printField(barcodeData.bcForward_) << "};\n"
-          << "barcodeData.bcReverse_ = {" << printField(barcodeData.bcReverse_) << "};\n"
-          << "barcodeData.bcQual_    = {" << printField(barcodeData.bcQual_) << "};\n";
+      << "PbiRawBasicData& basicData = rawData.BasicData();\n";
+    s << "basicData.rgId_       = ";
+    printField<std::int32_t>(index, PbiColumnId::RG_ID, s);
+    s << "basicData.qStart_     = ";
+    printField<std::int32_t>(index, PbiColumnId::Q_START, s);
+    s << "basicData.qEnd_       = ";
+    printField<std::int32_t>(index, PbiColumnId::Q_END, s);
+    s << "basicData.holeNumber_ = ";
+    printField<std::int32_t>(index, PbiColumnId::HOLE_NUMBER, s);
+    s << "basicData.readQual_   = ";
+    printField<float>(index, PbiColumnId::READ_QUAL, s);
+    s << "basicData.ctxtFlag_   = ";
+    printField<std::uint8_t>(index, PbiColumnId::CTXT_FLAG, s);
+    s << "basicData.fileOffset_ = ";
+    printField<std::int64_t>(index, PbiColumnId::FILE_OFFSET, s);
+
+    if (hasBarcodeData) {
+        s << '\n' << "PbiRawBarcodeData& barcodeData = rawData.BarcodeData();\n";
+        s << "barcodeData.bcForward_ = ";
+        printField<std::int16_t>(index, PbiColumnId::BC_FORWARD, s);
+        s << "barcodeData.bcReverse_ = ";
+        printField<std::int16_t>(index, PbiColumnId::BC_REVERSE, s);
+        s << "barcodeData.bcQual_    = ";
+        printField<std::int8_t>(index, PbiColumnId::BC_QUAL, s);
     }
 
-    if (rawData.HasMappedData()) {
-        s << '\n'
-          << "PbiRawMappedData& mappedData = rawData.MappedData();\n"
-          << "mappedData.tId_       = {" << printField(mappedData.tId_) << "};\n"
-          << "mappedData.tStart_    = {" << printField(mappedData.tStart_) << "};\n"
-          << "mappedData.tEnd_      = {" << printField(mappedData.tEnd_) << "};\n"
-          << "mappedData.aStart_    = {" << printField(mappedData.aStart_) << "};\n"
-          << "mappedData.aEnd_      = {" << printField(mappedData.aEnd_) << "};\n"
-          << "mappedData.revStrand_ = {" << printField(mappedData.revStrand_) << "};\n"
-          << "mappedData.nM_        = {" << printField(mappedData.nM_) << "};\n"
-          << "mappedData.nMM_       = {" << printField(mappedData.nMM_) << "};\n"
-          << "mappedData.mapQV_     = {" << printField(mappedData.mapQV_) << "};\n";
-        if (mappedData.hasIndelOps_) {
-            s << "mappedData.nInsOps_   = {" << printField(mappedData.nInsOps_) << "};\n"
-              << "mappedData.nDelOps_   = {" << printField(mappedData.nDelOps_) << "};\n";
+    if (hasMappedData) {
+        s << '\n' << "PbiRawMappedData& mappedData = rawData.MappedData();\n";
+        s << "mappedData.tId_       = ";
+        printField<std::int32_t>(index, PbiColumnId::T_ID, s);
+        s << "mappedData.tStart_    = ";
+        printField<std::uint32_t>(index, PbiColumnId::T_START, s);
+        s << "mappedData.tEnd_      = ";
+        printField<std::uint32_t>(index, PbiColumnId::T_END, s);
+        s << "mappedData.aStart_    = ";
+        printField<std::uint32_t>(index, PbiColumnId::A_START, s);
+        s << "mappedData.aEnd_      = ";
+        printField<std::uint32_t>(index, PbiColumnId::A_END, s);
+        s << "mappedData.revStrand_ = ";
+        printField<std::uint8_t>(index, PbiColumnId::REV_STRAND, s);
+        s << "mappedData.nM_        = ";
+        printField<std::uint32_t>(index, PbiColumnId::N_M, s);
+        s << "mappedData.nMM_       = ";
+        printField<std::uint32_t>(index, PbiColumnId::N_MM, s);
+        s << "mappedData.mapQV_     = ";
+        printField<std::uint8_t>(index, PbiColumnId::MAP_QV, s);
+        if (index.HasIndelOps()) {
+            s << "mappedData.nInsOps_   = ";
+            printField<std::uint32_t>(index, PbiColumnId::N_INS_OPS, s);
+            s << "mappedData.nDelOps_   = ";
+            printField<std::uint32_t>(index, PbiColumnId::N_DEL_OPS, s);
         }
     }
 
-    if (rawData.HasReferenceData()) {
+    if (hasReferenceData) {
         s << '\n'
           << "PbiRawReferenceData& referenceData = rawData.ReferenceData();\n"
-          << "referenceData.entries_ = { \n"
-          << printReferenceData(referenceData) << "};\n";
+          << "referenceData.entries_ = { \n";
+        printReferenceData(index.ReferenceEntries(), s);
+        s << "};\n";
     }
-
-    std::cout << s.str();
 }
 
 }  // namespace PbIndexDump
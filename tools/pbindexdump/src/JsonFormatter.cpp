@@ -6,17 +6,179 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <pbbam/PbiFile.h>
 #include <pbbam/PbiRawData.h>
 
 #include <pbcopper/json/JSON.h>
 
+#include "PbiColumnReader.h"
+
 namespace PacBio {
 namespace PbIndexDump {
 namespace {
 
-void FormatMetadata(const BAM::PbiRawData& index, JSON::Json& result)
+// Writes JSON incrementally, matching the layout of JSON::Json::dump() (keys
+// must be provided in sorted order by the caller).
+class JsonStreamWriter
+{
+public:
+    JsonStreamWriter(std::ostream& out, const int indentLevel) : out_{out}, indent_{indentLevel}
+    {}
+
+    void BeginObject()
+    {
+        BeginValue();
+        out_ << '{';
+        isEmpty_.push_back(true);
+    }
+
+    void EndObject() { EndContainer('}'); }
+
+    void BeginArray()
+    {
+        BeginValue();
+        out_ << '[';
+        isEmpty_.push_back(true);
+    }
+
+    void EndArray() { EndContainer(']'); }
+
+    void Key(const char* key)
+    {
+        NextElement();
+        out_ << '"' << key << '"' << (indent_ >= 0 ? ": " : ":");
+        hasKey_ = true;
+    }
+
+    void Null()
+    {
+        BeginValue();
+        out_ << "null";
+    }
+
+    void Value(const std::string& value)
+    {
+        BeginValue();
+        out_ << JSON::Json(value).dump();
+    }
+
+    void Value(const float value)
+    {
+        // let JSON lib handle floating-point formatting
+        BeginValue();
+        out_ << JSON::Json(value).dump();
+    }
+
+    template <typename T>
+    void Value(const T value)
+    {
+        BeginValue();
+        if constexpr (sizeof(T) == 1) {
+            out_ << static_cast<int>(value);  // print as number, not character
+        } else {
+            out_ << value;
+        }
+    }
+
+private:
+    void BeginValue()
+    {
+        if (hasKey_) {
+            hasKey_ = false;
+        } else if (!isEmpty_.empty()) {
+            NextElement();
+        }
+    }
+
+    void NextElement()
+    {
+        if (!isEmpty_.back()) {
+            out_ << ',';
+        }
+        isEmpty_.back() = false;
+        NewLine(isEmpty_.size());
+    }
+
+    void EndContainer(const char c)
+    {
+        const bool wasEmpty = isEmpty_.back();
+        isEmpty_.pop_back();
+        if (!wasEmpty) {
+            NewLine(isEmpty_.size());
+        }
+        out_ << c;
+    }
+
+    void NewLine(const std::size_t depth)
+    {
+        if (indent_ >= 0) {
+            out_ << '\n' << std::string(depth * indent_, ' ');
+        }
+    }
+
+    std::ostream& out_;
+    int indent_;
+    std::vector<bool> isEmpty_;
+    bool hasKey_ = false;
+};
+
+struct SectionSelection
+{
+    bool basic;
+    bool mapped;
+    bool reference;
+    bool barcode;
+    bool indelOps;
+};
+
+SectionSelection SelectSections(const PbiColumnReader& index, const Settings& settings)
+{
+    const auto use = [&](const BAM::PbiFile::Section section) {
+        return index.HasSection(section) && ((settings.Sections & section) != 0);
+    };
+    return {use(BAM::PbiFile::BASIC), use(BAM::PbiFile::MAPPED), use(BAM::PbiFile::REFERENCE),
+            use(BAM::PbiFile::BARCODE), index.HasIndelOps()};
+}
+
+template <typename T>
+void FormatColumn(const PbiColumnReader& index, const PbiColumnId id, JsonStreamWriter& json)
+{
+    json.BeginArray();
+    if (index.NumReads() > 0) {
+        auto column = index.Column<T>(id);
+        for (std::uint32_t i = 0; i < index.NumReads(); ++i) {
+            json.Value(column.Next());
+        }
+    }
+    json.EndArray();
+}
+
+void FormatFileSections(const PbiColumnReader& index, JsonStreamWriter& json)
+{
+    json.Key("fileSections");
+    json.BeginArray();
+    json.Value(std::string{"BasicData"});
+    if (index.HasSection(BAM::PbiFile::BARCODE)) {
+        json.Value(std::string{"BarcodeData"});
+    }
+    if (index.HasSection(BAM::PbiFile::MAPPED)) {
+        json.Value(std::string{"MappedData"});
+    }
+    if (index.HasSection(BAM::PbiFile::REFERENCE)) {
+        json.Value(std::string{"ReferenceData"});
+    }
+    json.EndArray();
+}
+
+void FormatNumReads(const PbiColumnReader& index, JsonStreamWriter& json)
+{
+    json.Key("numReads");
+    json.Value(index.NumReads());
+}
+
+void FormatVersion(const PbiColumnReader& index, JsonStreamWriter& json)
 {
     std::string version;
     switch (index.Version()) {
@@ -36,152 +198,253 @@ void FormatMetadata(const BAM::PbiRawData& index, JSON::Json& result)
             throw std::runtime_error{"unsupported PBI version encountered"};
     }
 
-    JSON::Json fileSections;
-    fileSections.push_back("BasicData");
-    if (index.HasBarcodeData()) {
-        fileSections.push_back("BarcodeData");
-    }
-    if (index.HasMappedData()) {
-        fileSections.push_back("MappedData");
+    json.Key("version");
+    json.Value(version);
+}
+
+void FormatReferences(const PbiColumnReader& index, const SectionSelection& sections,
+                      JsonStreamWriter& json)
+{
+    if (!sections.reference) {
+        return;
     }
-    if (index.HasReferenceData()) {
-        fileSections.push_back("ReferenceData");
+
+    json.Key("references");
+    const auto entries = index.ReferenceEntries();
+    if (entries.empty()) {
+        json.Null();
+        return;
     }
 
-    result["version"] = version;
-    result["fileSections"] = fileSections;
-    result["numReads"] = index.NumReads();
+    json.BeginArray();
+    for (const auto& entry : entries) {
+        json.BeginObject();
+        json.Key("beginRow");
+        json.Value(static_cast<std::int32_t>(entry.beginRow_));
+        json.Key("endRow");
+        json.Value(static_cast<std::int32_t>(entry.endRow_));
+        json.Key("tId");
+        json.Value(static_cast<std::int32_t>(entry.tId_));
+        json.EndObject();
+    }
+    json.EndArray();
 }
 
-void FormatRaw(const BAM::PbiRawData& index, JSON::Json& result)
+void FormatRaw(const PbiColumnReader& index, const SectionSelection& sections,
+               JsonStreamWriter& json)
 {
-    const BAM::PbiRawBasicData& basicData = index.BasicData();
-    result["basicData"]["rgId"] = basicData.rgId_;
-    result["basicData"]["qStart"] = basicData.qStart_;
-    result["basicData"]["qEnd"] = basicData.qEnd_;
-    result["basicData"]["holeNumber"] = basicData.holeNumber_;
-    result["basicData"]["readQual"] = basicData.readQual_;
-    result["basicData"]["ctxtFlag"] = basicData.ctxtFlag_;
-    result["basicData"]["fileOffset"] = basicData.fileOffset_;
-
-    if (index.HasBarcodeData()) {
-        const BAM::PbiRawBarcodeData& barcodeData = index.BarcodeData();
-        result["barcodeData"]["bcForward"] = barcodeData.bcForward_;
-        result["barcodeData"]["bcReverse"] = barcodeData.bcReverse_;
-        result["barcodeData"]["bcQuality"] = barcodeData.bcQual_;
-    }
-
-    if (index.HasMappedData()) {
-        const BAM::PbiRawMappedData& mappedData = index.MappedData();
-
-        // casts to force -1 if unmapped
-        result["mappedData"]["tId"] = mappedData.tId_;
-        result["mappedData"]["tStart"] = mappedData.tStart_;
-        result["mappedData"]["tEnd"] = mappedData.tEnd_;
-
-        result["mappedData"]["aStart"] = mappedData.aStart_;
-        result["mappedData"]["aEnd"] = mappedData.aEnd_;
-        result["mappedData"]["revStrand"] = mappedData.revStrand_;
-        result["mappedData"]["nM"] = mappedData.nM_;
-        result["mappedData"]["nMM"] = mappedData.nMM_;
-        result["mappedData"]["mapQV"] = mappedData.mapQV_;
-
-        if (mappedData.hasIndelOps_) {
-            result["mappedData"]["nInsOps"] = mappedData.nInsOps_;
-            result["mappedData"]["nDelOps"] = mappedData.nDelOps_;
+    // keys in sorted order, to match non-streamed output
+
+    json.BeginObject();
+
+    if (sections.barcode) {
+        json.Key("barcodeData");
+        json.BeginObject();
+        json.Key("bcForward");
+        FormatColumn<std::int16_t>(index, PbiColumnId::BC_FORWARD, json);
+        json.Key("bcQuality");
+        FormatColumn<std::int8_t>(index, PbiColumnId::BC_QUAL, json);
+        json.Key("bcReverse");
+        FormatColumn<std::int16_t>(index, PbiColumnId::BC_REVERSE, json);
+        json.EndObject();
+    }
+
+    if (sections.basic) {
+        json.Key("basicData");
+        json.BeginObject();
+        json.Key("ctxtFlag");
+        FormatColumn<std::uint8_t>(index, PbiColumnId::CTXT_FLAG, json);
+        json.Key("fileOffset");
+        FormatColumn<std::int64_t>(index, PbiColumnId::FILE_OFFSET, json);
+        json.Key("holeNumber");
+        FormatColumn<std::int32_t>(index, PbiColumnId::HOLE_NUMBER, json);
+        json.Key("qEnd");
+        FormatColumn<std::int32_t>(index, PbiColumnId::Q_END, json);
+        json.Key("qStart");
+        FormatColumn<std::int32_t>(index, PbiColumnId::Q_START, json);
+        json.Key("readQual");
+        FormatColumn<float>(index, PbiColumnId::READ_QUAL, json);
+        json.Key("rgId");
+        FormatColumn<std::int32_t>(index, PbiColumnId::RG_ID, json);
+        json.EndObject();
+    }
+
+    FormatFileSections(index, json);
+
+    if (sections.mapped) {
+        json.Key("mappedData");
+        json.BeginObject();
+        json.Key("aEnd");
+        FormatColumn<std::uint32_t>(index, PbiColumnId::A_END, json);
+        json.Key("aStart");
+        FormatColumn<std::uint32_t>(index, PbiColumnId::A_START, json);
+        json.Key("mapQV");
+        FormatColumn<std::uint8_t>(index, PbiColumnId::MAP_QV, json);
+        if (sections.indelOps) {
+            json.Key("nDelOps");
+            FormatColumn<std::uint32_t>(index, PbiColumnId::N_DEL_OPS, json);
+            json.Key("nInsOps");
+            FormatColumn<std::uint32_t>(index, PbiColumnId::N_INS_OPS, json);
         }
+        json.Key("nM");
+        FormatColumn<std::uint32_t>(index, PbiColumnId::N_M, json);
+        json.Key("nMM");
+        FormatColumn<std::uint32_t>(index, PbiColumnId::N_MM, json);
+        json.Key("revStrand");
+        FormatColumn<std::uint8_t>(index, PbiColumnId::REV_STRAND, json);
+        json.Key("tEnd");
+        FormatColumn<std::uint32_t>(index, PbiColumnId::T_END, json);
+        json.Key("tId");
+        FormatColumn<std::int32_t>(index, PbiColumnId::T_ID, json);
+        json.Key("tStart");
+        FormatColumn<std::uint32_t>(index, PbiColumnId::T_START, json);
+        json.EndObject();
     }
+
+    FormatNumReads(index, json);
+    FormatReferences(index, sections, json);
+    FormatVersion(index, json);
+
+    json.EndObject();
 }
 
-void FormatRecords(const BAM::PbiRawData& index, JSON::Json& result)
+// Per-record cursors over the requested columns. Columns are only opened (&
+// inflated) if their section is requested.
+struct RecordColumns
 {
-    JSON::Json reads;
-    const uint32_t numReads = index.NumReads();
-    const bool hasBarcodeData = index.HasBarcodeData();
-    const bool hasMappedData = index.HasMappedData();
-
-    for (uint32_t i = 0; i < numReads; ++i) {
-
-        JSON::Json read;
-
-        // common data
-        const BAM::PbiRawBasicData& basicData = index.BasicData();
-        read["rgId"] = basicData.rgId_[i];
-        read["qStart"] = basicData.qStart_[i];
-        read["qEnd"] = basicData.qEnd_[i];
-        read["holeNumber"] = basicData.holeNumber_[i];
-        read["readQuality"] = basicData.readQual_[i];
-        read["contextFlag"] = basicData.ctxtFlag_[i];
-        read["fileOffset"] = basicData.fileOffset_[i];
-
-        // barcode data, if present
-        if (hasBarcodeData) {
-            const BAM::PbiRawBarcodeData& barcodeData = index.BarcodeData();
-            read["bcForward"] = barcodeData.bcForward_[i];
-            read["bcReverse"] = barcodeData.bcReverse_[i];
-            read["bcQuality"] = barcodeData.bcQual_[i];
+    RecordColumns(const PbiColumnReader& index, const SectionSelection& sections)
+    {
+        if (sections.basic) {
+            rgId.emplace_back(index.Column<std::int32_t>(PbiColumnId::RG_ID));
+            qStart.emplace_back(index.Column<std::int32_t>(PbiColumnId::Q_START));
+            qEnd.emplace_back(index.Column<std::int32_t>(PbiColumnId::Q_END));
+            holeNumber.emplace_back(index.Column<std::int32_t>(PbiColumnId::HOLE_NUMBER));
+            readQual.emplace_back(index.Column<float>(PbiColumnId::READ_QUAL));
+            ctxtFlag.emplace_back(index.Column<std::uint8_t>(PbiColumnId::CTXT_FLAG));
+            fileOffset.emplace_back(index.Column<std::int64_t>(PbiColumnId::FILE_OFFSET));
         }
-
-        // mapping data, if present
-        if (hasMappedData) {
-            const BAM::PbiRawMappedData& mappedData = index.MappedData();
-
-            // casts to force -1 if unmapped
-            read["tId"] = static_cast<int32_t>(mappedData.tId_[i]);
-            read["tStart"] = static_cast<int32_t>(mappedData.tStart_[i]);
-            read["tEnd"] = static_cast<int32_t>(mappedData.tEnd_[i]);
-
-            read["aStart"] = mappedData.aStart_[i];
-            read["aEnd"] = mappedData.aEnd_[i];
-            read["nM"] = mappedData.nM_[i];
-            read["nMM"] = mappedData.nMM_[i];
-            read["mapQuality"] = mappedData.mapQV_[i];
-            read["reverseStrand"] = mappedData.revStrand_[i];
-
-            if (mappedData.hasIndelOps_) {
-                read["nInsOps"] = mappedData.nInsOps_[i];
-                read["nDelOps"] = mappedData.nDelOps_[i];
+        if (sections.barcode) {
+            bcForward.emplace_back(index.Column<std::int16_t>(PbiColumnId::BC_FORWARD));
+            bcReverse.emplace_back(index.Column<std::int16_t>(PbiColumnId::BC_REVERSE));
+            bcQual.emplace_back(index.Column<std::int8_t>(PbiColumnId::BC_QUAL));
+        }
+        if (sections.mapped) {
+            tId.emplace_back(index.Column<std::int32_t>(PbiColumnId::T_ID));
+            tStart.emplace_back(index.Column<std::uint32_t>(PbiColumnId::T_START));
+            tEnd.emplace_back(index.Column<std::uint32_t>(PbiColumnId::T_END));
+            aStart.emplace_back(index.Column<std::uint32_t>(PbiColumnId::A_START));
+            aEnd.emplace_back(index.Column<std::uint32_t>(PbiColumnId::A_END));
+            revStrand.emplace_back(index.Column<std::uint8_t>(PbiColumnId::REV_STRAND));
+            nM.emplace_back(index.Column<std::uint32_t>(PbiColumnId::N_M));
+            nMM.emplace_back(index.Column<std::uint32_t>(PbiColumnId::N_MM));
+            mapQV.emplace_back(index.Column<std::uint8_t>(PbiColumnId::MAP_QV));
+            if (sections.indelOps) {
+                nInsOps.emplace_back(index.Column<std::uint32_t>(PbiColumnId::N_INS_OPS));
+                nDelOps.emplace_back(index.Column<std::uint32_t>(PbiColumnId::N_DEL_OPS));
             }
         }
-
-        reads.push_back(std::move(read));
     }
-    result["reads"] = reads;
+
+    // 0 or 1 cursor each (PbiColumnCursor is not default-constructible)
+    std::vector<PbiColumnCursor<std::int32_t>> rgId, qStart, qEnd, holeNumber;
+    std::vector<PbiColumnCursor<float>> readQual;
+    std::vector<PbiColumnCursor<std::uint8_t>> ctxtFlag;
+    std::vector<PbiColumnCursor<std::int64_t>> fileOffset;
+    std::vector<PbiColumnCursor<std::int16_t>> bcForward, bcReverse;
+    std::vector<PbiColumnCursor<std::int8_t>> bcQual;
+    std::vector<PbiColumnCursor<std::int32_t>> tId;
+    std::vector<PbiColumnCursor<std::uint32_t>> tStart, tEnd, aStart, aEnd, nM, nMM;
+    std::vector<PbiColumnCursor<std::uint8_t>> revStrand, mapQV;
+    std::vector<PbiColumnCursor<std::uint32_t>> nInsOps, nDelOps;
+};
+
+void FormatRecord(RecordColumns& columns, JsonStreamWriter& json)
+{
+    // keys in sorted order, to match non-streamed output
+
+    const auto field = [&json](const char* key, auto& column) {
+        if (!column.empty()) {
+            json.Key(key);
+            json.Value(column.front().Next());
+        }
+    };
+
+    // casts to force -1 if unmapped
+    const auto signedField = [&json](const char* key, auto& column) {
+        if (!column.empty()) {
+            json.Key(key);
+            json.Value(static_cast<std::int32_t>(column.front().Next()));
+        }
+    };
+
+    json.BeginObject();
+    field("aEnd", columns.aEnd);
+    field("aStart", columns.aStart);
+    field("bcForward", columns.bcForward);
+    field("bcQuality", columns.bcQual);
+    field("bcReverse", columns.bcReverse);
+    field("contextFlag", columns.ctxtFlag);
+    field("fileOffset", columns.fileOffset);
+    field("holeNumber", columns.holeNumber);
+    field("mapQuality", columns.mapQV);
+    field("nDelOps", columns.nDelOps);
+    field("nInsOps", columns.nInsOps);
+    field("nM", columns.nM);
+    field("nMM", columns.nMM);
+    field("qEnd", columns.qEnd);
+    field("qStart", columns.qStart);
+    field("readQuality", columns.readQual);
+    field("reverseStrand", columns.revStrand);
+    field("rgId", columns.rgId);
+    signedField("tEnd", columns.tEnd);
+    signedField("tId", columns.tId);
+    signedField("tStart", columns.tStart);
+    json.EndObject();
 }
 
-void FormatReferences(const BAM::PbiRawData& index, JSON::Json& result)
+void FormatRecords(const PbiColumnReader& index, const SectionSelection& sections,
+                   JsonStreamWriter& json)
 {
-    if (index.HasReferenceData()) {
-        JSON::Json references;
-        const auto& referenceData = index.ReferenceData();
-        for (const auto& entry : referenceData.entries_) {
-            JSON::Json element;
-            element["tId"] = static_cast<int32_t>(entry.tId_);
-            element["beginRow"] = static_cast<int32_t>(entry.beginRow_);
-            element["endRow"] = static_cast<int32_t>(entry.endRow_);
-            references.push_back(std::move(element));
+    // keys in sorted order, to match non-streamed output
+
+    json.BeginObject();
+    FormatFileSections(index, json);
+    FormatNumReads(index, json);
+
+    if (sections.basic || sections.barcode || sections.mapped) {
+        json.Key("reads");
+        if (index.NumReads() == 0) {
+            json.Null();
+        } else {
+            RecordColumns columns{index, sections};
+            json.BeginArray();
+            for (std::uint32_t i = 0; i < index.NumReads(); ++i) {
+                FormatRecord(columns, json);
+            }
+            json.EndArray();
         }
-        result["references"] = references;
     }
+
+    FormatReferences(index, sections, json);
+    FormatVersion(index, json);
+    json.EndObject();
 }
+
 }  // namespace
 
 void JsonFormatter::Run(const Settings& settings)
 {
-    const BAM::PbiRawData index{settings.InputFile};
-    JSON::Json result;
-
-    FormatMetadata(index, result);
-    FormatReferences(index, result);
+    const PbiColumnReader index{settings.InputFile};
+    const auto sections = SelectSections(index, settings);
 
+    std::ostream& out = std::cout;
+    JsonStreamWriter json{out, settings.JsonIndentLevel};
     if (settings.JsonRaw) {
-        FormatRaw(index, result);
+        FormatRaw(index, sections, json);
     } else {
-        FormatRecords(index, result);
+        FormatRecords(index, sections, json);
     }
-
-    // print
-    std::cout << result.dump(settings.JsonIndentLevel) << '\n';
+    out << '\n';
 }
 
 }  // namespace PbIndexDump
@@ -1,6 +1,10 @@
 #include "PbIndexDumpSettings.h"
 
 #include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <pbbam/StringUtilities.h>
 
 #include "PbIndexDumpVersion.h"
 
@@ -43,10 +47,44 @@ R"({
     ]
 })"};
 
+const CLI_v2::Option Sections{
+R"({
+    "names" : ["sections"],
+    "description" : [
+        "Comma-separated list of PBI sections to print (basic, mapped, reference, ",
+        "barcode). Columns of other sections are not decoded. JSON output only."
+    ],
+    "type" : "string",
+    "default" : "basic,mapped,reference,barcode"
+})"};
+
 // clang-format on
 
 }  // namespace Options
 
+namespace {
+
+BAM::PbiFile::Sections ParseSections(const std::string& sectionList)
+{
+    BAM::PbiFile::Sections result = 0;
+    for (const auto& name : BAM::Split(sectionList, ',')) {
+        if (name == "basic") {
+            result |= BAM::PbiFile::BASIC;
+        } else if (name == "mapped") {
+            result |= BAM::PbiFile::MAPPED;
+        } else if (name == "reference") {
+            result |= BAM::PbiFile::REFERENCE;
+        } else if (name == "barcode") {
+            result |= BAM::PbiFile::BARCODE;
+        } else {
+            throw std::runtime_error{"unknown PBI section requested: '" + name + "'"};
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
 CLI_v2::Interface Settings::CreateCLI()
 {
     // clang-format off
@@ -66,7 +104,8 @@ CLI_v2::Interface Settings::CreateCLI()
     interface.AddOptionGroup("Output Options", {
         Options::Format,
         Options::JsonIndentLevel,
-        Options::JsonRaw
+        Options::JsonRaw,
+        Options::Sections
     });
 
     interface.HelpFooter({
@@ -84,6 +123,7 @@ Settings::Settings(const CLI_v2::Results& args)
     : Format(args[Options::Format])
     , JsonIndentLevel{args[Options::JsonIndentLevel]}
     , JsonRaw(args[Options::JsonRaw])
+    , Sections{ParseSections(args[Options::Sections])}
 {
     // input file
     const auto& posArgs = args.PositionalArguments();
@@ -106,6 +146,9 @@ Settings::Settings(const CLI_v2::Results& args)
             args[Options::JsonIndentLevel].IsUserProvided()) {
             throw std::runtime_error{"JSON formatting options are not valid on non-JSON output"};
         }
+        if (args[Options::Sections].IsUserProvided()) {
+            throw std::runtime_error{"section selection is not valid on C++ output"};
+        }
     }
 }
 
@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include <pbbam/PbiFile.h>
+
 #include <pbcopper/cli2/CLI.h>
 
 namespace PacBio {
@@ -18,6 +20,7 @@ struct Settings
     std::string Format;
     int JsonIndentLevel = 4;
     bool JsonRaw = false;
+    BAM::PbiFile::Sections Sections = BAM::PbiFile::ALL;
 };
 
 }  // namespace PbIndexDump
@@ -0,0 +1,264 @@
+#include "PbiColumnReader.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include <array>
+#include <filesystem>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <system_error>
+
+#include <pbcopper/utility/Deleters.h>
+
+namespace PacBio {
+namespace PbIndexDump {
+namespace {
+
+// magic, version, pbi_flags, n_reads, reserved
+constexpr std::int64_t PbiHeaderLength = 4 + 4 + 2 + 4 + 18;
+
+// BGZF header, up to & including the 'BC' extra subfield
+constexpr std::size_t BgzfHeaderLength = 18;
+
+std::uint16_t ReadLittleEndian16(const std::uint8_t* data)
+{
+    return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+}
+
+std::uint32_t ReadLittleEndian32(const std::uint8_t* data)
+{
+    return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8) |
+           (static_cast<std::uint32_t>(data[2]) << 16) |
+           (static_cast<std::uint32_t>(data[3]) << 24);
+}
+
+std::string SpoolStdin()
+{
+    std::random_device rd;
+    const auto tempFilename = std::filesystem::temp_directory_path() /
+                              ("pbindexdump." + std::to_string(rd()) + ".pbi");
+
+    std::unique_ptr<std::FILE, Utility::FileDeleter> out{
+        std::fopen(tempFilename.c_str(), "wb")};
+    if (!out) {
+        throw std::runtime_error{"could not create temp file for stdin: " +
+                                 tempFilename.string()};
+    }
+
+    std::vector<char> buffer(0x10000);
+    while (std::cin.read(buffer.data(), buffer.size()) || std::cin.gcount() > 0) {
+        const auto numBytes = static_cast<std::size_t>(std::cin.gcount());
+        if (std::fwrite(buffer.data(), 1, numBytes, out.get()) != numBytes) {
+            throw std::runtime_error{"could not write temp file for stdin: " +
+                                     tempFilename.string()};
+        }
+    }
+    return tempFilename.string();
+}
+
+}  // namespace
+
+PbiColumnReader::PbiColumnReader(std::string filename) : filename_{std::move(filename)}
+{
+    if (filename_ == "-") {
+        spooledFilename_ = SpoolStdin();
+        filename_ = spooledFilename_;
+    }
+
+    ScanBlocks();
+    LoadHeader();
+    LocateColumns();
+}
+
+PbiColumnReader::~PbiColumnReader()
+{
+    if (!spooledFilename_.empty()) {
+        std::error_code ec;
+        std::filesystem::remove(spooledFilename_, ec);
+    }
+}
+
+BAM::PbiFile::VersionEnum PbiColumnReader::Version() const { return version_; }
+
+BAM::PbiFile::Sections PbiColumnReader::FileSections() const { return sections_; }
+
+bool PbiColumnReader::HasSection(const BAM::PbiFile::Section section) const
+{
+    return (sections_ & section) != 0;
+}
+
+bool PbiColumnReader::HasIndelOps() const { return version_ >= BAM::PbiFile::Version_4_0_0; }
+
+std::uint32_t PbiColumnReader::NumReads() const { return numReads_; }
+
+std::vector<BAM::PbiReferenceEntry> PbiColumnReader::ReferenceEntries() const
+{
+    std::vector<BAM::PbiReferenceEntry> result;
+    if (referenceStart_ < 0) {
+        return result;
+    }
+
+    PbiColumnCursor<std::uint32_t> numRefsCursor{filename_, VirtualOffset(referenceStart_), 1};
+    const std::uint32_t numRefs = numRefsCursor.Next();
+
+    // (tId, beginRow, endRow) triples
+    PbiColumnCursor<std::uint32_t> entryCursor{filename_, VirtualOffset(referenceStart_ + 4),
+                                               numRefs * 3};
+    result.reserve(numRefs);
+    for (std::uint32_t i = 0; i < numRefs; ++i) {
+        const auto tId = entryCursor.Next();
+        const auto beginRow = entryCursor.Next();
+        const auto endRow = entryCursor.Next();
+        result.emplace_back(tId, beginRow, endRow);
+    }
+    return result;
+}
+
+std::int64_t PbiColumnReader::ColumnOffset(const PbiColumnId id,
+                                           const std::size_t elementSize) const
+{
+    const auto i = static_cast<std::size_t>(id);
+    if (columnStarts_.at(i) < 0) {
+        throw std::runtime_error{"requested PBI column is not present in file: " + filename_};
+    }
+    if (columnSizes_.at(i) != elementSize) {
+        throw std::runtime_error{"PBI column requested with incorrect element size"};
+    }
+    return VirtualOffset(columnStarts_.at(i));
+}
+
+void PbiColumnReader::LoadHeader()
+{
+    std::unique_ptr<BGZF, BAM::HtslibBgzfDeleter> bgzf{bgzf_open(filename_.c_str(), "rb")};
+    if (!bgzf) {
+        throw std::runtime_error{"could not open PBI file for reading: " + filename_};
+    }
+
+    std::array<char, PbiHeaderLength> header;
+    if (bgzf_read(bgzf.get(), header.data(), header.size()) !=
+            static_cast<ssize_t>(header.size()) ||
+        std::strncmp(header.data(), "PBI\1", 4) != 0) {
+        throw std::runtime_error{"expected PBI file, found unknown format instead: " + filename_};
+    }
+
+    const auto* data = reinterpret_cast<const std::uint8_t*>(header.data());
+    version_ = static_cast<BAM::PbiFile::VersionEnum>(ReadLittleEndian32(data + 4));
+    sections_ = ReadLittleEndian16(data + 8);
+    numReads_ = ReadLittleEndian32(data + 10);
+}
+
+void PbiColumnReader::LocateColumns()
+{
+    constexpr auto NumColumns = static_cast<std::size_t>(PbiColumnId::NUM_COLUMNS);
+    columnStarts_.assign(NumColumns, -1);
+    columnSizes_.assign(NumColumns, 0);
+
+    // no section data is stored for empty indices
+    if (numReads_ == 0) {
+        return;
+    }
+
+    std::int64_t pos = PbiHeaderLength;
+    const auto addColumn = [&](const PbiColumnId id, const std::size_t elementSize) {
+        const auto i = static_cast<std::size_t>(id);
+        columnStarts_[i] = pos;
+        columnSizes_[i] = elementSize;
+        pos += static_cast<std::int64_t>(numReads_) * elementSize;
+    };
+
+    addColumn(PbiColumnId::RG_ID, 4);
+    addColumn(PbiColumnId::Q_START, 4);
+    addColumn(PbiColumnId::Q_END, 4);
+    addColumn(PbiColumnId::HOLE_NUMBER, 4);
+    addColumn(PbiColumnId::READ_QUAL, 4);
+    addColumn(PbiColumnId::CTXT_FLAG, 1);
+    addColumn(PbiColumnId::FILE_OFFSET, 8);
+
+    if (HasSection(BAM::PbiFile::MAPPED)) {
+        addColumn(PbiColumnId::T_ID, 4);
+        addColumn(PbiColumnId::T_START, 4);
+        addColumn(PbiColumnId::T_END, 4);
+        addColumn(PbiColumnId::A_START, 4);
+        addColumn(PbiColumnId::A_END, 4);
+        addColumn(PbiColumnId::REV_STRAND, 1);
+        addColumn(PbiColumnId::N_M, 4);
+        addColumn(PbiColumnId::N_MM, 4);
+        addColumn(PbiColumnId::MAP_QV, 1);
+        if (HasIndelOps()) {
+            addColumn(PbiColumnId::N_INS_OPS, 4);
+            addColumn(PbiColumnId::N_DEL_OPS, 4);
+        }
+    }
+
+    if (HasSection(BAM::PbiFile::REFERENCE)) {
+        referenceStart_ = pos;
+        PbiColumnCursor<std::uint32_t> numRefsCursor{filename_, VirtualOffset(pos), 1};
+        pos += 4 + (12 * static_cast<std::int64_t>(numRefsCursor.Next()));
+    }
+
+    if (HasSection(BAM::PbiFile::BARCODE)) {
+        addColumn(PbiColumnId::BC_FORWARD, 2);
+        addColumn(PbiColumnId::BC_REVERSE, 2);
+        addColumn(PbiColumnId::BC_QUAL, 1);
+    }
+}
+
+void PbiColumnReader::ScanBlocks()
+{
+    std::unique_ptr<std::FILE, Utility::FileDeleter> in{std::fopen(filename_.c_str(), "rb")};
+    if (!in) {
+        throw std::runtime_error{"could not open PBI file for reading: " + filename_};
+    }
+
+    // Walk the BGZF block headers & footers, without inflating any data. This
+    // is equivalent to the contents of a *.gzi index.
+    std::int64_t compressedPos = 0;
+    std::int64_t uncompressedPos = 0;
+    std::array<std::uint8_t, BgzfHeaderLength> header;
+    while (std::fread(header.data(), 1, header.size(), in.get()) == header.size()) {
+        const bool isBgzf = (header[0] == 31 && header[1] == 139 && header[2] == 8 &&
+                             (header[3] & 4) && ReadLittleEndian16(&header[10]) == 6 &&
+                             header[12] == 'B' && header[13] == 'C' &&
+                             ReadLittleEndian16(&header[14]) == 2);
+        if (!isBgzf) {
+            throw std::runtime_error{"PBI file is not BGZF-compressed: " + filename_};
+        }
+
+        const std::int64_t blockLength = ReadLittleEndian16(&header[16]) + 1;
+        std::array<std::uint8_t, 4> isize;
+        if (std::fseek(in.get(), compressedPos + blockLength - 4, SEEK_SET) != 0 ||
+            std::fread(isize.data(), 1, isize.size(), in.get()) != isize.size()) {
+            throw std::runtime_error{"truncated BGZF block in PBI file: " + filename_};
+        }
+
+        const std::int64_t uncompressedLength = ReadLittleEndian32(isize.data());
+        if (uncompressedLength > 0) {
+            blocks_.push_back(BgzfBlock{compressedPos, uncompressedPos, uncompressedLength});
+        }
+        compressedPos += blockLength;
+        uncompressedPos += uncompressedLength;
+    }
+}
+
+std::int64_t PbiColumnReader::VirtualOffset(const std::int64_t uncompressedPos) const
+{
+    const auto found = std::upper_bound(
+        blocks_.cbegin(), blocks_.cend(), uncompressedPos,
+        [](const std::int64_t pos, const BgzfBlock& block) { return pos < block.uncompressedStart; });
+    if (found == blocks_.cbegin()) {
+        throw std::runtime_error{"PBI data offset out of range (possibly truncated file)"};
+    }
+
+    const auto& block = *std::prev(found);
+    const std::int64_t blockOffset = uncompressedPos - block.uncompressedStart;
+    if (blockOffset >= block.uncompressedLength) {
+        throw std::runtime_error{"PBI data offset out of range (possibly truncated file)"};
+    }
+    return (block.compressedStart << 16) | blockOffset;
+}
+
+}  // namespace PbIndexDump
+}  // namespace PacBio
@@ -0,0 +1,190 @@
+#ifndef PBINDEXDUMP_PBICOLUMNREADER_H
+#define PBINDEXDUMP_PBICOLUMNREADER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <htslib/bgzf.h>
+#include <htslib/hts.h>
+
+#include <pbbam/Deleters.h>
+#include <pbbam/PbiFile.h>
+#include <pbbam/PbiRawData.h>
+
+namespace PacBio {
+namespace PbIndexDump {
+
+enum class PbiColumnId
+{
+    // BasicData
+    RG_ID,
+    Q_START,
+    Q_END,
+    HOLE_NUMBER,
+    READ_QUAL,
+    CTXT_FLAG,
+    FILE_OFFSET,
+
+    // MappedData
+    T_ID,
+    T_START,
+    T_END,
+    A_START,
+    A_END,
+    REV_STRAND,
+    N_M,
+    N_MM,
+    MAP_QV,
+    N_INS_OPS,
+    N_DEL_OPS,
+
+    // BarcodeData
+    BC_FORWARD,
+    BC_REVERSE,
+    BC_QUAL,
+
+    NUM_COLUMNS
+};
+
+///
+/// Reads the values of a single PBI column, in fixed-size chunks.
+///
+template <typename T>
+class PbiColumnCursor
+{
+public:
+    PbiColumnCursor(const std::string& filename, std::int64_t virtualOffset,
+                    std::uint32_t numValues);
+
+    T Next();
+
+private:
+    void Refill();
+
+    std::unique_ptr<BGZF, BAM::HtslibBgzfDeleter> bgzf_;
+    std::vector<T> buffer_;
+    std::size_t pos_ = 0;
+    std::uint32_t remaining_;
+};
+
+///
+/// Provides streaming, per-column access to a PBI file.
+///
+/// The file's BGZF block layout is scanned up front (headers only, no
+/// inflation), so that any column can be located without reading the columns
+/// before it. Column data is then inflated only as it is consumed.
+///
+/// Input from stdin ("-") is first copied to a temporary file.
+///
+class PbiColumnReader
+{
+public:
+    explicit PbiColumnReader(std::string filename);
+    ~PbiColumnReader();
+
+    PbiColumnReader(const PbiColumnReader&) = delete;
+    PbiColumnReader& operator=(const PbiColumnReader&) = delete;
+
+    BAM::PbiFile::VersionEnum Version() const;
+    BAM::PbiFile::Sections FileSections() const;
+    bool HasSection(BAM::PbiFile::Section section) const;
+    bool HasIndelOps() const;
+    std::uint32_t NumReads() const;
+
+    std::vector<BAM::PbiReferenceEntry> ReferenceEntries() const;
+
+    template <typename T>
+    PbiColumnCursor<T> Column(PbiColumnId id) const
+    {
+        return PbiColumnCursor<T>{filename_, ColumnOffset(id, sizeof(T)), numReads_};
+    }
+
+private:
+    struct BgzfBlock
+    {
+        std::int64_t compressedStart;
+        std::int64_t uncompressedStart;
+        std::int64_t uncompressedLength;
+    };
+
+    void ScanBlocks();
+    void LoadHeader();
+    void LocateColumns();
+
+    std::int64_t ColumnOffset(PbiColumnId id, std::size_t elementSize) const;
+    std::int64_t VirtualOffset(std::int64_t uncompressedPos) const;
+
+    std::string filename_;
+    std::string spooledFilename_;
+    std::vector<BgzfBlock> blocks_;
+
+    BAM::PbiFile::VersionEnum version_ = BAM::PbiFile::CurrentVersion;
+    BAM::PbiFile::Sections sections_ = BAM::PbiFile::BASIC;
+    std::uint32_t numReads_ = 0;
+
+    std::vector<std::int64_t> columnStarts_;
+    std::vector<std::size_t> columnSizes_;
+    std::int64_t referenceStart_ = -1;
+};
+
+template <typename T>
+PbiColumnCursor<T>::PbiColumnCursor(const std::string& filename, const std::int64_t virtualOffset,
+                                    const std::uint32_t numValues)
+    : bgzf_{bgzf_open(filename.c_str(), "rb")}, remaining_{numValues}
+{
+    if (!bgzf_ || bgzf_seek(bgzf_.get(), virtualOffset, SEEK_SET) != 0) {
+        throw std::runtime_error{"could not open PBI column for reading: " + filename};
+    }
+}
+
+template <typename T>
+T PbiColumnCursor<T>::Next()
+{
+    if (pos_ == buffer_.size()) {
+        Refill();
+    }
+    return buffer_[pos_++];
+}
+
+template <typename T>
+void PbiColumnCursor<T>::Refill()
+{
+    constexpr std::uint32_t ChunkSize = 16384;
+
+    if (remaining_ == 0) {
+        throw std::runtime_error{"attempted to read past end of PBI column"};
+    }
+
+    const std::uint32_t numValues = std::min(remaining_, ChunkSize);
+    buffer_.resize(numValues);
+    const auto numBytes = static_cast<ssize_t>(numValues * sizeof(T));
+    if (bgzf_read(bgzf_.get(), buffer_.data(), numBytes) != numBytes) {
+        throw std::runtime_error{"could not read PBI column data (possibly truncated file)"};
+    }
+
+    if (bgzf_->is_be) {
+        for (auto& value : buffer_) {
+            if constexpr (sizeof(T) == 2) {
+                ed_swap_2p(&value);
+            } else if constexpr (sizeof(T) == 4) {
+                ed_swap_4p(&value);
+            } else if constexpr (sizeof(T) == 8) {
+                ed_swap_8p(&value);
+            }
+        }
+    }
+
+    pos_ = 0;
+    remaining_ -= numValues;
+}
+
+}  // namespace PbIndexDump
+}  // namespace PacBio
+
+#endif  // PBINDEXDUMP_PBICOLUMNREADER_H
@@ -23,6 +23,26 @@ R"({
     "description" : "Disables creation of PBI index file. PBI always disabled when writing to stdout."
 })"};
 
+const CLI_v2::Option Concatenate{
+R"({
+    "names" : ["concat"],
+    "description" : [
+        "Concatenate inputs in the order given, copying compressed data directly. Only applies ",
+        "to unfiltered input that is not coordinate-sorted. PBI creation requires input PBI files."
+    ]
+})"};
+
+const CLI_v2::Option NumThreads{
+R"({
+    "names" : ["j", "num-threads"],
+    "description" : [
+        "Number of threads to use for merging. Only coordinate-sorted inputs, with PBI files, ",
+        "are merged in parallel. 0 means autodetection."
+    ],
+    "type" : "int",
+    "default" : 1
+})"};
+
 const CLI_v2::PositionalArgument InputFiles{
 R"({
     "name" : "INPUT",
@@ -47,7 +67,9 @@ CLI_v2::Interface Settings::CreateCLI()
 
     interface.AddOptionGroup("Input/Output", {
         Options::OutputFile,
-        Options::NoPbi
+        Options::NoPbi,
+        Options::NumThreads,
+        Options::Concatenate
     });
     interface.AddPositionalArguments({
         Options::InputFiles
@@ -56,6 +78,8 @@ CLI_v2::Interface Settings::CreateCLI()
     $ pbmerge -o merged.bam data.subreadset.xml
     $ pbmerge -o merged.bam data_1.bam data_2.bam data_3.bam
     $ pbmerge -o merged.bam data_bams.fofn
+    $ pbmerge -j 8 -o merged.bam aligned_1.bam aligned_2.bam
+    $ pbmerge --concat -o merged.bam movie_1.bam movie_2.bam
 )");
 
     // clang-format on
@@ -64,6 +88,13 @@ CLI_v2::Interface Settings::CreateCLI()
 
 Settings::Settings(const CLI_v2::Results& args) : OutputFile(args[Options::OutputFile])
 {
+    // threads
+    const int numThreads = args[Options::NumThreads];
+    if (numThreads < 0) {
+        throw std::runtime_error{"number of threads must not be negative"};
+    }
+    NumThreads = static_cast<std::size_t>(numThreads);
+
     // input file(s)
     const auto& posArgs = args.PositionalArguments();
     if (posArgs.empty()) {
@@ -82,6 +113,9 @@ Settings::Settings(const CLI_v2::Results& args) : OutputFile(args[Options::Outpu
     } else {
         CreatePbi = !args[Options::NoPbi];  // create PBI unless requested
     }
+
+    // concatenate, instead of merge?
+    Concatenate = args[Options::Concatenate];
 }
 
 }  // namespace PbMerge
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include <cstddef>
+
 #include <pbcopper/cli2/CLI.h>
 
 namespace PacBio {
@@ -18,6 +20,8 @@ struct Settings
     std::vector<std::string> InputFiles;
     std::string OutputFile;
     bool CreatePbi;
+    std::size_t NumThreads;
+    bool Concatenate;
     std::vector<std::string> errors_;
 };
 
@@ -27,7 +27,12 @@ int Workflow::Runner(const CLI_v2::Results& args)
         dataset = BAM::DataSet(settings.InputFiles);
     }
 
-    BAM::BamFileMerger::Merge(dataset, settings.OutputFile, settings.CreatePbi, mergeProgram);
+    BAM::BamFileMerger::Config config;
+    config.createPbi = settings.CreatePbi;
+    config.pgInfo = mergeProgram;
+    config.numThreads = settings.NumThreads;
+    config.concatenate = settings.Concatenate;
+    BAM::BamFileMerger::Merge(dataset, settings.OutputFile, config);
 
     return EXIT_SUCCESS;
 }